@@ -0,0 +1,426 @@
+// Feito por: Lucas Garcia E Luis Augusto
+// Benchmarks do PSO: microbenchmarks dos kernels por tamanho de enxame e
+// vazão ponta a ponta da varredura padrão, com saída em JSON para comparar versões
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../libs/agendador.h"
+#include "../libs/eggholder.h"
+#include "../libs/lote.h"
+#include "../libs/motor.h"
+#include "../libs/plano.h"
+#include "../libs/tempo.h"
+
+#define LOCALFILE_BENCH "./bench.json"
+
+// Máximo de medições guardadas para o JSON
+#define MAX_MEDICOES 256
+
+// Uma medição: tempo por chamada e itens (partículas ou avaliações) por segundo
+typedef struct {
+   char nome[96];
+   long long chamadas;     // Chamadas medidas
+   double tempoTotal;      // Segundos gastos nas chamadas medidas
+   double itensPorChamada; // Itens processados em cada chamada
+   const char *unidade;    // O que é um item
+} Medicao;
+
+typedef struct {
+   double tempoMinimo;     // Tempo mínimo de medição por benchmark em segundos
+   const char *filtro;     // Só roda os benchmarks cujo nome contém o filtro
+   Medicao medicoes[MAX_MEDICOES];
+   int numMedicoes;
+} Bench;
+
+typedef void (*FuncaoBench)(void *contexto);
+
+// Impede que o compilador descarte resultados não usados
+static volatile double sorvedouro;
+
+// Roda a função em lotes crescentes até o lote levar tempoMinimo (como o google-benchmark)
+static void medir(Bench *bench, const char *nome, FuncaoBench funcao, void *contexto, double itensPorChamada, const char *unidade) {
+    long long chamadas = 1;
+    double tempo;
+
+    if (bench->filtro != NULL && strstr(nome, bench->filtro) == NULL) {
+        return;
+    }
+    funcao(contexto); // aquece caches e preditores
+    for (;;) {
+        double inicio = tempoAtual();
+        for (long long c = 0; c < chamadas; c++) {
+            funcao(contexto);
+        }
+        tempo = tempoAtual() - inicio;
+        if (tempo >= bench->tempoMinimo || chamadas >= 1000000000LL) {
+            break;
+        }
+        // estima o lote que atinge o tempo mínimo, crescendo no máximo 10x por vez
+        long long proximo = tempo > 0 ? (long long)(chamadas * bench->tempoMinimo * 1.4 / tempo) : chamadas * 10;
+        if (proximo > chamadas * 10) {
+            proximo = chamadas * 10;
+        }
+        chamadas = proximo > chamadas ? proximo : chamadas + 1;
+    }
+
+    if (bench->numMedicoes < MAX_MEDICOES) {
+        Medicao *medicao = &bench->medicoes[bench->numMedicoes++];
+        snprintf(medicao->nome, sizeof(medicao->nome), "%s", nome);
+        medicao->chamadas = chamadas;
+        medicao->tempoTotal = tempo;
+        medicao->itensPorChamada = itensPorChamada;
+        medicao->unidade = unidade;
+    }
+    printf("%-44s %14.1f ns %12lld %14.4g %s/s\n", nome, tempo / chamadas * 1e9, chamadas,
+           itensPorChamada * chamadas / tempo, unidade);
+    fflush(stdout);
+}
+
+// ========== Microbenchmarks ===========
+
+typedef struct {
+   Swarm enxame;
+   ParametrosPSO parametros;
+   KernelEggholder kernel;
+   Fronteira fronteira;
+} ContextoKernel;
+
+static void benchEggholderEscalar(void *contexto) {
+    ContextoKernel *ctx = (ContextoKernel *)contexto;
+    const double *x = &COORD(&ctx->enxame, position, 0, 0);
+    const double *y = &COORD(&ctx->enxame, position, 1, 0);
+    double soma = 0.0;
+    for (int i = 0; i < ctx->enxame.numParticles; i++) {
+        soma += eggholderRapido(x[i], y[i]);
+    }
+    sorvedouro = soma;
+}
+
+static void benchEggholderLote(void *contexto) {
+    ContextoKernel *ctx = (ContextoKernel *)contexto;
+    ctx->kernel(&COORD(&ctx->enxame, position, 0, 0), &COORD(&ctx->enxame, position, 1, 0), ctx->enxame.fitness, ctx->enxame.numParticles);
+}
+
+static void benchAtualizarVelocidade(void *contexto) {
+    ContextoKernel *ctx = (ContextoKernel *)contexto;
+    atualizarVelocidade(&ctx->enxame, ctx->parametros.w, ctx->parametros.c1, ctx->parametros.c2);
+}
+
+static void benchAtualizarPosicao(void *contexto) {
+    ContextoKernel *ctx = (ContextoKernel *)contexto;
+    atualizarPosicao(&ctx->enxame, &ctx->fronteira);
+}
+
+static void benchAtualizarMelhoresPosicoes(void *contexto) {
+    ContextoKernel *ctx = (ContextoKernel *)contexto;
+    atualizarMelhoresPosicoes(&ctx->enxame);
+}
+
+// Tamanhos de enxame dos microbenchmarks
+static const int TAMANHOS[] = {50, 500, 5000, 50000, 500000, 1000000};
+#define NUM_TAMANHOS (int)(sizeof(TAMANHOS) / sizeof(TAMANHOS[0]))
+
+static void microbenchmarks(Bench *bench, int maxParticulas) {
+    ContextoKernel ctx;
+    ImplementacaoEggholder implementacoes[8];
+    int numImplementacoes = listarImplementacoesEggholder(implementacoes, 8);
+    char nome[96];
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.parametros = parametrosPadrao();
+    for (int s = 0; s < NUM_TAMANHOS && TAMANHOS[s] <= maxParticulas; s++) {
+        int particulas = TAMANHOS[s];
+
+        semearGerador(&ctx.enxame.gerador, GERADOR_XOSHIRO256, 42);
+        inicializarEnxame(&ctx.enxame, particulas, ctx.parametros.dimensoes, ctx.parametros.posMin, ctx.parametros.posMax, ctx.parametros.velMax);
+
+        snprintf(nome, sizeof(nome), "eggholder/escalar/%d", particulas);
+        medir(bench, nome, benchEggholderEscalar, &ctx, particulas, "avaliacoes");
+        for (int k = 0; k < numImplementacoes; k++) {
+            if (!implementacoes[k].disponivel) {
+                continue;
+            }
+            ctx.kernel = implementacoes[k].kernel;
+            snprintf(nome, sizeof(nome), "eggholder/lote_%s/%d", implementacoes[k].nome, particulas);
+            medir(bench, nome, benchEggholderLote, &ctx, particulas, "avaliacoes");
+        }
+        snprintf(nome, sizeof(nome), "atualizarVelocidade/%d", particulas);
+        medir(bench, nome, benchAtualizarVelocidade, &ctx, particulas, "particulas");
+        // a posição sem velocidade nova acumula partículas nas bordas: o caso em que o clamp com desvio erra a previsão
+        for (int politica = FRONTEIRA_ABSORVER; politica <= FRONTEIRA_PERIODICA; politica++) {
+            ctx.parametros.fronteira = (PoliticaFronteira)politica;
+            ctx.fronteira = fronteiraDosParametros(&ctx.parametros);
+            if (politica == FRONTEIRA_ABSORVER) {
+                snprintf(nome, sizeof(nome), "atualizarPosicao/%d", particulas);
+            } else {
+                snprintf(nome, sizeof(nome), "atualizarPosicao/%s/%d", nomeFronteira(ctx.fronteira.politica), particulas);
+            }
+            medir(bench, nome, benchAtualizarPosicao, &ctx, particulas, "particulas");
+        }
+        ctx.parametros.fronteira = FRONTEIRA_ABSORVER;
+        snprintf(nome, sizeof(nome), "atualizarMelhoresPosicoes/%d", particulas);
+        medir(bench, nome, benchAtualizarMelhoresPosicoes, &ctx, particulas, "particulas");
+    }
+    liberarEnxame(&ctx.enxame);
+}
+
+// ========== Paralelismo dentro do enxame ===========
+
+typedef struct {
+   Swarm enxame;
+   ParametrosPSO parametros;
+} ContextoIteracao;
+
+// Uma iteração do motor escolhido (executarPSOConfigurado com limite de 1 iteração)
+static void benchIteracao(void *contexto) {
+    ContextoIteracao *ctx = (ContextoIteracao *)contexto;
+    sorvedouro = executarPSOConfigurado(&ctx->enxame, &ctx->parametros, NULL);
+}
+
+// Motor clássico contra o paralelo com 1 e numTrabalhadores threads nos enxames grandes
+static void intraEnxame(Bench *bench, int numTrabalhadores, int maxParticulas) {
+    ContextoIteracao ctx;
+    GrupoTrabalho grupo;
+    int trabalhadores[] = {1, numTrabalhadores};
+    char nome[96];
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.parametros = parametrosPadrao();
+    ctx.parametros.iteracoes = 1;
+    for (int s = 0; s < NUM_TAMANHOS && TAMANHOS[s] <= maxParticulas; s++) {
+        int particulas = TAMANHOS[s];
+        if (particulas < 5000) {
+            continue;
+        }
+        semearGerador(&ctx.enxame.gerador, GERADOR_XOSHIRO256, 42);
+        inicializarEnxame(&ctx.enxame, particulas, ctx.parametros.dimensoes, ctx.parametros.posMin, ctx.parametros.posMax, ctx.parametros.velMax);
+
+        ctx.parametros.motor = MOTOR_CLASSICO;
+        ctx.parametros.grupo = NULL;
+        snprintf(nome, sizeof(nome), "iteracao/classico/%d", particulas);
+        medir(bench, nome, benchIteracao, &ctx, particulas, "particulas");
+
+        ctx.parametros.motor = MOTOR_PARALELO;
+        for (int k = 0; k < 2; k++) {
+            if (k == 1 && numTrabalhadores == 1) {
+                break;
+            }
+            iniciarGrupo(&grupo, trabalhadores[k]);
+            ctx.parametros.grupo = &grupo;
+            snprintf(nome, sizeof(nome), "iteracao/paralelo/threads:%d/%d", trabalhadores[k], particulas);
+            medir(bench, nome, benchIteracao, &ctx, particulas, "particulas");
+            encerrarGrupo(&grupo);
+        }
+    }
+    liberarEnxame(&ctx.enxame);
+}
+
+// ========== Ponta a ponta ===========
+
+// Contador por trabalhador, em linhas de cache separadas
+typedef struct {
+   long long avaliacoes;
+   char preenchimento[64 - sizeof(long long)];
+} ContadorTrabalhador;
+
+typedef struct {
+   const PlanoExpandido *plano;
+   ParametrosPSO parametros;
+   int numTrabalhadores;
+   Swarm *enxames;
+   LoteEnxames *lotes;     // Motor em lote: um lote por trabalhador, uma célula por tarefa
+   int emLote;
+   ContadorTrabalhador *contadores;
+   long long avaliacoes;   // Avaliações da última varredura
+} ContextoVarredura;
+
+static void tarefaVarredura(int tarefa, int trabalhador, void *contexto) {
+    ContextoVarredura *ctx = (ContextoVarredura *)contexto;
+    const TarefaPlano *item = &ctx->plano->tarefas[tarefa];
+    const CelulaPlano *celula = &ctx->plano->celulas[item->celula];
+    Swarm *enxame = &ctx->enxames[trabalhador];
+    ParametrosPSO parametros = ctx->parametros;
+    ResultadoPSO resultado;
+
+    parametros.iteracoes = celula->iteracoes;
+    parametros.w = celula->w;
+    parametros.c1 = celula->c1;
+    parametros.c2 = celula->c2;
+    parametros.posMin = celula->posMin;
+    parametros.posMax = celula->posMax;
+    parametros.velMax = celula->velMax;
+    semearGerador(&enxame->gerador, GERADOR_XOSHIRO256, item->semente);
+    enxame->objetivo = parametros.objetivo;
+    inicializarEnxame(enxame, celula->populacao, parametros.dimensoes, parametros.posMin, parametros.posMax, parametros.velMax);
+    executarPSOConfigurado(enxame, &parametros, &resultado);
+    ctx->contadores[trabalhador].avaliacoes += resultado.avaliacoes;
+}
+
+// Todas as execuções de uma célula (são consecutivas na lista plana) em um lote
+static void tarefaLote(int tarefa, int trabalhador, void *contexto) {
+    ContextoVarredura *ctx = (ContextoVarredura *)contexto;
+    const CelulaPlano *celula = &ctx->plano->celulas[tarefa];
+    int porCelula = ctx->plano->numTarefas / ctx->plano->numCelulas;
+    const TarefaPlano *itens = &ctx->plano->tarefas[tarefa * porCelula];
+    LoteEnxames *lote = &ctx->lotes[trabalhador];
+    ParametrosPSO parametros = ctx->parametros;
+    unsigned long long sementes[64];
+    ResultadoPSO resultados[64];
+
+    parametros.iteracoes = celula->iteracoes;
+    parametros.w = celula->w;
+    parametros.c1 = celula->c1;
+    parametros.c2 = celula->c2;
+    parametros.posMin = celula->posMin;
+    parametros.posMax = celula->posMax;
+    parametros.velMax = celula->velMax;
+    for (int s = 0; s < porCelula; s++) {
+        sementes[s] = itens[s].semente;
+    }
+    lote->objetivo = parametros.objetivo;
+    inicializarLote(lote, sementes, porCelula, celula->populacao, parametros.dimensoes, parametros.posMin, parametros.posMax, parametros.velMax);
+    executarLote(lote, &parametros, resultados);
+    for (int s = 0; s < porCelula; s++) {
+        ctx->contadores[trabalhador].avaliacoes += resultados[s].avaliacoes;
+    }
+}
+
+static void benchVarredura(void *contexto) {
+    ContextoVarredura *ctx = (ContextoVarredura *)contexto;
+
+    for (int t = 0; t < ctx->numTrabalhadores; t++) {
+        ctx->contadores[t].avaliacoes = 0;
+    }
+    if (ctx->emLote) {
+        executarTarefas(ctx->plano->numCelulas, ctx->numTrabalhadores, tarefaLote, ctx);
+    } else {
+        executarTarefas(ctx->plano->numTarefas, ctx->numTrabalhadores, tarefaVarredura, ctx);
+    }
+    ctx->avaliacoes = 0;
+    for (int t = 0; t < ctx->numTrabalhadores; t++) {
+        ctx->avaliacoes += ctx->contadores[t].avaliacoes;
+    }
+}
+
+// Varredura padrão (plano da metodologia) sem gravação, em vazão de execuções e de avaliações
+static void pontaAPonta(Bench *bench, int numTrabalhadores) {
+    PlanoExperimento plano;
+    PlanoExpandido expandido;
+    ContextoVarredura ctx;
+    const TipoMotor motores[] = {MOTOR_CLASSICO, MOTOR_FUNDIDO, MOTOR_CLASSICO};
+    const char *nomesMotores[] = {"classico", "fundido", "lote"};
+    int trabalhadores[] = {1, numTrabalhadores};
+    char nome[96];
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.parametros = parametrosPadrao();
+    planoPadrao(&plano, ctx.parametros.w, ctx.parametros.c1, ctx.parametros.c2, ctx.parametros.posMin, ctx.parametros.posMax, ctx.parametros.velMax);
+    expandirPlano(&plano, 42, &expandido);
+    ctx.plano = &expandido;
+    ctx.enxames = (Swarm *)calloc(numTrabalhadores, sizeof(Swarm));
+    ctx.lotes = (LoteEnxames *)calloc(numTrabalhadores, sizeof(LoteEnxames));
+    ctx.contadores = (ContadorTrabalhador *)calloc(numTrabalhadores, sizeof(ContadorTrabalhador));
+    if (ctx.enxames == NULL || ctx.lotes == NULL || ctx.contadores == NULL) {
+        printf("Erro ao alocar a varredura\n");
+        exit(1);
+    }
+
+    for (int m = 0; m < 3; m++) {
+        for (int k = 0; k < 2; k++) {
+            if (k == 1 && numTrabalhadores == 1) {
+                break;
+            }
+            ctx.parametros.motor = motores[m];
+            ctx.emLote = m == 2;
+            ctx.numTrabalhadores = trabalhadores[k];
+            benchVarredura(&ctx); // a contagem de avaliações é a mesma em toda varredura com a mesma semente
+
+            snprintf(nome, sizeof(nome), "varredura/%s/threads:%d/execucoes", nomesMotores[m], ctx.numTrabalhadores);
+            medir(bench, nome, benchVarredura, &ctx, expandido.numTarefas, "execucoes");
+            snprintf(nome, sizeof(nome), "varredura/%s/threads:%d/avaliacoes", nomesMotores[m], ctx.numTrabalhadores);
+            medir(bench, nome, benchVarredura, &ctx, (double)ctx.avaliacoes, "avaliacoes");
+        }
+    }
+
+    for (int t = 0; t < numTrabalhadores; t++) {
+        liberarEnxame(&ctx.enxames[t]);
+        liberarLote(&ctx.lotes[t]);
+    }
+    free(ctx.enxames);
+    free(ctx.lotes);
+    free(ctx.contadores);
+    liberarPlanoExpandido(&expandido);
+    liberarPlano(&plano);
+}
+
+// Grava as medições no formato do google-benchmark (context + benchmarks)
+static void gravarJSON(const Bench *bench, const char *caminho, int numTrabalhadores) {
+    FILE *arquivo = fopen(caminho, "w");
+    char data[32];
+    time_t agora = time(NULL);
+
+    if (arquivo == NULL) {
+        printf("Erro ao abrir o arquivo %s\n", caminho);
+        exit(1);
+    }
+    strftime(data, sizeof(data), "%Y-%m-%dT%H:%M:%S", localtime(&agora));
+    fprintf(arquivo, "{\n  \"context\": {\n");
+    fprintf(arquivo, "    \"date\": \"%s\",\n", data);
+    fprintf(arquivo, "    \"num_cpus\": %d,\n", numeroDeNucleos());
+    fprintf(arquivo, "    \"threads\": %d,\n", numTrabalhadores);
+    fprintf(arquivo, "    \"eggholder_kernel\": \"%s\",\n", implementacaoEggholder());
+    fprintf(arquivo, "    \"min_time\": %g\n", bench->tempoMinimo);
+    fprintf(arquivo, "  },\n  \"benchmarks\": [\n");
+    for (int i = 0; i < bench->numMedicoes; i++) {
+        const Medicao *medicao = &bench->medicoes[i];
+        double porChamada = medicao->tempoTotal / medicao->chamadas;
+        fprintf(arquivo, "    {\"name\": \"%s\", \"iterations\": %lld, \"real_time\": %.6g, \"time_unit\": \"ns\", "
+                         "\"items_per_second\": %.6g, \"item\": \"%s\"}%s\n",
+                medicao->nome, medicao->chamadas, porChamada * 1e9,
+                medicao->itensPorChamada / porChamada, medicao->unidade, i + 1 < bench->numMedicoes ? "," : "");
+    }
+    fprintf(arquivo, "  ]\n}\n");
+    fclose(arquivo);
+    printf("\n INFO: Resultados gravados em %s\n", caminho);
+}
+
+int main(int argc, char *argv[]) {
+    Bench bench;
+    const char *caminho = LOCALFILE_BENCH;
+    int numTrabalhadores = numeroDeNucleos();
+    int maxParticulas = 1000000;
+
+    memset(&bench, 0, sizeof(bench));
+    bench.tempoMinimo = 0.5;
+    for (int i = 1; i < argc; i++) {
+        const char *opcao = argv[i];
+        const char *valor = i + 1 < argc ? argv[i + 1] : "";
+
+        if (strcmp(opcao, "--json") == 0) {
+            caminho = valor;
+        } else if (strcmp(opcao, "--tempo-min") == 0) {
+            bench.tempoMinimo = atof(valor);
+        } else if (strcmp(opcao, "--filtro") == 0) {
+            bench.filtro = valor;
+        } else if (strcmp(opcao, "--threads") == 0) {
+            numTrabalhadores = atoi(valor);
+        } else if (strcmp(opcao, "--max-particulas") == 0) {
+            maxParticulas = atoi(valor);
+        } else {
+            printf("Opcao desconhecida: %s\n", opcao);
+            return 1;
+        }
+        i++;
+    }
+    if (numTrabalhadores < 1) {
+        numTrabalhadores = 1;
+    }
+
+    printf("%-44s %17s %12s %20s\n", "benchmark", "tempo/chamada", "chamadas", "vazao");
+    microbenchmarks(&bench, maxParticulas < 50 ? 50 : maxParticulas);
+    intraEnxame(&bench, numTrabalhadores, maxParticulas);
+    pontaAPonta(&bench, numTrabalhadores);
+    gravarJSON(&bench, caminho, numTrabalhadores);
+    return 0;
+}
@@ -30,6 +30,9 @@ if "%fileName%"=="" (
 )
 set fullFileName=%fileName%.V%versao%
 
+:: Modulos do projeto compilados junto com o programa principal
+set "libs=libs/enxame.c libs/eggholder.c libs/agendador.c libs/aleatorio.c libs/motor.c libs/objetivos.c libs/relatorio.c libs/telemetria.c libs/plano.c libs/instrumentacao.c libs/lote.c libs/assincrono.c libs/retomada.c libs/topologia.c libs/fronteira.c libs/coeficientes.c libs/reinicio.c libs/plataforma.c libs/distribuido.c libs/migracao.c libs/ilhas.c libs/cache.c libs/substituto.c data/libs/fileSys.c -lpthread"
+
 if not exist "rascunho" (
     mkdir "rascunho"
 )
@@ -55,9 +58,9 @@ if not exist "zip" (
 if exist "builds/debug.exe" (
    del "builds/debug.exe"
 )
-gcc -Wall -g3 -Wextra -static -static-libgcc -static-libstdc++ %fileName%.c -o "builds/debug.exe"
+gcc -Wall -g3 -Wextra -static -static-libgcc -static-libstdc++ %fileName%.c %libs% -o "builds/debug.exe"
 
-gcc -Wall -g3 -Wextra -static -static-libgcc -static-libstdc++ %fileName%.c -o "builds/%fullFileName%.exe"
+gcc -Wall -g3 -Wextra -static -static-libgcc -static-libstdc++ %fileName%.c %libs% -o "builds/%fullFileName%.exe"
 
 @REM verifica se a build foi feita com sucesso 
 if not exist "builds/%fullFileName%.exe" (
@@ -68,7 +71,7 @@ if not exist "builds/%fullFileName%.exe" (
     exit /b 1
 )
 
-tar -a -c -f "zip/Lucas-E-Luis-%fullFileName%.zip" *data *builds *rascunho *.pdf *.h *.c *.c functions.c *.cmd *.md *.csv
+tar -a -c -f "zip/Lucas-E-Luis-%fullFileName%.zip" *data *builds *rascunho *.pdf *libs *.h *.c *.c functions.c *.cmd *.md *.csv
 
 msg * /v /w %fullFileName%.exe foi compilado!
 
@@ -1,8 +1,9 @@
 #include "fileSys.h"
+#include "../../libs/plataforma.h"
 //=================================================
 
 void correct(){
-    SetConsoleOutputCP(65001);
+    prepararConsole();
 }
 void head(){
     printf("\n ----------------------------------------------------");
@@ -199,11 +200,3 @@ int inputBoleano(){
 void inputS(char destino[]){
     scanf(" %100[^\n]s", destino);
 }
-
-/**
- * @brief // Obtem o tamanho do vetor inteiro
- */
-int arrayLength(int intArray[]){
-    int size = sizeof(intArray) / sizeof(intArray[0]);
-    return size;
-}
\ No newline at end of file
@@ -6,7 +6,6 @@
 #include <ctype.h>
 #include <string.h>
 #include <time.h>
-#include <windows.h>
 
 // Defina constantes para as sequências de escape ANSI das cores
 #define RED "\x1b[31m"
@@ -21,7 +20,7 @@
 
 typedef char string[101];
 
-// Funções que serão implementadas no arquivo .c
+// Funções implementadas em fileSys.c
 FILE *abrirArquivo(char *nomeArq, char *modo);
 FILE *lerArquivo(char *nomeArq);
 FILE *escreverArquivo(char *nomeArq);
@@ -43,6 +42,6 @@ void inputS(char destino[]);
 
 double getTime();
 void calcularTempo(double ini);
-int arrayLength(int intArray[]);
+// Console em UTF-8 (no Windows; nos demais sistemas não faz nada)
 void correct();
 #endif
\ No newline at end of file
@@ -0,0 +1,258 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "agendador.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+// Fila de tarefas de um trabalhador: o dono consome pelo início, os ladrões pela metade final
+typedef struct {
+    pthread_mutex_t trava;
+    int inicio;
+    int fim;
+    char preenchimento[64]; // evita falso compartilhamento entre filas vizinhas
+} FilaTarefas;
+
+typedef struct {
+    FilaTarefas *filas;
+    int numTrabalhadores;
+    TarefaAgendador tarefa;
+    void *contexto;
+} Agendador;
+
+typedef struct {
+    Agendador *agendador;
+    int id;
+} Trabalhador;
+
+int numeroDeNucleos(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    return nucleos > 0 ? (int)nucleos : 1;
+#endif
+}
+
+// Retira a próxima tarefa da própria fila; retorna -1 se ela estiver vazia
+static int retirarTarefa(FilaTarefas *fila) {
+    int tarefa = -1;
+    pthread_mutex_lock(&fila->trava);
+    if (fila->inicio < fila->fim) {
+        tarefa = fila->inicio++;
+    }
+    pthread_mutex_unlock(&fila->trava);
+    return tarefa;
+}
+
+// Rouba a metade final da fila de outro trabalhador para a própria fila
+static int roubarTarefas(Agendador *agendador, int id) {
+    for (int passo = 1; passo < agendador->numTrabalhadores; passo++) {
+        FilaTarefas *vitima = &agendador->filas[(id + passo) % agendador->numTrabalhadores];
+        int inicio = 0, fim = 0;
+
+        pthread_mutex_lock(&vitima->trava);
+        int restantes = vitima->fim - vitima->inicio;
+        if (restantes > 0) {
+            int roubo = (restantes + 1) / 2;
+            fim = vitima->fim;
+            inicio = fim - roubo;
+            vitima->fim = inicio;
+        }
+        pthread_mutex_unlock(&vitima->trava);
+
+        if (fim > inicio) {
+            FilaTarefas *propria = &agendador->filas[id];
+            pthread_mutex_lock(&propria->trava);
+            propria->inicio = inicio;
+            propria->fim = fim;
+            pthread_mutex_unlock(&propria->trava);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void *lacoTrabalhador(void *argumento) {
+    Trabalhador *trabalhador = (Trabalhador *)argumento;
+    Agendador *agendador = trabalhador->agendador;
+    FilaTarefas *propria = &agendador->filas[trabalhador->id];
+
+    // nenhuma tarefa nova surge durante a execução: quando não há o que roubar, acabou
+    do {
+        int tarefa;
+        while ((tarefa = retirarTarefa(propria)) >= 0) {
+            agendador->tarefa(tarefa, trabalhador->id, agendador->contexto);
+        }
+    } while (roubarTarefas(agendador, trabalhador->id));
+    return NULL;
+}
+
+void executarTarefas(int numTarefas, int numTrabalhadores, TarefaAgendador tarefa, void *contexto) {
+    if (numTrabalhadores < 1) {
+        numTrabalhadores = 1;
+    }
+    if (numTrabalhadores > numTarefas) {
+        numTrabalhadores = numTarefas > 0 ? numTarefas : 1;
+    }
+
+    Agendador agendador = {NULL, numTrabalhadores, tarefa, contexto};
+    Trabalhador *trabalhadores = (Trabalhador *)malloc(numTrabalhadores * sizeof(Trabalhador));
+    pthread_t *threads = (pthread_t *)malloc(numTrabalhadores * sizeof(pthread_t));
+    agendador.filas = (FilaTarefas *)malloc(numTrabalhadores * sizeof(FilaTarefas));
+    if (trabalhadores == NULL || threads == NULL || agendador.filas == NULL) {
+        printf("Erro ao alocar o agendador\n");
+        exit(1);
+    }
+
+    // divide as tarefas em blocos contíguos, um por trabalhador
+    for (int t = 0; t < numTrabalhadores; t++) {
+        pthread_mutex_init(&agendador.filas[t].trava, NULL);
+        agendador.filas[t].inicio = (int)((long long)numTarefas * t / numTrabalhadores);
+        agendador.filas[t].fim = (int)((long long)numTarefas * (t + 1) / numTrabalhadores);
+        trabalhadores[t].agendador = &agendador;
+        trabalhadores[t].id = t;
+    }
+
+    // a thread chamadora trabalha como o trabalhador 0
+    for (int t = 1; t < numTrabalhadores; t++) {
+        pthread_create(&threads[t], NULL, lacoTrabalhador, &trabalhadores[t]);
+    }
+    lacoTrabalhador(&trabalhadores[0]);
+    for (int t = 1; t < numTrabalhadores; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    for (int t = 0; t < numTrabalhadores; t++) {
+        pthread_mutex_destroy(&agendador.filas[t].trava);
+    }
+    free(agendador.filas);
+    free(threads);
+    free(trabalhadores);
+}
+
+// ========== Grupo persistente ===========
+
+typedef struct {
+    GrupoTrabalho *grupo;
+    int id;
+} MembroGrupo;
+
+// Retira tarefas da rodada atual até acabarem
+static void consumirRodada(GrupoTrabalho *grupo, int id) {
+    int tarefa;
+    while ((tarefa = __atomic_fetch_add(&grupo->proxima, 1, __ATOMIC_RELAXED)) < grupo->numTarefas) {
+        grupo->tarefa(tarefa, id, grupo->contexto);
+    }
+}
+
+static void *lacoMembro(void *argumento) {
+    MembroGrupo *membro = (MembroGrupo *)argumento;
+    GrupoTrabalho *grupo = membro->grupo;
+    unsigned long vista = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&grupo->trava);
+        while (grupo->rodada == vista && !grupo->encerrar) {
+            pthread_cond_wait(&grupo->novaRodada, &grupo->trava);
+        }
+        if (grupo->encerrar) {
+            pthread_mutex_unlock(&grupo->trava);
+            break;
+        }
+        vista = grupo->rodada;
+        pthread_mutex_unlock(&grupo->trava);
+
+        consumirRodada(grupo, membro->id);
+
+        pthread_mutex_lock(&grupo->trava);
+        if (--grupo->pendentes == 0) {
+            pthread_cond_signal(&grupo->fimRodada);
+        }
+        pthread_mutex_unlock(&grupo->trava);
+    }
+    free(membro);
+    return NULL;
+}
+
+void iniciarGrupo(GrupoTrabalho *grupo, int numTrabalhadores) {
+    grupo->numTrabalhadores = numTrabalhadores > 1 ? numTrabalhadores : 1;
+    grupo->threads = NULL;
+    grupo->rodada = 0;
+    grupo->pendentes = 0;
+    grupo->encerrar = 0;
+    grupo->numTarefas = 0;
+    grupo->proxima = 0;
+    pthread_mutex_init(&grupo->trava, NULL);
+    pthread_cond_init(&grupo->novaRodada, NULL);
+    pthread_cond_init(&grupo->fimRodada, NULL);
+    if (grupo->numTrabalhadores == 1) {
+        return;
+    }
+
+    grupo->threads = (pthread_t *)malloc((grupo->numTrabalhadores - 1) * sizeof(pthread_t));
+    if (grupo->threads == NULL) {
+        printf("Erro ao alocar o grupo de threads\n");
+        exit(1);
+    }
+    for (int t = 1; t < grupo->numTrabalhadores; t++) {
+        MembroGrupo *membro = (MembroGrupo *)malloc(sizeof(MembroGrupo));
+        if (membro == NULL) {
+            printf("Erro ao alocar o grupo de threads\n");
+            exit(1);
+        }
+        membro->grupo = grupo;
+        membro->id = t;
+        pthread_create(&grupo->threads[t - 1], NULL, lacoMembro, membro);
+    }
+}
+
+void executarNoGrupo(GrupoTrabalho *grupo, int numTarefas, TarefaAgendador tarefa, void *contexto) {
+    if (grupo->numTrabalhadores == 1 || numTarefas <= 1) {
+        for (int t = 0; t < numTarefas; t++) {
+            tarefa(t, 0, contexto);
+        }
+        return;
+    }
+
+    pthread_mutex_lock(&grupo->trava);
+    grupo->tarefa = tarefa;
+    grupo->contexto = contexto;
+    grupo->numTarefas = numTarefas;
+    grupo->proxima = 0;
+    grupo->pendentes = grupo->numTrabalhadores - 1;
+    grupo->rodada++;
+    pthread_cond_broadcast(&grupo->novaRodada);
+    pthread_mutex_unlock(&grupo->trava);
+
+    // a thread chamadora trabalha como o trabalhador 0
+    consumirRodada(grupo, 0);
+
+    pthread_mutex_lock(&grupo->trava);
+    while (grupo->pendentes > 0) {
+        pthread_cond_wait(&grupo->fimRodada, &grupo->trava);
+    }
+    pthread_mutex_unlock(&grupo->trava);
+}
+
+void encerrarGrupo(GrupoTrabalho *grupo) {
+    pthread_mutex_lock(&grupo->trava);
+    grupo->encerrar = 1;
+    pthread_cond_broadcast(&grupo->novaRodada);
+    pthread_mutex_unlock(&grupo->trava);
+    for (int t = 1; t < grupo->numTrabalhadores; t++) {
+        pthread_join(grupo->threads[t - 1], NULL);
+    }
+    free(grupo->threads);
+    grupo->threads = NULL;
+    pthread_mutex_destroy(&grupo->trava);
+    pthread_cond_destroy(&grupo->novaRodada);
+    pthread_cond_destroy(&grupo->fimRodada);
+}
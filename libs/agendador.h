@@ -0,0 +1,51 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef AGENDADOR_H
+#define AGENDADOR_H
+#include <pthread.h>
+
+// Tarefa do agendador: recebe o índice da tarefa e o do trabalhador que a executa
+typedef void (*TarefaAgendador)(int tarefa, int trabalhador, void *contexto);
+
+
+// Número de núcleos lógicos disponíveis
+int numeroDeNucleos(void);
+
+
+// Executa as tarefas [0, numTarefas) em numTrabalhadores threads.
+// Cada trabalhador começa com um bloco contíguo de tarefas e, quando o seu
+// acaba, rouba a metade final do bloco de outro trabalhador.
+void executarTarefas(int numTarefas, int numTrabalhadores, TarefaAgendador tarefa, void *contexto);
+
+
+// Grupo de threads persistente para rodadas curtas e repetidas de tarefas (uma por iteração do PSO).
+// As threads dormem entre as rodadas em vez de serem criadas a cada chamada.
+typedef struct {
+   pthread_t *threads;          // Threads auxiliares [numTrabalhadores - 1]
+   int numTrabalhadores;        // Inclui a thread chamadora (trabalhador 0)
+   pthread_mutex_t trava;       // Protege a rodada, pendentes e encerrar
+   pthread_cond_t novaRodada;   // Sinaliza as auxiliares que há tarefas
+   pthread_cond_t fimRodada;    // Sinaliza a chamadora que as auxiliares terminaram
+   unsigned long rodada;        // Contador de rodadas publicadas
+   int pendentes;               // Auxiliares que ainda não terminaram a rodada
+   int encerrar;                // 1 = as auxiliares saem do laço
+   TarefaAgendador tarefa;      // Tarefa da rodada atual
+   void *contexto;
+   int numTarefas;
+   int proxima;                 // Próxima tarefa a retirar (incremento atômico)
+} GrupoTrabalho;
+
+
+// Cria as threads do grupo (numTrabalhadores <= 1 = sem threads, as rodadas correm na chamadora)
+void iniciarGrupo(GrupoTrabalho *grupo, int numTrabalhadores);
+
+
+// Executa as tarefas [0, numTarefas) no grupo e só retorna quando todas terminarem.
+// As tarefas são retiradas em ordem por quem estiver livre; o resultado não pode depender de qual
+// trabalhador executou cada tarefa.
+void executarNoGrupo(GrupoTrabalho *grupo, int numTarefas, TarefaAgendador tarefa, void *contexto);
+
+
+// Encerra e junta as threads do grupo
+void encerrarGrupo(GrupoTrabalho *grupo);
+
+#endif
@@ -0,0 +1,161 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <string.h>
+#include "aleatorio.h"
+
+// ========== xoshiro256** ===========
+
+static inline uint64_t rotacionar(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t proximoXoshiro(uint64_t s[4]) {
+    uint64_t resultado = rotacionar(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotacionar(s[3], 45);
+    return resultado;
+}
+
+static void saltarXoshiro(uint64_t s[4]) {
+    static const uint64_t SALTO[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+    uint64_t novo[4] = {0, 0, 0, 0};
+
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (SALTO[i] & (1ULL << b)) {
+                novo[0] ^= s[0];
+                novo[1] ^= s[1];
+                novo[2] ^= s[2];
+                novo[3] ^= s[3];
+            }
+            proximoXoshiro(s);
+        }
+    }
+    memcpy(s, novo, sizeof(novo));
+}
+
+// ========== Philox4x32-10 ===========
+
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+
+// Calcula o bloco de 128 bits do contador (contador, fluxo) com a chave dada
+static inline void blocoPhilox(uint64_t chave, uint64_t contador, uint64_t fluxo, uint32_t saida[4]) {
+    uint32_t c0 = (uint32_t)contador, c1 = (uint32_t)(contador >> 32);
+    uint32_t c2 = (uint32_t)fluxo, c3 = (uint32_t)(fluxo >> 32);
+    uint32_t k0 = (uint32_t)chave, k1 = (uint32_t)(chave >> 32);
+
+    for (int rodada = 0; rodada < 10; rodada++) {
+        uint64_t p0 = (uint64_t)PHILOX_M0 * c0;
+        uint64_t p1 = (uint64_t)PHILOX_M1 * c2;
+        uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        c1 = (uint32_t)p1;
+        c3 = (uint32_t)p0;
+        c0 = n0;
+        c2 = n2;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    saida[0] = c0;
+    saida[1] = c1;
+    saida[2] = c2;
+    saida[3] = c3;
+}
+
+// ========== Interface ===========
+
+void semearGerador(GeradorAleatorio *gerador, TipoGerador tipo, uint64_t semente) {
+    gerador->tipo = tipo;
+    gerador->restantes = 0;
+    if (tipo == GERADOR_PHILOX4X32) {
+        gerador->estado[0] = misturar64(semente);
+        gerador->estado[1] = 0;
+        gerador->estado[2] = 0;
+        gerador->estado[3] = 0;
+    } else {
+        // o estado do xoshiro não pode ser todo zero; o splitmix64 garante isso na prática
+        uint64_t x = semente;
+        for (int i = 0; i < 4; i++) {
+            x += 0x9e3779b97f4a7c15ULL;
+            gerador->estado[i] = misturar64(x);
+        }
+    }
+}
+
+uint64_t proximoAleatorio(GeradorAleatorio *gerador) {
+    if (gerador->tipo == GERADOR_XOSHIRO256) {
+        return proximoXoshiro(gerador->estado);
+    }
+    if (gerador->restantes < 2) {
+        blocoPhilox(gerador->estado[0], gerador->estado[1]++, gerador->estado[2], gerador->bloco);
+        gerador->restantes = 4;
+    }
+    int i = 4 - gerador->restantes;
+    gerador->restantes -= 2;
+    return (uint64_t)gerador->bloco[i] | ((uint64_t)gerador->bloco[i + 1] << 32);
+}
+
+void gerarUniformes(GeradorAleatorio *gerador, double *saida, int n) {
+    int i = 0;
+
+    if (gerador->tipo == GERADOR_XOSHIRO256) {
+        // cópia local do estado para mantê-lo em registradores
+        uint64_t s[4] = {gerador->estado[0], gerador->estado[1], gerador->estado[2], gerador->estado[3]};
+        for (; i < n; i++) {
+            saida[i] = paraUniforme(proximoXoshiro(s));
+        }
+        memcpy(gerador->estado, s, sizeof(s));
+        return;
+    }
+
+    // philox: cada bloco depende só do contador, então as iterações são independentes
+    uint64_t chave = gerador->estado[0], contador = gerador->estado[1], fluxo = gerador->estado[2];
+    int blocos = n / 2;
+    for (int b = 0; b < blocos; b++) {
+        uint32_t palavras[4];
+        blocoPhilox(chave, contador + (uint64_t)b, fluxo, palavras);
+        saida[2 * b] = paraUniforme((uint64_t)palavras[0] | ((uint64_t)palavras[1] << 32));
+        saida[2 * b + 1] = paraUniforme((uint64_t)palavras[2] | ((uint64_t)palavras[3] << 32));
+    }
+    gerador->estado[1] = contador + (uint64_t)blocos;
+    for (i = 2 * blocos; i < n; i++) {
+        saida[i] = uniformeAleatorio(gerador);
+    }
+}
+
+void saltarGerador(GeradorAleatorio *gerador) {
+    if (gerador->tipo == GERADOR_XOSHIRO256) {
+        saltarXoshiro(gerador->estado);
+    } else {
+        gerador->estado[2]++;
+        gerador->estado[1] = 0;
+        gerador->restantes = 0;
+    }
+}
+
+const char *nomeGerador(TipoGerador tipo) {
+    return tipo == GERADOR_PHILOX4X32 ? "philox" : "xoshiro";
+}
+
+int geradorPorNome(const char *nome, TipoGerador *tipo) {
+    if (strcmp(nome, "xoshiro") == 0) {
+        *tipo = GERADOR_XOSHIRO256;
+        return 1;
+    }
+    if (strcmp(nome, "philox") == 0) {
+        *tipo = GERADOR_PHILOX4X32;
+        return 1;
+    }
+    return 0;
+}
+
+const char *nomesGeradores(void) {
+    return "xoshiro, philox";
+}
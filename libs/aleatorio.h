@@ -0,0 +1,68 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef ALEATORIO_H
+#define ALEATORIO_H
+#include <stdint.h>
+
+// Algoritmos de geração disponíveis
+typedef enum {
+   GERADOR_XOSHIRO256, // xoshiro256** (sequencial, com salto de 2^128)
+   GERADOR_PHILOX4X32  // Philox4x32-10 (baseado em contador, blocos independentes)
+} TipoGerador;
+
+// Gerador pseudoaleatório com estado próprio (um por enxame/thread), sem trava global
+typedef struct {
+   TipoGerador tipo;
+   uint64_t estado[4];  // xoshiro: estado; philox: [0] = chave, [1] = contador
+   uint32_t bloco[4];   // philox: saída do último bloco
+   int restantes;       // philox: palavras de 32 bits ainda não usadas do bloco
+} GeradorAleatorio;
+
+
+// Passo do splitmix64: embaralha x e devolve 64 bits bem distribuídos
+static inline uint64_t misturar64(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+
+// Semente independente para a execução de índice dado, derivada da semente da varredura
+static inline uint64_t sementeDaExecucao(uint64_t sementeBase, uint64_t indice) {
+    return misturar64(sementeBase + 0x9e3779b97f4a7c15ULL * (indice + 1));
+}
+
+
+// Converte 64 bits em um uniforme em [0, 1) com 53 bits de mantissa
+static inline double paraUniforme(uint64_t bits) {
+    return (double)(bits >> 11) * (1.0 / 9007199254740992.0);
+}
+
+
+// Semeia o gerador do tipo escolhido
+void semearGerador(GeradorAleatorio *gerador, TipoGerador tipo, uint64_t semente);
+
+
+// Próximo número de 64 bits
+uint64_t proximoAleatorio(GeradorAleatorio *gerador);
+
+
+// Número uniforme em [0, 1)
+static inline double uniformeAleatorio(GeradorAleatorio *gerador) {
+    return paraUniforme(proximoAleatorio(gerador));
+}
+
+
+// Preenche saida[0..n) com uniformes em [0, 1) de uma vez (r1/r2 de uma iteração inteira)
+void gerarUniformes(GeradorAleatorio *gerador, double *saida, int n);
+
+
+// Avança o gerador para um fluxo disjunto (2^128 passos no xoshiro, 2^64 blocos no philox)
+void saltarGerador(GeradorAleatorio *gerador);
+
+
+// Nome do algoritmo e conversão a partir do nome ("xoshiro" ou "philox"); retorna 0 se o nome não existir
+const char *nomeGerador(TipoGerador tipo);
+int geradorPorNome(const char *nome, TipoGerador *tipo);
+const char *nomesGeradores(void);
+
+#endif
@@ -0,0 +1,479 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#include "assincrono.h"
+#include "tempo.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+typedef struct {
+    AvaliadorAssincrono *avaliador;
+    int id;
+} MembroAvaliador;
+
+// ========== Processos filhos ===========
+
+#ifndef _WIN32
+// read/write podem transferir menos bytes que o pedido: repete até completar; 0 = canal fechado
+static int transferirTudo(int canal, void *dados, size_t bytes, int escrita) {
+    char *cursor = (char *)dados;
+    while (bytes > 0) {
+        ssize_t feito = escrita ? write(canal, cursor, bytes) : read(canal, cursor, bytes);
+        if (feito <= 0) {
+            return 0;
+        }
+        cursor += feito;
+        bytes -= (size_t)feito;
+    }
+    return 1;
+}
+
+// Laço do filho: lê um ponto, avalia, responde; termina quando o pai fecha o canal
+static void lacoFilho(const AvaliadorAssincrono *avaliador, int entrada, int saida) {
+    double ponto[1024];
+    int dimensoes = avaliador->dimensoes;
+
+    while (transferirTudo(entrada, ponto, (size_t)dimensoes * sizeof(double), 0)) {
+        double aptidao = avaliarPonto(&avaliador->objetivo, ponto, dimensoes);
+        if (avaliador->latencia > 0) {
+            dormir(avaliador->latencia);
+        }
+        if (!transferirTudo(saida, &aptidao, sizeof(double), 1)) {
+            break;
+        }
+    }
+    _exit(0);
+}
+
+// Cria o filho do avaliador id ligado por dois pipes
+static void criarFilho(AvaliadorAssincrono *avaliador, int id) {
+    int ida[2], volta[2];
+    if (pipe(ida) != 0 || pipe(volta) != 0) {
+        printf("Erro ao criar os pipes do avaliador\n");
+        exit(1);
+    }
+    fflush(stdout);
+    pid_t filho = fork();
+    if (filho < 0) {
+        printf("Erro ao criar o processo avaliador\n");
+        exit(1);
+    }
+    if (filho == 0) {
+        // o filho fica só com os próprios canais: cópias de canais de outros filhos impediriam o fim de arquivo deles
+        long maximo = sysconf(_SC_OPEN_MAX);
+        for (int canal = 3; canal < (maximo > 0 && maximo < 4096 ? maximo : 4096); canal++) {
+            if (canal != ida[0] && canal != volta[1]) {
+                close(canal);
+            }
+        }
+        lacoFilho(avaliador, ida[0], volta[1]);
+    }
+    close(ida[0]);
+    close(volta[1]);
+    avaliador->canais[2 * id] = ida[1];
+    avaliador->canais[2 * id + 1] = volta[0];
+    avaliador->filhos[id] = (int)filho;
+}
+#endif
+
+// Avalia o ponto na thread ou no filho do avaliador id
+static double avaliarSemCache(AvaliadorAssincrono *avaliador, int id, const double *ponto) {
+#ifndef _WIN32
+    if (avaliador->tipo == AVALIADOR_PROCESSO) {
+        double aptidao = DBL_MAX;
+        if (!transferirTudo(avaliador->canais[2 * id], (void *)ponto, (size_t)avaliador->dimensoes * sizeof(double), 1) ||
+            !transferirTudo(avaliador->canais[2 * id + 1], &aptidao, sizeof(double), 0)) {
+            printf("Erro na comunicacao com o processo avaliador %d\n", id);
+            exit(1);
+        }
+        return aptidao;
+    }
+#else
+    (void)id;
+#endif
+    double aptidao = avaliarPonto(&avaliador->objetivo, ponto, avaliador->dimensoes);
+    if (avaliador->latencia > 0) {
+        dormir(avaliador->latencia);
+    }
+    return aptidao;
+}
+
+// Avalia o ponto pelo cache do objetivo, se houver: ele fica na memória do pai, e um acerto não
+// paga a avaliação (nem a latência simulada); real fica 0 nos acertos
+static double avaliarNoAvaliador(AvaliadorAssincrono *avaliador, int id, const double *ponto, int *real) {
+    CacheAptidao *cache = avaliador->objetivo.cache;
+    double aptidao;
+
+    *real = 1;
+    if (cache == NULL) {
+        return avaliarSemCache(avaliador, id, ponto);
+    }
+    if (consultarCache(cache, ponto, 1, &aptidao)) {
+        contarConsultas(cache, 1, 1);
+        *real = 0;
+        return aptidao;
+    }
+    aptidao = avaliarSemCache(avaliador, id, ponto);
+    guardarNoCache(cache, ponto, 1, aptidao);
+    contarConsultas(cache, 1, 0);
+    return aptidao;
+}
+
+// ========== Avaliadores ===========
+
+static void *lacoAvaliador(void *argumento) {
+    MembroAvaliador *membro = (MembroAvaliador *)argumento;
+    AvaliadorAssincrono *avaliador = membro->avaliador;
+
+    for (;;) {
+        pthread_mutex_lock(&avaliador->trava);
+        while (avaliador->numPedidos == 0 && !avaliador->encerrar) {
+            pthread_cond_wait(&avaliador->temPedido, &avaliador->trava);
+        }
+        if (avaliador->numPedidos == 0) {
+            pthread_mutex_unlock(&avaliador->trava);
+            break;
+        }
+        PedidoAvaliacao pedido = avaliador->pedidos[avaliador->inicioPedidos];
+        avaliador->inicioPedidos = (avaliador->inicioPedidos + 1) % avaliador->capacidadeFila;
+        avaliador->numPedidos--;
+        const double *ponto = &avaliador->pontos[(size_t)pedido.particula * avaliador->dimensoes];
+        pthread_cond_signal(&avaliador->temEspaco);
+        pthread_mutex_unlock(&avaliador->trava);
+
+        double inicio = tempoAtual();
+        pedido.aptidao = avaliarNoAvaliador(avaliador, membro->id, ponto, &pedido.real);
+        double ocupado = tempoAtual() - inicio;
+
+        pthread_mutex_lock(&avaliador->trava);
+        int fim = (avaliador->inicioRespostas + avaliador->numRespostas) % avaliador->capacidadeRespostas;
+        avaliador->respostas[fim] = pedido;
+        avaliador->numRespostas++;
+        avaliador->estatistica.tempoOcupado += ocupado;
+        pthread_cond_signal(&avaliador->temResposta);
+        pthread_mutex_unlock(&avaliador->trava);
+    }
+    free(membro);
+    return NULL;
+}
+
+void iniciarAvaliador(AvaliadorAssincrono *avaliador, TipoAvaliador tipo, int numAvaliadores, int capacidadeFila,
+                      const Objetivo *objetivo, int dimensoes, double latencia) {
+    memset(avaliador, 0, sizeof(*avaliador));
+#ifdef _WIN32
+    tipo = AVALIADOR_THREAD;
+#endif
+    avaliador->tipo = tipo;
+    avaliador->numAvaliadores = numAvaliadores > 1 ? numAvaliadores : 1;
+    avaliador->capacidadeFila = capacidadeFila > 0 ? capacidadeFila : 2 * avaliador->numAvaliadores;
+    avaliador->objetivo = *objetivo;
+    avaliador->dimensoes = dimensoes;
+    avaliador->latencia = latencia;
+    avaliador->pedidos = (PedidoAvaliacao *)malloc(avaliador->capacidadeFila * sizeof(PedidoAvaliacao));
+    avaliador->threads = (pthread_t *)malloc(avaliador->numAvaliadores * sizeof(pthread_t));
+    avaliador->canais = (int *)malloc(2 * avaliador->numAvaliadores * sizeof(int));
+    avaliador->filhos = (int *)malloc(avaliador->numAvaliadores * sizeof(int));
+    if (avaliador->pedidos == NULL || avaliador->threads == NULL || avaliador->canais == NULL || avaliador->filhos == NULL) {
+        printf("Erro ao alocar os avaliadores\n");
+        exit(1);
+    }
+    if (tipo == AVALIADOR_PROCESSO && dimensoes > 1024) {
+        printf("O avaliador em processo aceita no maximo 1024 dimensoes\n");
+        exit(1);
+    }
+    pthread_mutex_init(&avaliador->trava, NULL);
+    pthread_cond_init(&avaliador->temPedido, NULL);
+    pthread_cond_init(&avaliador->temEspaco, NULL);
+    pthread_cond_init(&avaliador->temResposta, NULL);
+
+#ifndef _WIN32
+    // os filhos nascem antes das threads do avaliador
+    if (tipo == AVALIADOR_PROCESSO) {
+        for (int a = 0; a < avaliador->numAvaliadores; a++) {
+            criarFilho(avaliador, a);
+        }
+    }
+#endif
+    for (int a = 0; a < avaliador->numAvaliadores; a++) {
+        MembroAvaliador *membro = (MembroAvaliador *)malloc(sizeof(MembroAvaliador));
+        if (membro == NULL) {
+            printf("Erro ao alocar os avaliadores\n");
+            exit(1);
+        }
+        membro->avaliador = avaliador;
+        membro->id = a;
+        pthread_create(&avaliador->threads[a], NULL, lacoAvaliador, membro);
+    }
+}
+
+// Garante uma resposta e uma posição por partícula; só é chamada sem avaliações em voo
+static void prepararFilas(AvaliadorAssincrono *avaliador, int numParticulas) {
+    pthread_mutex_lock(&avaliador->trava);
+    if (avaliador->capacidadeRespostas < numParticulas) {
+        free(avaliador->respostas);
+        free(avaliador->pontos);
+        avaliador->respostas = (PedidoAvaliacao *)malloc(numParticulas * sizeof(PedidoAvaliacao));
+        avaliador->pontos = (double *)malloc((size_t)numParticulas * avaliador->dimensoes * sizeof(double));
+        if (avaliador->respostas == NULL || avaliador->pontos == NULL) {
+            printf("Erro ao alocar as filas do avaliador\n");
+            exit(1);
+        }
+        avaliador->capacidadeRespostas = numParticulas;
+    }
+    avaliador->inicioPedidos = avaliador->numPedidos = 0;
+    avaliador->inicioRespostas = avaliador->numRespostas = 0;
+    pthread_mutex_unlock(&avaliador->trava);
+}
+
+// ========== Motor assíncrono ===========
+
+// Estado do motor ao longo de uma execução
+typedef struct {
+    int emVoo;              // Avaliações enviadas e ainda não recebidas
+    double ultimoInstante;  // Última mudança de emVoo (para a integral)
+    EstatisticaAssincrona estatistica;
+} ControleAssincrono;
+
+// Acumula a integral de emVoo até agora e aplica a variação
+static void mudarEmVoo(ControleAssincrono *controle, int variacao) {
+    double agora = tempoAtual();
+    controle->estatistica.emVooIntegral += controle->emVoo * (agora - controle->ultimoInstante);
+    controle->ultimoInstante = agora;
+    controle->emVoo += variacao;
+    if (controle->emVoo > controle->estatistica.emVooMaximo) {
+        controle->estatistica.emVooMaximo = controle->emVoo;
+    }
+}
+
+// Copia a posição da partícula e a coloca na fila (espera se a fila estiver cheia)
+static void enviarParticula(AvaliadorAssincrono *avaliador, const Swarm *enxame, int i, ControleAssincrono *controle) {
+    double *ponto = &avaliador->pontos[(size_t)i * avaliador->dimensoes];
+    for (int d = 0; d < enxame->dimensions; d++) {
+        ponto[d] = COORD(enxame, position, d, i);
+    }
+
+    pthread_mutex_lock(&avaliador->trava);
+    while (avaliador->numPedidos == avaliador->capacidadeFila) {
+        pthread_cond_wait(&avaliador->temEspaco, &avaliador->trava);
+    }
+    int fim = (avaliador->inicioPedidos + avaliador->numPedidos) % avaliador->capacidadeFila;
+    avaliador->pedidos[fim].particula = i;
+    avaliador->numPedidos++;
+    pthread_cond_signal(&avaliador->temPedido);
+    pthread_mutex_unlock(&avaliador->trava);
+    mudarEmVoo(controle, 1);
+}
+
+// Espera a próxima resposta
+static PedidoAvaliacao receberResposta(AvaliadorAssincrono *avaliador, ControleAssincrono *controle) {
+    pthread_mutex_lock(&avaliador->trava);
+    while (avaliador->numRespostas == 0) {
+        pthread_cond_wait(&avaliador->temResposta, &avaliador->trava);
+    }
+    PedidoAvaliacao resposta = avaliador->respostas[avaliador->inicioRespostas];
+    avaliador->inicioRespostas = (avaliador->inicioRespostas + 1) % avaliador->capacidadeRespostas;
+    avaliador->numRespostas--;
+    pthread_mutex_unlock(&avaliador->trava);
+    mudarEmVoo(controle, -1);
+    return resposta;
+}
+
+// pBest e gBest da partícula avaliada; o gBest vale na hora para as próximas partículas a se mover
+static void aplicarResposta(Swarm *enxame, PedidoAvaliacao resposta) {
+    int i = resposta.particula;
+    enxame->fitness[i] = resposta.aptidao;
+    enxame->avaliacoes += resposta.real;
+    if (resposta.aptidao < enxame->bestFitness[i]) {
+        enxame->bestFitness[i] = resposta.aptidao;
+        for (int d = 0; d < enxame->dimensions; d++) {
+            COORD(enxame, bestPosition, d, i) = COORD(enxame, position, d, i);
+        }
+    }
+    if (resposta.aptidao < enxame->globalBestFitness) {
+        enxame->globalBestFitness = resposta.aptidao;
+        for (int d = 0; d < enxame->dimensions; d++) {
+            enxame->globalBestPosition[d] = COORD(enxame, position, d, i);
+        }
+    }
+}
+
+// Velocidade e posição de uma partícula com o gBest atual
+static void moverParticula(Swarm *enxame, const ParametrosPSO *parametros, const Fronteira *fronteira, int i) {
+    for (int d = 0; d < enxame->dimensions; d++) {
+        double *posicao = &COORD(enxame, position, d, i);
+        double *velocidade = &COORD(enxame, velocity, d, i);
+        double r1 = uniformeAleatorio(&enxame->gerador);
+        double r2 = uniformeAleatorio(&enxame->gerador);
+
+        *velocidade = parametros->w * *velocidade +
+                      parametros->c1 * r1 * (COORD(enxame, bestPosition, d, i) - *posicao) +
+                      parametros->c2 * r2 * (enxame->globalBestPosition[d] - *posicao);
+        // só a política de reinício consome mais um sorteio
+        double sorteio = fronteira->politica == FRONTEIRA_REINICIAR ? uniformeAleatorio(&enxame->gerador) : 0.0;
+        moverLinha(fronteira, posicao, velocidade, &sorteio, 1);
+    }
+}
+
+double executarPSOAssincrono(Swarm *enxame, const ParametrosPSO *parametros, AvaliadorAssincrono *avaliador, ResultadoPSO *resultado) {
+    const CriteriosParada *criterios = &parametros->parada;
+    const Fronteira fronteira = fronteiraDosParametros(parametros);
+    // coeficientes da "iteração" atual: a agenda os recalcula a cada n respostas
+    ParametrosPSO atual = *parametros;
+    Coeficientes base = {parametros->w, parametros->c1, parametros->c2};
+    int n = enxame->numParticles;
+    long long limite = (long long)n * (parametros->iteracoes + 1);
+    long long maximas = criterios->avaliacoesMaximas;
+    long long enviadas = 0, concluidas = 0;
+    CriterioParada criterio = PARADA_NENHUMA;
+    ControleAssincrono controle;
+    double ultimoMelhor = DBL_MAX;
+    int semMelhora = 0, iter = 0;
+
+    prepararFilas(avaliador, n);
+    memset(&controle, 0, sizeof(controle));
+    double inicio = tempoAtual();
+    controle.ultimoInstante = inicio;
+
+    // o orçamento conta as avaliações de fato mais as em voo (um acerto do cache em voo conta até voltar)
+    for (int i = 0; i < n && enviadas < limite && (maximas <= 0 || enviadas < maximas); i++, enviadas++) {
+        enviarParticula(avaliador, enxame, i, &controle);
+    }
+    while (controle.emVoo > 0) {
+        PedidoAvaliacao resposta = receberResposta(avaliador, &controle);
+        aplicarResposta(enxame, resposta);
+        concluidas++;
+
+        // a cada n respostas fecha uma "iteração" (a primeira é a inicialização)
+        if (concluidas % n == 0) {
+            if (concluidas > n) {
+                iter++;
+                TELEMETRIA_REGISTRAR(parametros->telemetria, enxame);
+            }
+            if (parametros->agenda.tipo != AGENDA_FIXA) {
+                double sucesso = parametros->agenda.tipo == AGENDA_ADAPTATIVA
+                               ? taxaDeSucesso(enxame->fitness, enxame->bestFitness, n, 1) : 0.0;
+                Coeficientes coeficientes = coeficientesDaIteracao(&parametros->agenda, base, iter, parametros->iteracoes, sucesso);
+                atual.w = coeficientes.w;
+                atual.c1 = coeficientes.c1;
+                atual.c2 = coeficientes.c2;
+            }
+            if (enxame->globalBestFitness < ultimoMelhor) {
+                ultimoMelhor = enxame->globalBestFitness;
+                semMelhora = 0;
+            } else {
+                semMelhora++;
+            }
+        }
+
+        // depois de parar só drena as avaliações em voo
+        if (criterio == PARADA_NENHUMA) {
+            if (!isnan(criterios->alvo) && enxame->globalBestFitness <= criterios->alvo) {
+                criterio = PARADA_ALVO;
+            } else if (criterios->estagnacao > 0 && semMelhora >= criterios->estagnacao) {
+                criterio = PARADA_ESTAGNACAO;
+            } else if (criterios->tempoMaximo > 0 && tempoAtual() - inicio >= criterios->tempoMaximo) {
+                criterio = PARADA_TEMPO;
+            } else if (enviadas >= limite) {
+                criterio = PARADA_ITERACOES;
+            } else if (maximas > 0 && enxame->avaliacoes + controle.emVoo >= maximas) {
+                criterio = PARADA_AVALIACOES;
+            }
+        }
+        if (criterio == PARADA_NENHUMA) {
+            moverParticula(enxame, &atual, &fronteira, resposta.particula);
+            enviarParticula(avaliador, enxame, resposta.particula, &controle);
+            enviadas++;
+        }
+    }
+
+    controle.estatistica.avaliacoes = concluidas;
+    controle.estatistica.tempoParede = tempoAtual() - inicio;
+    // tempoOcupado já é somado pelos avaliadores a cada resposta
+    pthread_mutex_lock(&avaliador->trava);
+    somarEstatisticaAssincrona(&avaliador->estatistica, &controle.estatistica);
+    pthread_mutex_unlock(&avaliador->trava);
+
+    if (resultado != NULL) {
+        resultado->melhor = enxame->globalBestFitness;
+        resultado->iteracoes = iter;
+        resultado->avaliacoes = enxame->avaliacoes;
+        resultado->criterio = criterio;
+    }
+    return enxame->globalBestFitness;
+}
+
+// ========== Estatística ===========
+
+void somarEstatisticaAssincrona(EstatisticaAssincrona *destino, const EstatisticaAssincrona *origem) {
+    destino->avaliacoes += origem->avaliacoes;
+    destino->tempoParede += origem->tempoParede;
+    destino->tempoOcupado += origem->tempoOcupado;
+    destino->emVooIntegral += origem->emVooIntegral;
+    if (origem->emVooMaximo > destino->emVooMaximo) {
+        destino->emVooMaximo = origem->emVooMaximo;
+    }
+}
+
+void relatarEstatisticaAssincrona(const EstatisticaAssincrona *estatistica, int numAvaliadores, int numFilas) {
+    // a estatística soma as filas que rodaram lado a lado: o tempo de parede de cada uma é a média
+    double parede = estatistica->tempoParede > 0 ? estatistica->tempoParede : 1e-12;
+    double paredePorFila = parede / numFilas;
+
+    printf("\n\t\t =====| AVALIACAO ASSINCRONA |=====\n\n");
+    printf("Avaliacoes: %lld em %.3f s (%.1f avaliacoes/s)\n", estatistica->avaliacoes, paredePorFila, estatistica->avaliacoes / paredePorFila);
+    printf("Em voo por fila: media %.2f, maximo %d\n", estatistica->emVooIntegral / parede, estatistica->emVooMaximo);
+    printf("Utilizacao dos %d avaliadores de cada fila: %.1f%%\n", numAvaliadores, 100.0 * estatistica->tempoOcupado / (parede * numAvaliadores));
+}
+
+void encerrarAvaliador(AvaliadorAssincrono *avaliador) {
+    pthread_mutex_lock(&avaliador->trava);
+    avaliador->encerrar = 1;
+    pthread_cond_broadcast(&avaliador->temPedido);
+    pthread_mutex_unlock(&avaliador->trava);
+    for (int a = 0; a < avaliador->numAvaliadores; a++) {
+        pthread_join(avaliador->threads[a], NULL);
+    }
+#ifndef _WIN32
+    // fechar o canal de ida encerra o laço do filho
+    if (avaliador->tipo == AVALIADOR_PROCESSO) {
+        for (int a = 0; a < avaliador->numAvaliadores; a++) {
+            close(avaliador->canais[2 * a]);
+            close(avaliador->canais[2 * a + 1]);
+            waitpid((pid_t)avaliador->filhos[a], NULL, 0);
+        }
+    }
+#endif
+    pthread_mutex_destroy(&avaliador->trava);
+    pthread_cond_destroy(&avaliador->temPedido);
+    pthread_cond_destroy(&avaliador->temEspaco);
+    pthread_cond_destroy(&avaliador->temResposta);
+    free(avaliador->pedidos);
+    free(avaliador->respostas);
+    free(avaliador->pontos);
+    free(avaliador->threads);
+    free(avaliador->canais);
+    free(avaliador->filhos);
+}
+
+int avaliadorPorNome(const char *nome, TipoAvaliador *tipo) {
+    if (strcmp(nome, "thread") == 0) {
+        *tipo = AVALIADOR_THREAD;
+        return 1;
+    }
+    if (strcmp(nome, "processo") == 0) {
+        *tipo = AVALIADOR_PROCESSO;
+        return 1;
+    }
+    return 0;
+}
+
+const char *nomesAvaliadores(void) {
+    return "thread, processo";
+}
@@ -0,0 +1,86 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef ASSINCRONO_H
+#define ASSINCRONO_H
+#include <pthread.h>
+#include "motor.h"
+
+// Onde cada avaliador roda a função objetivo
+typedef enum {
+   AVALIADOR_THREAD,   // Na própria thread avaliadora
+   AVALIADOR_PROCESSO  // Num processo filho por avaliador, falando por pipes (só fora do Windows)
+} TipoAvaliador;
+
+// Vazão e ocupação acumuladas pelas execuções de um avaliador
+typedef struct {
+   long long avaliacoes;   // Avaliações concluídas
+   double tempoParede;     // Segundos com o motor assíncrono rodando
+   double tempoOcupado;    // Soma dos segundos que os avaliadores passaram avaliando
+   double emVooIntegral;   // Integral no tempo do número de avaliações em voo
+   int emVooMaximo;        // Maior número de avaliações em voo ao mesmo tempo
+} EstatisticaAssincrona;
+
+// Item das filas: a partícula (a posição enviada fica em pontos) e, na resposta, a aptidão
+typedef struct {
+   int particula;
+   int real;               // Na resposta: 1 = a função foi chamada, 0 = acerto do cache
+   double aptidao;
+} PedidoAvaliacao;
+
+// Fila limitada de pedidos + fila de respostas, atendidas por numAvaliadores threads
+typedef struct {
+   TipoAvaliador tipo;
+   int numAvaliadores;
+   pthread_t *threads;          // Uma thread por avaliador
+   int *canais;                 // Processo: [2 * avaliador] escreve no filho, [2 * avaliador + 1] lê dele
+   int *filhos;                 // Processo: pid do filho de cada avaliador
+   Objetivo objetivo;           // Função avaliada (a mesma do enxame)
+   int dimensoes;
+   double latencia;             // Latência simulada por avaliação em segundos (0 = nenhuma)
+   pthread_mutex_t trava;       // Protege as duas filas e a estatística
+   pthread_cond_t temPedido;    // Sinaliza os avaliadores
+   pthread_cond_t temEspaco;    // Sinaliza o motor que a fila de pedidos tem espaço
+   pthread_cond_t temResposta;  // Sinaliza o motor que há respostas
+   PedidoAvaliacao *pedidos;    // Anel de pedidos [capacidadeFila]
+   int capacidadeFila;
+   int inicioPedidos, numPedidos;
+   PedidoAvaliacao *respostas;  // Anel de respostas [capacidadeRespostas]
+   int capacidadeRespostas;
+   int inicioRespostas, numRespostas;
+   double *pontos;              // Posição enviada de cada partícula [capacidadeRespostas][dimensoes]
+   int encerrar;                // 1 = os avaliadores saem do laço
+   EstatisticaAssincrona estatistica;
+} AvaliadorAssincrono;
+
+
+// Cria os avaliadores e a fila de pedidos com capacidadeFila posições (<= 0 = 2 por avaliador).
+// No Windows o tipo processo cai para thread.
+void iniciarAvaliador(AvaliadorAssincrono *avaliador, TipoAvaliador tipo, int numAvaliadores, int capacidadeFila,
+                      const Objetivo *objetivo, int dimensoes, double latencia);
+
+
+// Executa o PSO assíncrono no enxame sorteado (sortearEnxame): toda partícula vai para a fila e,
+// assim que a sua avaliação volta, atualiza pBest e gBest (semântica assíncrona), se move e volta
+// para a fila. Uma "iteração" são numParticulas avaliações; o orçamento é o mesmo do motor clássico.
+// Critérios de raio e velocidade mínimos não se aplicam. Com mais de um avaliador a ordem das
+// respostas, e portanto a trajetória, depende do escalonamento.
+double executarPSOAssincrono(Swarm *enxame, const ParametrosPSO *parametros, AvaliadorAssincrono *avaliador, ResultadoPSO *resultado);
+
+
+// Soma a estatística de origem na de destino
+void somarEstatisticaAssincrona(EstatisticaAssincrona *destino, const EstatisticaAssincrona *origem);
+
+
+// Imprime vazão, avaliações em voo (média e máximo) e utilização dos avaliadores;
+// numFilas é o número de avaliadores (filas) somados na estatística
+void relatarEstatisticaAssincrona(const EstatisticaAssincrona *estatistica, int numAvaliadores, int numFilas);
+
+
+// Encerra os avaliadores (e os processos filhos)
+void encerrarAvaliador(AvaliadorAssincrono *avaliador);
+
+
+// Tipo pelo nome ("thread" ou "processo"); retorna 0 se o nome não existir
+int avaliadorPorNome(const char *nome, TipoAvaliador *tipo);
+const char *nomesAvaliadores(void);
+
+#endif
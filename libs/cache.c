@@ -0,0 +1,199 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cache.h"
+#include "aleatorio.h"
+
+// Maior coordenada quantizada (evita o estouro na conversão com tolerâncias minúsculas)
+#define LIMITE_QUANTIZADO 9.0e18
+
+void criarCache(CacheAptidao *cache, int dimensoes, double tolerancia, double megabytes) {
+    size_t porEntrada = sizeof(EntradaCache) + (size_t)dimensoes * sizeof(int64_t);
+    size_t cabem = (size_t)(megabytes * 1024.0 * 1024.0) / porEntrada;
+
+    memset(cache, 0, sizeof(*cache));
+    cache->dimensoes = dimensoes;
+    cache->tolerancia = tolerancia > 0 ? tolerancia : 0.0;
+    cache->escala = tolerancia > 0 ? 1.0 / tolerancia : 0.0;
+    cache->capacidade = 64;
+    while (cache->capacidade * 2 <= cabem) {
+        cache->capacidade *= 2;
+    }
+    cache->geracao = 1;
+    cache->entradas = (EntradaCache *)calloc(cache->capacidade, sizeof(EntradaCache));
+    cache->chaves = (int64_t *)calloc(cache->capacidade * dimensoes, sizeof(int64_t));
+    if (cache->entradas == NULL || cache->chaves == NULL) {
+        printf("Erro ao alocar o cache de aptidoes\n");
+        exit(1);
+    }
+}
+
+void esvaziarCache(CacheAptidao *cache) {
+    // as entradas guardam a geração em 32 bits: na volta do contador elas são zeradas de fato
+    if (++cache->geracao == 0) {
+        memset(cache->entradas, 0, cache->capacidade * sizeof(EntradaCache));
+        cache->geracao = 1;
+    }
+}
+
+// Coordenada da chave: os bits exatos (tolerância 0) ou o índice da célula da grade
+static inline int64_t quantizar(const CacheAptidao *cache, double x) {
+    if (cache->tolerancia == 0) {
+        int64_t bits;
+        memcpy(&bits, &x, sizeof(bits));
+        return bits;
+    }
+    double celula = floor(x * cache->escala + 0.5);
+    celula = celula > LIMITE_QUANTIZADO ? LIMITE_QUANTIZADO : (celula < -LIMITE_QUANTIZADO ? -LIMITE_QUANTIZADO : celula);
+    return (int64_t)celula;
+}
+
+static uint64_t hashDaChave(const CacheAptidao *cache, const double *posicao, int stride) {
+    uint64_t hash = 0x9e3779b97f4a7c15ULL;
+    for (int d = 0; d < cache->dimensoes; d++) {
+        hash = misturar64(hash ^ (uint64_t)quantizar(cache, posicao[(size_t)d * stride]));
+    }
+    return hash;
+}
+
+static int mesmaChave(const CacheAptidao *cache, size_t indice, const double *posicao, int stride) {
+    const int64_t *chave = &cache->chaves[indice * cache->dimensoes];
+    for (int d = 0; d < cache->dimensoes; d++) {
+        if (__atomic_load_n(&chave[d], __ATOMIC_RELAXED) != quantizar(cache, posicao[(size_t)d * stride])) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int consultarCache(CacheAptidao *cache, const double *posicao, int stride, double *aptidao) {
+    uint64_t hash = hashDaChave(cache, posicao, stride);
+    size_t mascara = cache->capacidade - 1;
+
+    for (int j = 0; j < JANELA_CACHE; j++) {
+        size_t indice = (hash + j) & mascara;
+        EntradaCache *entrada = &cache->entradas[indice];
+        uint64_t versao = __atomic_load_n(&entrada->versao, __ATOMIC_ACQUIRE);
+        if (versao & 1) {
+            continue;
+        }
+        // nada é removido dentro de uma geração: uma entrada vazia encerra a busca
+        if (__atomic_load_n(&entrada->geracao, __ATOMIC_RELAXED) != cache->geracao) {
+            return 0;
+        }
+        if (__atomic_load_n(&entrada->hash, __ATOMIC_RELAXED) != hash || !mesmaChave(cache, indice, posicao, stride)) {
+            continue;
+        }
+        uint64_t bits = __atomic_load_n(&entrada->aptidao, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&entrada->versao, __ATOMIC_RELAXED) != versao) {
+            return 0;
+        }
+        if (!__atomic_load_n(&entrada->referencia, __ATOMIC_RELAXED)) {
+            __atomic_store_n(&entrada->referencia, 1, __ATOMIC_RELAXED);
+        }
+        memcpy(aptidao, &bits, sizeof(double));
+        return 1;
+    }
+    return 0;
+}
+
+void guardarNoCache(CacheAptidao *cache, const double *posicao, int stride, double aptidao) {
+    uint64_t hash = hashDaChave(cache, posicao, stride);
+    size_t mascara = cache->capacidade - 1;
+    size_t vitima = hash & mascara;
+    uint64_t versaoVitima = 1;
+    int vazia = 0;
+
+    for (int j = 0; j < JANELA_CACHE; j++) {
+        size_t indice = (hash + j) & mascara;
+        EntradaCache *entrada = &cache->entradas[indice];
+        uint64_t versao = __atomic_load_n(&entrada->versao, __ATOMIC_ACQUIRE);
+        if (versao & 1) {
+            continue;
+        }
+        if (__atomic_load_n(&entrada->geracao, __ATOMIC_RELAXED) != cache->geracao) {
+            vitima = indice;
+            versaoVitima = versao;
+            vazia = 1;
+            break;
+        }
+        if (__atomic_load_n(&entrada->hash, __ATOMIC_RELAXED) == hash && mesmaChave(cache, indice, posicao, stride)) {
+            return;
+        }
+        // relógio na janela: a primeira entrada sem referência sai; as que ficam para trás perdem a delas
+        if (versaoVitima & 1) {
+            if (!__atomic_load_n(&entrada->referencia, __ATOMIC_RELAXED)) {
+                vitima = indice;
+                versaoVitima = versao;
+            } else {
+                __atomic_store_n(&entrada->referencia, 0, __ATOMIC_RELAXED);
+            }
+        }
+    }
+    // todas tinham referência (agora apagadas): sai a da posição da chave
+    if (versaoVitima & 1) {
+        versaoVitima = __atomic_load_n(&cache->entradas[vitima].versao, __ATOMIC_ACQUIRE);
+    }
+
+    // outra thread escrevendo na mesma entrada: a aptidão não é guardada, só isso
+    EntradaCache *entrada = &cache->entradas[vitima];
+    if ((versaoVitima & 1) || !__atomic_compare_exchange_n(&entrada->versao, &versaoVitima, versaoVitima + 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+        __atomic_fetch_add(&cache->estatistica.descartes, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    uint64_t bits;
+    memcpy(&bits, &aptidao, sizeof(bits));
+    int64_t *chave = &cache->chaves[vitima * cache->dimensoes];
+    for (int d = 0; d < cache->dimensoes; d++) {
+        __atomic_store_n(&chave[d], quantizar(cache, posicao[(size_t)d * stride]), __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&entrada->hash, hash, __ATOMIC_RELAXED);
+    __atomic_store_n(&entrada->aptidao, bits, __ATOMIC_RELAXED);
+    __atomic_store_n(&entrada->geracao, cache->geracao, __ATOMIC_RELAXED);
+    __atomic_store_n(&entrada->referencia, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&entrada->versao, versaoVitima + 2, __ATOMIC_RELEASE);
+
+    __atomic_fetch_add(&cache->estatistica.insercoes, 1, __ATOMIC_RELAXED);
+    if (!vazia) {
+        __atomic_fetch_add(&cache->estatistica.substituicoes, 1, __ATOMIC_RELAXED);
+    }
+}
+
+void contarConsultas(CacheAptidao *cache, long long consultas, long long acertos) {
+    __atomic_fetch_add(&cache->estatistica.consultas, consultas, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&cache->estatistica.acertos, acertos, __ATOMIC_RELAXED);
+}
+
+void somarEstatisticaCache(EstatisticaCache *total, const CacheAptidao *cache) {
+    total->consultas += cache->estatistica.consultas;
+    total->acertos += cache->estatistica.acertos;
+    total->insercoes += cache->estatistica.insercoes;
+    total->substituicoes += cache->estatistica.substituicoes;
+    total->descartes += cache->estatistica.descartes;
+}
+
+void relatarEstatisticaCache(const EstatisticaCache *estatistica, const CacheAptidao *cache, int numCaches) {
+    double taxa = estatistica->consultas > 0 ? 100.0 * estatistica->acertos / estatistica->consultas : 0.0;
+    double megabytes = (double)numCaches * cache->capacidade * (sizeof(EntradaCache) + (size_t)cache->dimensoes * sizeof(int64_t)) / (1024.0 * 1024.0);
+
+    printf("\n\t\t =====| CACHE DE APTIDOES |=====\n\n");
+    printf("Chave: %s, %zu entradas por cache, %d caches (%.1f MB)\n",
+           cache->tolerancia > 0 ? "quantizada" : "exata", cache->capacidade, numCaches, megabytes);
+    if (cache->tolerancia > 0) {
+        printf("Tolerancia: %g por coordenada\n", cache->tolerancia);
+    }
+    printf("Consultas: %lld, acertos: %lld (%.2f%%), avaliacoes reais: %lld\n",
+           estatistica->consultas, estatistica->acertos, taxa, estatistica->consultas - estatistica->acertos);
+    printf("Insercoes: %lld, substituicoes: %lld, descartadas por disputa: %lld\n",
+           estatistica->insercoes, estatistica->substituicoes, estatistica->descartes);
+}
+
+void liberarCache(CacheAptidao *cache) {
+    free(cache->entradas);
+    free(cache->chaves);
+    memset(cache, 0, sizeof(*cache));
+}
@@ -0,0 +1,80 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef CACHE_H
+#define CACHE_H
+#include <stddef.h>
+#include <stdint.h>
+
+// Memória padrão do cache de aptidões, em MB
+#define MEMORIA_CACHE_PADRAO 64
+
+// Entradas examinadas a partir da posição da chave, na consulta e na inserção
+#define JANELA_CACHE 8
+
+// Cabeçalho de uma entrada. A versão funciona como um seqlock: ímpar enquanto alguém escreve a
+// entrada; quem lê confere que ela não mudou durante a leitura, sem travar nada.
+typedef struct {
+   uint64_t versao;
+   uint64_t hash;               // Hash da chave quantizada
+   uint64_t aptidao;            // Bits da aptidão guardada
+   uint32_t geracao;            // Entradas de outra geração valem como vazias
+   uint32_t referencia;         // Bit do relógio: 1 = consultada desde a última passada
+} EntradaCache;
+
+// Consultas e substituições do cache
+typedef struct {
+   long long consultas;         // Avaliações pedidas com o cache ligado
+   long long acertos;           // Respondidas pelo cache (avaliações reais evitadas)
+   long long insercoes;         // Aptidões guardadas
+   long long substituicoes;     // Entradas da geração atual descartadas pelo relógio
+   long long descartes;         // Inserções abandonadas por disputa com outra thread
+} EstatisticaCache;
+
+// Tabela de aptidões com endereçamento aberto e tamanho fixo, compartilhável entre threads.
+// A chave é a posição quantizada: com tolerância t cada coordenada vira round(x / t), então pontos
+// na mesma célula da grade recebem a aptidão do primeiro deles avaliado; com t = 0 a chave são os
+// bits exatos das coordenadas e o cache só devolve a aptidão do mesmo ponto (resultado idêntico).
+typedef struct CacheAptidao {
+   int dimensoes;
+   double tolerancia;           // 0 = chave exata
+   double escala;               // 1 / tolerancia
+   size_t capacidade;           // Entradas (potência de 2)
+   uint32_t geracao;            // Geração atual (esvaziar = avançar a geração)
+   EntradaCache *entradas;      // [capacidade]
+   int64_t *chaves;             // Chave quantizada de cada entrada [capacidade][dimensoes]
+   EstatisticaCache estatistica; // Somada atomicamente pelas threads
+} CacheAptidao;
+
+
+// Cria o cache com o maior número de entradas (potência de 2) que caiba em megabytes
+void criarCache(CacheAptidao *cache, int dimensoes, double tolerancia, double megabytes);
+
+
+// Esvazia o cache em tempo constante (sem threads usando ele)
+void esvaziarCache(CacheAptidao *cache);
+
+
+// Procura a aptidão do ponto (coordenada d em posicao[d * stride]); retorna 1 e a grava em
+// aptidao se achou. Não conta a consulta: quem consulta soma com contarConsultas.
+int consultarCache(CacheAptidao *cache, const double *posicao, int stride, double *aptidao);
+
+
+// Guarda a aptidão do ponto; com a janela cheia o relógio escolhe a entrada substituída
+void guardarNoCache(CacheAptidao *cache, const double *posicao, int stride, double aptidao);
+
+
+// Soma consultas e acertos à estatística do cache
+void contarConsultas(CacheAptidao *cache, long long consultas, long long acertos);
+
+
+// Soma a estatística do cache ao total
+void somarEstatisticaCache(EstatisticaCache *total, const CacheAptidao *cache);
+
+
+// Imprime consultas, taxa de acertos, substituições e a memória usada por numCaches caches
+void relatarEstatisticaCache(const EstatisticaCache *estatistica, const CacheAptidao *cache, int numCaches);
+
+
+// Libera a tabela
+void liberarCache(CacheAptidao *cache);
+
+#endif
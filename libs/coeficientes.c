@@ -0,0 +1,86 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <math.h>
+#include <string.h>
+#include "coeficientes.h"
+
+static const char *NOMES_AGENDA[] = {"fixa", "linear", "naolinear", "constricao", "tvac", "adaptativa"};
+
+AgendaCoeficientes agendaPadrao(TipoAgenda tipo) {
+    AgendaCoeficientes agenda;
+    agenda.tipo = tipo;
+    agenda.wInicial = 0.9;
+    agenda.wFinal = 0.4;
+    agenda.expoente = 2.0;
+    agenda.c1Inicial = 2.5;
+    agenda.c1Final = 0.5;
+    agenda.c2Inicial = 0.5;
+    agenda.c2Final = 2.5;
+    return agenda;
+}
+
+Coeficientes coeficientesDaIteracao(const AgendaCoeficientes *agenda, Coeficientes base, int iteracao, int total, double sucesso) {
+    Coeficientes coeficientes = base;
+    // fração da execução já percorrida; a última iteração chega ao valor final
+    double t = total > 1 ? (double)iteracao / (total - 1) : 1.0;
+    t = t > 1.0 ? 1.0 : t;
+
+    switch (agenda->tipo) {
+        case AGENDA_LINEAR:
+            coeficientes.w = agenda->wInicial - (agenda->wInicial - agenda->wFinal) * t;
+            break;
+        case AGENDA_NAO_LINEAR:
+            coeficientes.w = agenda->wFinal + (agenda->wInicial - agenda->wFinal) * pow(1.0 - t, agenda->expoente);
+            break;
+        case AGENDA_CONSTRICAO: {
+            double phi = base.c1 + base.c2;
+            if (phi <= 4.0) {
+                coeficientes.c1 = 2.05;
+                coeficientes.c2 = 2.05;
+                phi = 4.1;
+            }
+            double chi = 2.0 / fabs(2.0 - phi - sqrt(phi * phi - 4.0 * phi));
+            coeficientes.w = chi;
+            coeficientes.c1 *= chi;
+            coeficientes.c2 *= chi;
+            break;
+        }
+        case AGENDA_TVAC:
+            coeficientes.w = agenda->wInicial - (agenda->wInicial - agenda->wFinal) * t;
+            coeficientes.c1 = agenda->c1Inicial + (agenda->c1Final - agenda->c1Inicial) * t;
+            coeficientes.c2 = agenda->c2Inicial + (agenda->c2Final - agenda->c2Inicial) * t;
+            break;
+        case AGENDA_ADAPTATIVA:
+            coeficientes.w = agenda->wFinal + (agenda->wInicial - agenda->wFinal) * sucesso;
+            break;
+        default:
+            break;
+    }
+    return coeficientes;
+}
+
+double taxaDeSucesso(const double *aptidao, const double *melhor, int n, int stride) {
+    int sucessos = 0;
+    // sem melhora o pBest é estritamente menor, a menos que a partícula não tenha saído do lugar
+    for (int i = 0; i < n; i++) {
+        sucessos += aptidao[(long long)i * stride] == melhor[(long long)i * stride];
+    }
+    return n > 0 ? (double)sucessos / n : 0.0;
+}
+
+const char *nomeAgenda(TipoAgenda tipo) {
+    return NOMES_AGENDA[tipo];
+}
+
+int agendaPorNome(const char *nome, TipoAgenda *tipo) {
+    for (int k = 0; k < (int)(sizeof(NOMES_AGENDA) / sizeof(NOMES_AGENDA[0])); k++) {
+        if (strcmp(nome, NOMES_AGENDA[k]) == 0) {
+            *tipo = (TipoAgenda)k;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+const char *nomesAgendas(void) {
+    return "fixa, linear, naolinear, constricao, tvac, adaptativa";
+}
@@ -0,0 +1,51 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef COEFICIENTES_H
+#define COEFICIENTES_H
+
+// Como w, c1 e c2 mudam ao longo da execução
+typedef enum {
+   AGENDA_FIXA,       // Os da célula em todas as iterações (padrão)
+   AGENDA_LINEAR,     // w cai em linha reta de wInicial a wFinal
+   AGENDA_NAO_LINEAR, // w = wFinal + (wInicial - wFinal) * (1 - t/T)^expoente
+   AGENDA_CONSTRICAO, // Clerc: w = chi, c1 = chi * c1, c2 = chi * c2 (c1 = c2 = 2.05 se c1 + c2 <= 4)
+   AGENDA_TVAC,       // w linear e coeficientes variando no tempo: c1 de c1Inicial a c1Final, c2 de c2Inicial a c2Final
+   AGENDA_ADAPTATIVA  // w = wFinal + (wInicial - wFinal) * taxa de partículas que melhoraram o pBest
+} TipoAgenda;
+
+// Agenda dos coeficientes e os extremos de cada curva
+typedef struct {
+   TipoAgenda tipo;
+   double wInicial;   // Inércia no início (ou com sucesso total na adaptativa)
+   double wFinal;     // Inércia no fim (ou sem nenhum sucesso na adaptativa)
+   double expoente;   // Curvatura da agenda não linear
+   double c1Inicial, c1Final; // Componente cognitiva na TVAC
+   double c2Inicial, c2Final; // Componente social na TVAC
+} AgendaCoeficientes;
+
+// Coeficientes de uma iteração
+typedef struct {
+   double w, c1, c2;
+} Coeficientes;
+
+
+// Agenda com os extremos usuais da literatura: w de 0.9 a 0.4, expoente 2, TVAC com c1 de 2.5 a 0.5 e c2 de 0.5 a 2.5
+AgendaCoeficientes agendaPadrao(TipoAgenda tipo);
+
+
+// Coeficientes da iteração (0 a total - 1) a partir dos da célula; sucesso (0 a 1) só é usado
+// pela agenda adaptativa. Calculados uma vez por iteração: o laço das partículas só multiplica e soma.
+Coeficientes coeficientesDaIteracao(const AgendaCoeficientes *agenda, Coeficientes base, int iteracao, int total, double sucesso);
+
+
+// Fração das n partículas que estão no próprio pBest (aptidão atual == a do pBest), isto é,
+// que melhoraram na última avaliação; stride separa partículas consecutivas (1 no enxame)
+double taxaDeSucesso(const double *aptidao, const double *melhor, int n, int stride);
+
+
+// Nome e conversão a partir do nome (fixa, linear, naolinear, constricao, tvac, adaptativa);
+// a conversão retorna 0 se o nome não existir
+const char *nomeAgenda(TipoAgenda tipo);
+int agendaPorNome(const char *nome, TipoAgenda *tipo);
+const char *nomesAgendas(void);
+
+#endif
@@ -0,0 +1,585 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "distribuido.h"
+#include "tempo.h"
+
+#ifndef _WIN32
+#include <netdb.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+// As mensagens vão com a ordem de bytes e o alinhamento da máquina: os nós devem ter a mesma arquitetura
+enum { MENSAGEM_LOTE = 1, MENSAGEM_ENCERRAR = 2 };
+
+// Primeira mensagem do coordenador a cada trabalhador
+typedef struct {
+   char magica[8];
+   uint32_t versao;
+   int32_t trabalhador;     // Identificador dado pelo coordenador
+   uint64_t semente;        // Semente da varredura
+} BoasVindas;
+
+// Resposta do trabalhador: a varredura que ele expandiu com a semente recebida
+typedef struct {
+   char magica[8];
+   uint32_t versao;
+   int32_t total;
+   uint64_t impressao;
+} Saudacao;
+
+// Pedido do coordenador: um lote de execuções ou o fim da varredura
+typedef struct {
+   int32_t tipo;
+   int32_t lote;
+   int32_t primeira;
+   int32_t fim;
+} MensagemLote;
+
+// Resultado de um lote; seguem numCelulas Estatistica, da célula primeiraCelula em diante
+typedef struct {
+   int32_t lote;
+   int32_t primeiraCelula;
+   int32_t numCelulas;
+   int32_t reservado;
+   int64_t avaliacoes;
+} ResultadoLote;
+
+ConfiguracaoDistribuida configuracaoDistribuidaPadrao(void) {
+    ConfiguracaoDistribuida config;
+    memset(&config, 0, sizeof(config));
+    strcpy(config.endereco, "127.0.0.1");
+    config.porta = PORTA_DISTRIBUIDA_PADRAO;
+    config.processosLocais = 0;
+    config.tamanhoLote = 0;
+    config.prazoLote = 0;
+    config.tentativas = TENTATIVAS_DISTRIBUIDAS;
+    return config;
+}
+
+int lerEnderecoDistribuido(ConfiguracaoDistribuida *config, const char *texto) {
+    const char *separador = strrchr(texto, ':');
+    const char *porta = texto;
+
+    if (separador != NULL) {
+        size_t tamanho = (size_t)(separador - texto);
+        if (tamanho == 0 || tamanho >= sizeof(config->endereco)) {
+            return 0;
+        }
+        memcpy(config->endereco, texto, tamanho);
+        config->endereco[tamanho] = '\0';
+        porta = separador + 1;
+    }
+    char *fim;
+    long numero = strtol(porta, &fim, 10);
+    if (*porta == '\0' || *fim != '\0' || numero < 0 || numero > 65535) {
+        return 0;
+    }
+    config->porta = (int)numero;
+    return 1;
+}
+
+void relatarEstatisticaDistribuida(const EstatisticaDistribuida *estatistica) {
+    printf("\nVarredura distribuida: %d lotes, %d trabalhadores (%d recusados), %d falhas, %d reenvios por prazo\n",
+           estatistica->lotes, estatistica->trabalhadores, estatistica->recusados, estatistica->falhas, estatistica->reenvios);
+    printf("%lld avaliacoes em %.3f s (%.0f avaliacoes/s)\n", estatistica->avaliacoes, estatistica->tempo,
+           estatistica->tempo > 0 ? estatistica->avaliacoes / estatistica->tempo : 0.0);
+}
+
+#ifndef _WIN32
+
+// ========== Canais ===========
+
+// read/write podem transferir menos bytes que o pedido: repete até completar; 0 = canal fechado ou com erro
+static int transferirTudo(int canal, void *dados, size_t bytes, int escrita) {
+    char *cursor = (char *)dados;
+    while (bytes > 0) {
+        ssize_t feito = escrita ? write(canal, cursor, bytes) : read(canal, cursor, bytes);
+        if (feito <= 0) {
+            return 0;
+        }
+        cursor += feito;
+        bytes -= (size_t)feito;
+    }
+    return 1;
+}
+
+// Mensagens curtas vão na hora, sem esperar para juntar com as próximas
+static void semAtraso(int canal) {
+    int um = 1;
+    setsockopt(canal, IPPROTO_TCP, TCP_NODELAY, &um, sizeof(um));
+}
+
+static struct addrinfo *resolverEndereco(const char *endereco, int porta, int passivo) {
+    struct addrinfo dica, *lista = NULL;
+    char textoPorta[16];
+
+    memset(&dica, 0, sizeof(dica));
+    dica.ai_family = AF_UNSPEC;
+    dica.ai_socktype = SOCK_STREAM;
+    dica.ai_flags = passivo ? AI_PASSIVE : 0;
+    snprintf(textoPorta, sizeof(textoPorta), "%d", porta);
+    if (getaddrinfo(endereco, textoPorta, &dica, &lista) != 0) {
+        printf("Endereco invalido: %s:%d\n", endereco, porta);
+        exit(1);
+    }
+    return lista;
+}
+
+// Abre o canal de escuta do coordenador; com porta 0 devolve em *porta a escolhida pelo sistema
+static int abrirEscuta(const char *endereco, int *porta) {
+    struct addrinfo *lista = resolverEndereco(endereco, *porta, 1);
+    int escuta = -1;
+
+    for (struct addrinfo *item = lista; item != NULL && escuta < 0; item = item->ai_next) {
+        int um = 1;
+        escuta = socket(item->ai_family, item->ai_socktype, item->ai_protocol);
+        if (escuta < 0) {
+            continue;
+        }
+        setsockopt(escuta, SOL_SOCKET, SO_REUSEADDR, &um, sizeof(um));
+        if (bind(escuta, item->ai_addr, item->ai_addrlen) != 0 || listen(escuta, 64) != 0) {
+            close(escuta);
+            escuta = -1;
+        }
+    }
+    freeaddrinfo(lista);
+    if (escuta < 0) {
+        printf("Erro ao escutar em %s:%d\n", endereco, *porta);
+        exit(1);
+    }
+    struct sockaddr_storage local;
+    socklen_t tamanho = sizeof(local);
+    getsockname(escuta, (struct sockaddr *)&local, &tamanho);
+    *porta = local.ss_family == AF_INET6 ? ntohs(((struct sockaddr_in6 *)&local)->sin6_port)
+                                         : ntohs(((struct sockaddr_in *)&local)->sin_port);
+    return escuta;
+}
+
+// ========== Trabalhador ===========
+
+int conectarAoCoordenador(const ConfiguracaoDistribuida *config, unsigned long long *semente, int *trabalhador) {
+    int canal = -1;
+    BoasVindas boasVindas;
+
+    // o coordenador pode ainda estar subindo: tenta por alguns segundos
+    for (int tentativa = 0; tentativa < 50 && canal < 0; tentativa++) {
+        struct addrinfo *lista = resolverEndereco(config->endereco, config->porta, 0);
+        for (struct addrinfo *item = lista; item != NULL && canal < 0; item = item->ai_next) {
+            canal = socket(item->ai_family, item->ai_socktype, item->ai_protocol);
+            if (canal >= 0 && connect(canal, item->ai_addr, item->ai_addrlen) != 0) {
+                close(canal);
+                canal = -1;
+            }
+        }
+        freeaddrinfo(lista);
+        if (canal < 0) {
+            dormir(0.2);
+        }
+    }
+    if (canal < 0) {
+        printf("Nao foi possivel conectar ao coordenador em %s:%d\n", config->endereco, config->porta);
+        exit(1);
+    }
+    semAtraso(canal);
+    if (!transferirTudo(canal, &boasVindas, sizeof(boasVindas), 0) ||
+        memcmp(boasVindas.magica, MAGICA_DISTRIBUIDA, 8) != 0 || boasVindas.versao != VERSAO_DISTRIBUIDA) {
+        printf("Resposta invalida do coordenador em %s:%d\n", config->endereco, config->porta);
+        exit(1);
+    }
+    *semente = boasVindas.semente;
+    *trabalhador = boasVindas.trabalhador;
+    return canal;
+}
+
+void servirCoordenador(int canal, int trabalhador, PlanoExpandido *plano, uint64_t impressao, const TrabalhoDistribuido *trabalho) {
+    Saudacao saudacao;
+    MensagemLote mensagem;
+    int aberto = 0;
+
+    // um coordenador que caiu vira erro de escrita em vez de SIGPIPE
+    signal(SIGPIPE, SIG_IGN);
+    memcpy(saudacao.magica, MAGICA_DISTRIBUIDA, 8);
+    saudacao.versao = VERSAO_DISTRIBUIDA;
+    saudacao.total = plano->numTarefas;
+    saudacao.impressao = impressao;
+    if (!transferirTudo(canal, &saudacao, sizeof(saudacao), 1)) {
+        printf("Conexao com o coordenador perdida\n");
+        exit(1);
+    }
+
+    while (transferirTudo(canal, &mensagem, sizeof(mensagem), 0) && mensagem.tipo == MENSAGEM_LOTE) {
+        if (mensagem.primeira < 0 || mensagem.primeira >= mensagem.fim || mensagem.fim > plano->numTarefas) {
+            printf("Lote invalido recebido do coordenador\n");
+            break;
+        }
+        if (!aberto) {
+            trabalho->abrir(trabalhador, trabalho->contexto);
+            aberto = 1;
+        }
+        ResultadoLote resultado;
+        resultado.lote = mensagem.lote;
+        resultado.primeiraCelula = plano->tarefas[mensagem.primeira].celula;
+        resultado.numCelulas = plano->tarefas[mensagem.fim - 1].celula - resultado.primeiraCelula + 1;
+        resultado.reservado = 0;
+        resultado.avaliacoes = trabalho->executar(mensagem.primeira, mensagem.fim, trabalho->contexto);
+
+        // só a estatística das células volta; a célula é zerada para o próximo lote que a tocar
+        int enviado = transferirTudo(canal, &resultado, sizeof(resultado), 1);
+        for (int c = 0; c < resultado.numCelulas; c++) {
+            enviado = enviado && transferirTudo(canal, &plano->celulas[resultado.primeiraCelula + c].estatistica, sizeof(Estatistica), 1);
+            zerarEstatistica(&plano->celulas[resultado.primeiraCelula + c].estatistica);
+        }
+        if (!enviado) {
+            printf("Conexao com o coordenador perdida\n");
+            break;
+        }
+    }
+    if (aberto) {
+        trabalho->fechar(trabalho->contexto);
+    }
+    close(canal);
+}
+
+// ========== Coordenador ===========
+
+typedef enum {
+   LOTE_PENDENTE,
+   LOTE_EM_ANDAMENTO,
+   LOTE_CONCLUIDO
+} EstadoLote;
+
+// Um lote de execuções consecutivas e as estatísticas que voltaram dele
+typedef struct {
+   int primeira, fim;           // Execuções [primeira, fim)
+   int primeiraCelula, numCelulas;
+   EstadoLote estado;
+   int copias;                  // Trabalhadores rodando o lote agora
+   int falhas;
+   double envio;                // Momento do último envio
+   Estatistica *parciais;       // [numCelulas]
+} LoteDistribuido;
+
+// Conexão com um trabalhador
+typedef struct {
+   int canal;                   // -1 = fechada
+   int trabalhador;
+   int saudado;                 // 1 = apresentou a mesma varredura
+   int lote;                    // Lote em execução (-1 = livre)
+} ConexaoDistribuida;
+
+// Cria um processo trabalhador no próprio nó, que se conecta ao coordenador pela interface local
+static pid_t criarTrabalhadorLocal(const ConfiguracaoDistribuida *config, int porta, PlanoExpandido *plano, uint64_t impressao,
+                                   const TrabalhoDistribuido *trabalho) {
+    fflush(stdout);
+    pid_t filho = fork();
+    if (filho < 0) {
+        printf("Erro ao criar o processo trabalhador\n");
+        exit(1);
+    }
+    if (filho == 0) {
+        // o filho não fica com a escuta nem com as conexões dos outros trabalhadores
+        long maximo = sysconf(_SC_OPEN_MAX);
+        for (int canal = 3; canal < (maximo > 0 && maximo < 4096 ? maximo : 4096); canal++) {
+            close(canal);
+        }
+        ConfiguracaoDistribuida local = *config;
+        unsigned long long semente;
+        int trabalhador;
+        local.porta = porta;
+        if (strcmp(local.endereco, "0.0.0.0") == 0 || strcmp(local.endereco, "::") == 0) {
+            strcpy(local.endereco, "127.0.0.1");
+        }
+        int canal = conectarAoCoordenador(&local, &semente, &trabalhador);
+        servirCoordenador(canal, trabalhador, plano, impressao, trabalho);
+        fflush(stdout);
+        _exit(0);
+    }
+    return filho;
+}
+
+// Devolve o lote de uma conexão que caiu para a fila; aborta se ele já falhou vezes demais
+static void derrubarConexao(ConexaoDistribuida *conexao, LoteDistribuido *lotes, int tentativas, EstatisticaDistribuida *estatistica) {
+    close(conexao->canal);
+    conexao->canal = -1;
+    if (conexao->lote < 0) {
+        return;
+    }
+    LoteDistribuido *lote = &lotes[conexao->lote];
+    lote->copias--;
+    if (lote->estado != LOTE_CONCLUIDO) {
+        lote->falhas++;
+        estatistica->falhas++;
+        printf("Trabalhador %d caiu; o lote %d volta para a fila\n", conexao->trabalhador, conexao->lote);
+        if (lote->falhas > tentativas) {
+            printf("O lote %d (execucoes %d a %d) falhou %d vezes; varredura abortada\n", conexao->lote, lote->primeira, lote->fim - 1, lote->falhas);
+            exit(1);
+        }
+        if (lote->copias == 0) {
+            lote->estado = LOTE_PENDENTE;
+        }
+    }
+}
+
+// Lê o que chegou de um trabalhador; 0 = a conexão deve ser fechada
+static int atenderConexao(ConexaoDistribuida *conexao, LoteDistribuido *lotes, int *concluidos, int total, uint64_t impressao,
+                          Estatistica *rascunho, EstatisticaDistribuida *estatistica) {
+    if (!conexao->saudado) {
+        Saudacao saudacao;
+        if (!transferirTudo(conexao->canal, &saudacao, sizeof(saudacao), 0)) {
+            return 0;
+        }
+        if (memcmp(saudacao.magica, MAGICA_DISTRIBUIDA, 8) != 0 || saudacao.versao != VERSAO_DISTRIBUIDA ||
+            saudacao.total != total || saudacao.impressao != impressao) {
+            MensagemLote encerrar = {MENSAGEM_ENCERRAR, -1, 0, 0};
+            printf("Trabalhador %d recusado: plano ou parametros diferentes dos do coordenador\n", conexao->trabalhador);
+            transferirTudo(conexao->canal, &encerrar, sizeof(encerrar), 1);
+            estatistica->recusados++;
+            return 0;
+        }
+        conexao->saudado = 1;
+        estatistica->trabalhadores++;
+        return 1;
+    }
+
+    ResultadoLote resultado;
+    if (conexao->lote < 0 || !transferirTudo(conexao->canal, &resultado, sizeof(resultado), 0)) {
+        return 0;
+    }
+    LoteDistribuido *lote = &lotes[conexao->lote];
+    if (resultado.lote != conexao->lote || resultado.primeiraCelula != lote->primeiraCelula || resultado.numCelulas != lote->numCelulas ||
+        !transferirTudo(conexao->canal, rascunho, (size_t)lote->numCelulas * sizeof(Estatistica), 0)) {
+        printf("Resultado invalido do trabalhador %d\n", conexao->trabalhador);
+        return 0;
+    }
+    // com reenvio por prazo o mesmo lote pode voltar duas vezes: vale o primeiro
+    lote->copias--;
+    if (lote->estado != LOTE_CONCLUIDO) {
+        memcpy(lote->parciais, rascunho, (size_t)lote->numCelulas * sizeof(Estatistica));
+        lote->estado = LOTE_CONCLUIDO;
+        estatistica->avaliacoes += resultado.avaliacoes;
+        (*concluidos)++;
+    }
+    conexao->lote = -1;
+    return 1;
+}
+
+void coordenarVarredura(const ConfiguracaoDistribuida *config, PlanoExpandido *plano, uint64_t impressao,
+                        unsigned long long semente, const TrabalhoDistribuido *trabalho, EstatisticaDistribuida *estatistica) {
+    int total = plano->numTarefas;
+    int esperados = config->processosLocais > 0 ? config->processosLocais : 4;
+    int tamanhoLote = config->tamanhoLote > 0 ? config->tamanhoLote : total / (4 * esperados);
+    tamanhoLote = tamanhoLote > 0 ? tamanhoLote : 1;
+    int numLotes = total > 0 ? (total + tamanhoLote - 1) / tamanhoLote : 0;
+
+    memset(estatistica, 0, sizeof(*estatistica));
+    estatistica->lotes = numLotes;
+    signal(SIGPIPE, SIG_IGN);
+
+    // lotes de execuções consecutivas; cada um guarda as parciais das células que toca
+    LoteDistribuido *lotes = (LoteDistribuido *)calloc(numLotes > 0 ? numLotes : 1, sizeof(LoteDistribuido));
+    Estatistica *parciais = (Estatistica *)calloc((size_t)numLotes + plano->numCelulas, sizeof(Estatistica));
+    Estatistica *rascunho = (Estatistica *)calloc(plano->numCelulas > 0 ? plano->numCelulas : 1, sizeof(Estatistica));
+    if (lotes == NULL || parciais == NULL || rascunho == NULL) {
+        printf("Erro ao alocar os lotes da varredura distribuida\n");
+        exit(1);
+    }
+    size_t usadas = 0;
+    for (int l = 0; l < numLotes; l++) {
+        LoteDistribuido *lote = &lotes[l];
+        lote->primeira = l * tamanhoLote;
+        lote->fim = lote->primeira + tamanhoLote < total ? lote->primeira + tamanhoLote : total;
+        lote->primeiraCelula = plano->tarefas[lote->primeira].celula;
+        lote->numCelulas = plano->tarefas[lote->fim - 1].celula - lote->primeiraCelula + 1;
+        lote->estado = LOTE_PENDENTE;
+        lote->parciais = &parciais[usadas];
+        usadas += lote->numCelulas;
+    }
+
+    int porta = config->porta;
+    int escuta = abrirEscuta(config->endereco, &porta);
+    printf("Coordenador em %s:%d: %d execucoes em %d lotes de ate %d\n", config->endereco, porta, total, numLotes, tamanhoLote);
+
+    int capacidade = 16, numConexoes = 0, proximoId = 0, concluidos = 0;
+    ConexaoDistribuida *conexoes = (ConexaoDistribuida *)malloc(capacidade * sizeof(ConexaoDistribuida));
+    struct pollfd *eventos = (struct pollfd *)malloc((capacidade + 1) * sizeof(struct pollfd));
+    if (conexoes == NULL || eventos == NULL) {
+        printf("Erro ao alocar as conexoes\n");
+        exit(1);
+    }
+
+    // os processos locais são refeitos quando morrem, até tentativas vezes cada um
+    int vivos = 0, refeitos = 0;
+    for (; vivos < config->processosLocais; vivos++) {
+        criarTrabalhadorLocal(config, porta, plano, impressao, trabalho);
+    }
+
+    double inicio = tempoAtual();
+    int primeiroPendente = 0;
+    while (concluidos < numLotes) {
+        double agora = tempoAtual();
+
+        // prazo: o lote atrasado volta para a fila sem tirar o trabalhador que está com ele
+        if (config->prazoLote > 0) {
+            for (int l = primeiroPendente; l < numLotes; l++) {
+                if (lotes[l].estado == LOTE_EM_ANDAMENTO && agora - lotes[l].envio > config->prazoLote) {
+                    lotes[l].estado = LOTE_PENDENTE;
+                    estatistica->reenvios++;
+                }
+            }
+        }
+        // entrega: cada trabalhador livre recebe o próximo lote pendente
+        for (int k = 0; k < numConexoes; k++) {
+            ConexaoDistribuida *conexao = &conexoes[k];
+            if (conexao->canal < 0 || !conexao->saudado || conexao->lote >= 0) {
+                continue;
+            }
+            while (primeiroPendente < numLotes && lotes[primeiroPendente].estado == LOTE_CONCLUIDO) {
+                primeiroPendente++;
+            }
+            int l = primeiroPendente;
+            while (l < numLotes && lotes[l].estado != LOTE_PENDENTE) {
+                l++;
+            }
+            if (l == numLotes) {
+                break;
+            }
+            MensagemLote mensagem = {MENSAGEM_LOTE, l, lotes[l].primeira, lotes[l].fim};
+            conexao->lote = l;
+            lotes[l].estado = LOTE_EM_ANDAMENTO;
+            lotes[l].copias++;
+            lotes[l].envio = agora;
+            if (!transferirTudo(conexao->canal, &mensagem, sizeof(mensagem), 1)) {
+                derrubarConexao(conexao, lotes, config->tentativas, estatistica);
+            }
+        }
+
+        eventos[0].fd = escuta;
+        eventos[0].events = POLLIN;
+        for (int k = 0; k < numConexoes; k++) {
+            eventos[k + 1].fd = conexoes[k].canal;
+            eventos[k + 1].events = POLLIN;
+            eventos[k + 1].revents = 0;
+        }
+        if (poll(eventos, numConexoes + 1, 100) > 0) {
+            for (int k = 0; k < numConexoes; k++) {
+                if (conexoes[k].canal >= 0 && (eventos[k + 1].revents & (POLLIN | POLLHUP | POLLERR)) &&
+                    !atenderConexao(&conexoes[k], lotes, &concluidos, total, impressao, rascunho, estatistica)) {
+                    derrubarConexao(&conexoes[k], lotes, config->tentativas, estatistica);
+                }
+            }
+            if (eventos[0].revents & POLLIN) {
+                int canal = accept(escuta, NULL, NULL);
+                if (canal >= 0) {
+                    BoasVindas boasVindas;
+                    memcpy(boasVindas.magica, MAGICA_DISTRIBUIDA, 8);
+                    boasVindas.versao = VERSAO_DISTRIBUIDA;
+                    boasVindas.trabalhador = proximoId;
+                    boasVindas.semente = semente;
+                    semAtraso(canal);
+                    if (!transferirTudo(canal, &boasVindas, sizeof(boasVindas), 1)) {
+                        close(canal);
+                    } else {
+                        if (numConexoes == capacidade) {
+                            capacidade *= 2;
+                            conexoes = (ConexaoDistribuida *)realloc(conexoes, capacidade * sizeof(ConexaoDistribuida));
+                            eventos = (struct pollfd *)realloc(eventos, (capacidade + 1) * sizeof(struct pollfd));
+                            if (conexoes == NULL || eventos == NULL) {
+                                printf("Erro ao alocar as conexoes\n");
+                                exit(1);
+                            }
+                        }
+                        conexoes[numConexoes].canal = canal;
+                        conexoes[numConexoes].trabalhador = proximoId++;
+                        conexoes[numConexoes].saudado = 0;
+                        conexoes[numConexoes].lote = -1;
+                        numConexoes++;
+                    }
+                }
+            }
+        }
+        // tira as conexões fechadas da lista
+        int abertas = 0;
+        for (int k = 0; k < numConexoes; k++) {
+            if (conexoes[k].canal >= 0) {
+                conexoes[abertas++] = conexoes[k];
+            }
+        }
+        numConexoes = abertas;
+
+        // refaz os processos locais que morreram enquanto houver lotes
+        pid_t morto;
+        while ((morto = waitpid(-1, NULL, WNOHANG)) > 0) {
+            vivos--;
+        }
+        while (vivos < config->processosLocais && concluidos < numLotes && refeitos < config->processosLocais * config->tentativas) {
+            criarTrabalhadorLocal(config, porta, plano, impressao, trabalho);
+            vivos++;
+            refeitos++;
+        }
+    }
+    estatistica->tempo = tempoAtual() - inicio;
+
+    // fim: quem ainda está ligado (inclusive quem roda a cópia atrasada de um lote) recebe o encerramento
+    for (int k = 0; k < numConexoes; k++) {
+        MensagemLote encerrar = {MENSAGEM_ENCERRAR, -1, 0, 0};
+        transferirTudo(conexoes[k].canal, &encerrar, sizeof(encerrar), 1);
+        close(conexoes[k].canal);
+    }
+    close(escuta);
+    while (vivos > 0 && waitpid(-1, NULL, 0) > 0) {
+        vivos--;
+    }
+
+    // a junção segue a ordem dos lotes: o resumo não depende de quem executou cada lote nem quando
+    for (int l = 0; l < numLotes; l++) {
+        for (int c = 0; c < lotes[l].numCelulas; c++) {
+            combinarEstatistica(&plano->celulas[lotes[l].primeiraCelula + c].estatistica, &lotes[l].parciais[c]);
+        }
+    }
+    free(conexoes);
+    free(eventos);
+    free(rascunho);
+    free(parciais);
+    free(lotes);
+}
+
+#else
+
+int conectarAoCoordenador(const ConfiguracaoDistribuida *config, unsigned long long *semente, int *trabalhador) {
+    (void)config;
+    (void)semente;
+    (void)trabalhador;
+    printf("A varredura distribuida usa sockets POSIX e nao esta disponivel no Windows\n");
+    exit(1);
+}
+
+void servirCoordenador(int canal, int trabalhador, PlanoExpandido *plano, uint64_t impressao, const TrabalhoDistribuido *trabalho) {
+    (void)canal;
+    (void)trabalhador;
+    (void)plano;
+    (void)impressao;
+    (void)trabalho;
+}
+
+void coordenarVarredura(const ConfiguracaoDistribuida *config, PlanoExpandido *plano, uint64_t impressao,
+                        unsigned long long semente, const TrabalhoDistribuido *trabalho, EstatisticaDistribuida *estatistica) {
+    (void)config;
+    (void)plano;
+    (void)impressao;
+    (void)semente;
+    (void)trabalho;
+    (void)estatistica;
+    printf("A varredura distribuida usa sockets POSIX e nao esta disponivel no Windows\n");
+    exit(1);
+}
+
+#endif
@@ -0,0 +1,74 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef DISTRIBUIDO_H
+#define DISTRIBUIDO_H
+#include <stdint.h>
+#include "plano.h"
+
+#define MAGICA_DISTRIBUIDA "PSODIS01"
+#define VERSAO_DISTRIBUIDA 1
+
+// Porta padrão do coordenador e vezes que um lote pode falhar antes de a varredura ser abortada
+#define PORTA_DISTRIBUIDA_PADRAO 5151
+#define TENTATIVAS_DISTRIBUIDAS 3
+
+// Como o coordenador reparte a varredura
+typedef struct {
+   char endereco[256];          // Interface de escuta do coordenador (ou endereço dele, no trabalhador)
+   int porta;                   // 0 no coordenador = porta livre escolhida pelo sistema
+   int processosLocais;         // Trabalhadores que o coordenador cria no próprio nó (refeitos se morrerem)
+   int tamanhoLote;             // Execuções por lote (0 = automático)
+   double prazoLote;            // Segundos até um lote em andamento ser reenviado a outro trabalhador (0 = sem prazo)
+   int tentativas;              // Falhas aceitas por lote
+} ConfiguracaoDistribuida;
+
+// O que um nó trabalhador faz com os lotes que recebe. executar roda as execuções [primeira, fim)
+// do plano, deixa os resultados delas na estatística das células e devolve as avaliações feitas.
+typedef struct {
+   void (*abrir)(int trabalhador, void *contexto);
+   long long (*executar)(int primeira, int fim, void *contexto);
+   void (*fechar)(void *contexto);
+   void *contexto;
+} TrabalhoDistribuido;
+
+// Vazão e falhas vistas pelo coordenador
+typedef struct {
+   int lotes;                   // Lotes da varredura
+   int trabalhadores;           // Trabalhadores aceitos (incluindo os refeitos)
+   int recusados;               // Trabalhadores com outra varredura (impressão diferente)
+   int falhas;                  // Lotes perdidos com a queda de um trabalhador
+   int reenvios;                // Lotes reenviados por estourarem o prazo
+   long long avaliacoes;        // Avaliações somadas de todos os nós
+   double tempo;                // Segundos do primeiro envio ao último resultado
+} EstatisticaDistribuida;
+
+
+// Configuração padrão: escuta em 127.0.0.1:PORTA_DISTRIBUIDA_PADRAO, sem processos locais, lote automático, sem prazo
+ConfiguracaoDistribuida configuracaoDistribuidaPadrao(void);
+
+
+// Lê "porta" ou "endereco:porta" para a configuração; retorna 0 se a porta for inválida
+int lerEnderecoDistribuido(ConfiguracaoDistribuida *config, const char *texto);
+
+
+// Coordena a varredura do plano: entrega lotes de execuções consecutivas aos trabalhadores que se
+// conectarem (e aos processosLocais, que ele mesmo cria com o trabalho dado), reenvia os lotes de
+// quem cair ou estourar o prazo e junta, na ordem dos lotes, as estatísticas de cada célula que
+// os trabalhadores devolvem: os resultados brutos ficam nos nós. Só retorna com todos os lotes
+// concluídos; encerra o programa se um lote falhar mais que config->tentativas vezes.
+void coordenarVarredura(const ConfiguracaoDistribuida *config, PlanoExpandido *plano, uint64_t impressao,
+                        unsigned long long semente, const TrabalhoDistribuido *trabalho, EstatisticaDistribuida *estatistica);
+
+
+// Conecta o trabalhador ao coordenador e recebe a semente da varredura (o plano é expandido com ela).
+// Devolve o canal da conexão; encerra o programa se não conseguir.
+int conectarAoCoordenador(const ConfiguracaoDistribuida *config, unsigned long long *semente, int *trabalhador);
+
+
+// Apresenta o plano ao coordenador e executa os lotes que ele mandar até o fim da varredura
+void servirCoordenador(int canal, int trabalhador, PlanoExpandido *plano, uint64_t impressao, const TrabalhoDistribuido *trabalho);
+
+
+// Imprime lotes, trabalhadores, falhas, reenvios e a vazão da varredura distribuída
+void relatarEstatisticaDistribuida(const EstatisticaDistribuida *estatistica);
+
+#endif
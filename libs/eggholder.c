@@ -0,0 +1,208 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <math.h>
+#include <pthread.h>
+#include <string.h>
+#include "eggholder.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define EGGHOLDER_X86 1
+#include <immintrin.h>
+#endif
+
+// Redução de faixa em duas partes (Cody-Waite): pi = PI_A + PI_B
+#define INV_PI 0.31830988618379067154
+#define PI_A 3.14159265358979311600
+#define PI_B 1.22464679914735320717e-16
+
+// Coeficientes de Taylor do seno (1/(2n+1)! com sinal), suficientes para |r| <= pi/2
+#define S3  -1.66666666666666666667e-01
+#define S5   8.33333333333333333333e-03
+#define S7  -1.98412698412698412698e-04
+#define S9   2.75573192239858906526e-06
+#define S11 -2.50521083854417187751e-08
+#define S13  1.60590438368216145994e-10
+#define S15 -7.64716373181981647590e-13
+#define S17  2.81145725434552076320e-15
+#define S19 -8.22063524662432971696e-18
+
+// ========== Implementação escalar ===========
+
+static inline double polinomioSeno(double r) {
+    double z = r * r;
+    double p = S19;
+    p = p * z + S17;
+    p = p * z + S15;
+    p = p * z + S13;
+    p = p * z + S11;
+    p = p * z + S9;
+    p = p * z + S7;
+    p = p * z + S5;
+    p = p * z + S3;
+    return r + r * z * p;
+}
+
+double senoRapido(double x) {
+    double k = nearbyint(x * INV_PI);
+    double r = (x - k * PI_A) - k * PI_B;
+    double s = polinomioSeno(r);
+    // sin(k*pi + r) = (-1)^k sin(r)
+    return ((long long)k & 1) ? -s : s;
+}
+
+double eggholderRapido(double x, double y) {
+    double a = fabs((x / 2) + y + 47);
+    double b = fabs(x - (y + 47));
+    return -(y + 47) * senoRapido(sqrt(a)) - x * senoRapido(sqrt(b));
+}
+
+static void eggholderLoteEscalar(const double *x, const double *y, double *saida, int n) {
+    for (int i = 0; i < n; i++) {
+        saida[i] = eggholderRapido(x[i], y[i]);
+    }
+}
+
+#ifdef EGGHOLDER_X86
+// ========== Implementação AVX2 (4 lanes) ===========
+
+__attribute__((target("avx2,fma")))
+static inline __m256d senoAVX2(__m256d x) {
+    __m256d k = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(INV_PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(PI_A), x);
+    r = _mm256_fnmadd_pd(k, _mm256_set1_pd(PI_B), r);
+
+    __m256d z = _mm256_mul_pd(r, r);
+    __m256d p = _mm256_set1_pd(S19);
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(S17));
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(S15));
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(S13));
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(S11));
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(S9));
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(S7));
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(S5));
+    p = _mm256_fmadd_pd(p, z, _mm256_set1_pd(S3));
+    __m256d s = _mm256_fmadd_pd(_mm256_mul_pd(r, z), p, r);
+
+    // paridade de k: k - 2*floor(k/2) vale 0 ou 1; sinal = 1 - 2*paridade
+    __m256d metade = _mm256_floor_pd(_mm256_mul_pd(k, _mm256_set1_pd(0.5)));
+    __m256d paridade = _mm256_fnmadd_pd(metade, _mm256_set1_pd(2.0), k);
+    __m256d sinal = _mm256_fnmadd_pd(paridade, _mm256_set1_pd(2.0), _mm256_set1_pd(1.0));
+    return _mm256_mul_pd(s, sinal);
+}
+
+__attribute__((target("avx2,fma")))
+static void eggholderLoteAVX2(const double *x, const double *y, double *saida, int n) {
+    const __m256d semSinal = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+    const __m256d c47 = _mm256_set1_pd(47.0);
+    const __m256d meio = _mm256_set1_pd(0.5);
+    int i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m256d vx = _mm256_loadu_pd(x + i);
+        __m256d vy = _mm256_add_pd(_mm256_loadu_pd(y + i), c47);
+        __m256d a = _mm256_and_pd(_mm256_fmadd_pd(vx, meio, vy), semSinal);
+        __m256d b = _mm256_and_pd(_mm256_sub_pd(vx, vy), semSinal);
+        __m256d sa = senoAVX2(_mm256_sqrt_pd(a));
+        __m256d sb = senoAVX2(_mm256_sqrt_pd(b));
+        // -(y + 47) * sa - x * sb
+        __m256d f = _mm256_fnmsub_pd(vy, sa, _mm256_mul_pd(vx, sb));
+        _mm256_storeu_pd(saida + i, f);
+    }
+    eggholderLoteEscalar(x + i, y + i, saida + i, n - i);
+}
+
+// ========== Implementação AVX-512 (8 lanes) ===========
+
+__attribute__((target("avx512f")))
+static inline __m512d senoAVX512(__m512d x) {
+    __m512d k = _mm512_roundscale_pd(_mm512_mul_pd(x, _mm512_set1_pd(INV_PI)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512d r = _mm512_fnmadd_pd(k, _mm512_set1_pd(PI_A), x);
+    r = _mm512_fnmadd_pd(k, _mm512_set1_pd(PI_B), r);
+
+    __m512d z = _mm512_mul_pd(r, r);
+    __m512d p = _mm512_set1_pd(S19);
+    p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(S17));
+    p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(S15));
+    p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(S13));
+    p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(S11));
+    p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(S9));
+    p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(S7));
+    p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(S5));
+    p = _mm512_fmadd_pd(p, z, _mm512_set1_pd(S3));
+    __m512d s = _mm512_fmadd_pd(_mm512_mul_pd(r, z), p, r);
+
+    __m512d metade = _mm512_roundscale_pd(_mm512_mul_pd(k, _mm512_set1_pd(0.5)), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    __m512d paridade = _mm512_fnmadd_pd(metade, _mm512_set1_pd(2.0), k);
+    __m512d sinal = _mm512_fnmadd_pd(paridade, _mm512_set1_pd(2.0), _mm512_set1_pd(1.0));
+    return _mm512_mul_pd(s, sinal);
+}
+
+__attribute__((target("avx512f")))
+static void eggholderLoteAVX512(const double *x, const double *y, double *saida, int n) {
+    const __m512d c47 = _mm512_set1_pd(47.0);
+    const __m512d meio = _mm512_set1_pd(0.5);
+    int i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m512d vx = _mm512_loadu_pd(x + i);
+        __m512d vy = _mm512_add_pd(_mm512_loadu_pd(y + i), c47);
+        __m512d a = _mm512_abs_pd(_mm512_fmadd_pd(vx, meio, vy));
+        __m512d b = _mm512_abs_pd(_mm512_sub_pd(vx, vy));
+        __m512d sa = senoAVX512(_mm512_sqrt_pd(a));
+        __m512d sb = senoAVX512(_mm512_sqrt_pd(b));
+        __m512d f = _mm512_fnmsub_pd(vy, sa, _mm512_mul_pd(vx, sb));
+        _mm512_storeu_pd(saida + i, f);
+    }
+    eggholderLoteEscalar(x + i, y + i, saida + i, n - i);
+}
+#endif
+
+// ========== Seleção em tempo de execução ===========
+
+int listarImplementacoesEggholder(ImplementacaoEggholder lista[], int max) {
+    int total = 0;
+
+    if (total < max) {
+        lista[total++] = (ImplementacaoEggholder){"escalar", eggholderLoteEscalar, 1};
+    }
+#ifdef EGGHOLDER_X86
+    __builtin_cpu_init();
+    if (total < max) {
+        int avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        lista[total++] = (ImplementacaoEggholder){"avx2", eggholderLoteAVX2, avx2};
+    }
+    if (total < max) {
+        lista[total++] = (ImplementacaoEggholder){"avx512", eggholderLoteAVX512, __builtin_cpu_supports("avx512f")};
+    }
+#endif
+    return total;
+}
+
+static KernelEggholder kernelSelecionado = NULL;
+static const char *nomeSelecionado = "escalar";
+static pthread_once_t kernelEscolhido = PTHREAD_ONCE_INIT;
+
+// Escolhe a última implementação disponível da lista (a mais larga); roda uma vez só, mesmo
+// com os trabalhadores chamando a primeira avaliação ao mesmo tempo
+static void selecionarKernel(void) {
+    ImplementacaoEggholder lista[4];
+    int total = listarImplementacoesEggholder(lista, 4);
+    KernelEggholder escolhido = eggholderLoteEscalar;
+
+    for (int i = 0; i < total; i++) {
+        if (lista[i].disponivel) {
+            escolhido = lista[i].kernel;
+            nomeSelecionado = lista[i].nome;
+        }
+    }
+    kernelSelecionado = escolhido;
+}
+
+void eggholderLote(const double *x, const double *y, double *saida, int n) {
+    pthread_once(&kernelEscolhido, selecionarKernel);
+    kernelSelecionado(x, y, saida, n);
+}
+
+const char *implementacaoEggholder(void) {
+    pthread_once(&kernelEscolhido, selecionarKernel);
+    return nomeSelecionado;
+}
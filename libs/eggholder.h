@@ -0,0 +1,35 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef EGGHOLDER_H
+#define EGGHOLDER_H
+
+// Kernel de avaliação em lote: saida[i] = eggholder(x[i], y[i])
+typedef void (*KernelEggholder)(const double *x, const double *y, double *saida, int n);
+
+// Descreve uma implementação do kernel (escalar, AVX2, AVX-512)
+typedef struct {
+   const char *nome;       // Nome da implementação
+   KernelEggholder kernel; // Função de avaliação em lote
+   int disponivel;         // 1 se a CPU atual suporta a implementação
+} ImplementacaoEggholder;
+
+
+// Seno com redução de faixa (x = k*pi + r) e polinômio de grau 19 em r
+double senoRapido(double x);
+
+
+// Eggholder escalar com o seno polinomial e a raiz quadrada do hardware
+double eggholderRapido(double x, double y);
+
+
+// Avalia a Eggholder em lote com a melhor implementação suportada pela CPU
+void eggholderLote(const double *x, const double *y, double *saida, int n);
+
+
+// Nome da implementação escolhida em tempo de execução
+const char *implementacaoEggholder(void);
+
+
+// Preenche a lista de implementações compiladas e retorna quantas existem
+int listarImplementacoesEggholder(ImplementacaoEggholder lista[], int max);
+
+#endif
@@ -0,0 +1,54 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "enxame.h"
+
+// Arredonda a quantidade de doubles para um múltiplo da linha de cache
+static size_t arredondarLinha(size_t quantidade) {
+    return (quantidade + DOUBLES_POR_LINHA - 1) / DOUBLES_POR_LINHA * DOUBLES_POR_LINHA;
+}
+
+size_t doublesDoEnxame(int numParticulas, int dimensoes) {
+    size_t stride = arredondarLinha((size_t)numParticulas);
+    return 5 * (size_t)dimensoes * stride + 2 * stride + arredondarLinha((size_t)dimensoes);
+}
+
+void prepararEnxame(Swarm *enxame, int numParticulas, int dimensoes) {
+    size_t stride = arredondarLinha((size_t)numParticulas);
+    size_t bloco = (size_t)dimensoes * stride;
+    size_t total = doublesDoEnxame(numParticulas, dimensoes);
+    size_t bytes = total * sizeof(double) + ALINHAMENTO_ENXAME;
+
+    if (enxame->arena == NULL || enxame->capacidadeArena < bytes) {
+        free(enxame->arena);
+        enxame->arena = malloc(bytes);
+        if (enxame->arena == NULL) {
+            printf("Erro ao alocar o enxame de %d particulas\n", numParticulas);
+            exit(1);
+        }
+        enxame->capacidadeArena = bytes;
+    }
+
+    // Alinha o início da arena na linha de cache
+    uintptr_t endereco = (uintptr_t)enxame->arena;
+    double *base = (double *)((endereco + ALINHAMENTO_ENXAME - 1) & ~(uintptr_t)(ALINHAMENTO_ENXAME - 1));
+
+    enxame->position = base;
+    enxame->velocity = enxame->position + bloco;
+    enxame->bestPosition = enxame->velocity + bloco;
+    enxame->r1 = enxame->bestPosition + bloco;
+    enxame->r2 = enxame->r1 + bloco;
+    enxame->fitness = enxame->r2 + bloco;
+    enxame->bestFitness = enxame->fitness + stride;
+    enxame->globalBestPosition = enxame->bestFitness + stride;
+    enxame->numParticles = numParticulas;
+    enxame->dimensions = dimensoes;
+    enxame->stride = (int)stride;
+}
+
+void liberarEnxame(Swarm *enxame) {
+    free(enxame->arena);
+    enxame->arena = NULL;
+    enxame->capacidadeArena = 0;
+}
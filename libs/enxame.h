@@ -0,0 +1,52 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef ENXAME_H
+#define ENXAME_H
+#include <stddef.h>
+#include "aleatorio.h"
+#include "objetivos.h"
+
+// Alinhamento da arena (uma linha de cache)
+#define ALINHAMENTO_ENXAME 64
+#define DOUBLES_POR_LINHA ((int)(ALINHAMENTO_ENXAME / sizeof(double)))
+
+// Estrutura para representar o enxame (estrutura de arrays)
+// Todos os vetores ficam numa única arena alinhada, em ordem dimensão-major:
+// a coordenada d da partícula i fica em position[d * stride + i].
+typedef struct {
+   void *arena;                // Bloco alocado (único malloc por enxame)
+   size_t capacidadeArena;     // Tamanho da arena em bytes
+   double *position;           // Posições [dimensions][stride]
+   double *velocity;           // Velocidades [dimensions][stride]
+   double *bestPosition;       // Melhores posições individuais [dimensions][stride]
+   double *r1;                 // Números aleatórios da componente cognitiva [dimensions][stride]
+   double *r2;                 // Números aleatórios da componente social [dimensions][stride]
+   double *fitness;            // Aptidão atual de cada partícula [stride]
+   double *bestFitness;        // Melhor aptidão individual [stride]
+   double *globalBestPosition; // Melhor posição global [dimensions]
+   double globalBestFitness;   // Melhor aptidão global
+   int numParticles;           // Número de partículas
+   int dimensions;             // Dimensão do espaço (2D no caso)
+   int stride;                 // numParticles arredondado para múltiplo da linha de cache
+   GeradorAleatorio gerador;   // Fluxo aleatório próprio do enxame
+   Objetivo objetivo;          // Função objetivo (Eggholder 2D se não for definida)
+   long long avaliacoes;       // Avaliações da função objetivo desde a inicialização
+} Swarm;
+
+// Acessa a coordenada d da partícula i em um dos vetores dimensão-major do enxame
+#define COORD(enxame, vetor, d, i) ((enxame)->vetor[(size_t)(d) * (enxame)->stride + (i)])
+
+
+// Distribui os vetores do enxame na arena, realocando apenas se ela não couber
+// O enxame deve começar zerado (Swarm enxame = {0};)
+void prepararEnxame(Swarm *enxame, int numParticulas, int dimensoes);
+
+
+// Doubles do estado do enxame na arena, a partir de position (todos os vetores e o gBest).
+// Copiar esse trecho e o gerador basta para continuar a execução de onde ela estava.
+size_t doublesDoEnxame(int numParticulas, int dimensoes);
+
+
+// Libera a arena do enxame (um único free)
+void liberarEnxame(Swarm *enxame);
+
+#endif
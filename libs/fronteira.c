@@ -0,0 +1,22 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <string.h>
+#include "fronteira.h"
+
+const char *nomeFronteira(PoliticaFronteira politica) {
+    static const char *NOMES[] = {"absorver", "refletir", "reiniciar", "periodica"};
+    return NOMES[politica];
+}
+
+int fronteiraPorNome(const char *nome, PoliticaFronteira *politica) {
+    for (int k = FRONTEIRA_ABSORVER; k <= FRONTEIRA_PERIODICA; k++) {
+        if (strcmp(nome, nomeFronteira((PoliticaFronteira)k)) == 0) {
+            *politica = (PoliticaFronteira)k;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+const char *nomesFronteiras(void) {
+    return "absorver, refletir, reiniciar, periodica";
+}
@@ -0,0 +1,85 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef FRONTEIRA_H
+#define FRONTEIRA_H
+#include <math.h>
+
+// O que acontece com a coordenada que sai do espaço de busca
+typedef enum {
+   FRONTEIRA_ABSORVER,  // Fica na borda com velocidade zero (comportamento original)
+   FRONTEIRA_REFLETIR,  // Volta espelhada na borda e a velocidade troca de sinal
+   FRONTEIRA_REINICIAR, // Sorteada de novo no domínio, com velocidade zero
+   FRONTEIRA_PERIODICA  // Reaparece do outro lado (domínio circular), velocidade mantida
+} PoliticaFronteira;
+
+// Limites de um passo de movimento
+typedef struct {
+   PoliticaFronteira politica;
+   double posMin;
+   double posMax;
+   double limiteVelocidade; // |v| máximo por coordenada (INFINITY = sem limite)
+} Fronteira;
+
+
+// Move n coordenadas de uma linha: limita a velocidade, soma na posição e aplica a política.
+// Só min, max e seleções no laço (nenhum desvio por partícula), então ele vetoriza; a escolha
+// da política fica fora do laço. sorteio traz uniformes em [0, 1) e só é lido por REINICIAR.
+static inline void moverLinha(const Fronteira *fronteira, double *restrict posicao, double *restrict velocidade,
+                              const double *restrict sorteio, int n) {
+    const double lo = fronteira->posMin, hi = fronteira->posMax, limite = fronteira->limiteVelocidade;
+    const double largura = hi - lo;
+
+    switch (fronteira->politica) {
+        case FRONTEIRA_ABSORVER:
+            for (int i = 0; i < n; i++) {
+                double v = velocidade[i] < -limite ? -limite : velocidade[i];
+                v = v > limite ? limite : v;
+                double livre = posicao[i] + v;
+                double x = livre < lo ? lo : livre;
+                x = x > hi ? hi : x;
+                velocidade[i] = x == livre ? v : 0.0;
+                posicao[i] = x;
+            }
+            break;
+        case FRONTEIRA_REFLETIR:
+            for (int i = 0; i < n; i++) {
+                double v = velocidade[i] < -limite ? -limite : velocidade[i];
+                v = v > limite ? limite : v;
+                double livre = posicao[i] + v;
+                double x = livre < lo ? 2.0 * lo - livre : livre;
+                x = x > hi ? 2.0 * hi - x : x;
+                // um passo maior que o domínio ainda passaria da outra borda
+                x = x < lo ? lo : x;
+                velocidade[i] = livre < lo || livre > hi ? -v : v;
+                posicao[i] = x;
+            }
+            break;
+        case FRONTEIRA_REINICIAR:
+            for (int i = 0; i < n; i++) {
+                double v = velocidade[i] < -limite ? -limite : velocidade[i];
+                v = v > limite ? limite : v;
+                double livre = posicao[i] + v;
+                int fora = livre < lo || livre > hi;
+                velocidade[i] = fora ? 0.0 : v;
+                posicao[i] = fora ? lo + largura * sorteio[i] : livre;
+            }
+            break;
+        case FRONTEIRA_PERIODICA:
+            for (int i = 0; i < n; i++) {
+                double v = velocidade[i] < -limite ? -limite : velocidade[i];
+                v = v > limite ? limite : v;
+                double livre = posicao[i] + v;
+                velocidade[i] = v;
+                posicao[i] = livre - largura * floor((livre - lo) / largura);
+            }
+            break;
+    }
+}
+
+
+// Nome e conversão a partir do nome (absorver, refletir, reiniciar, periodica);
+// a conversão retorna 0 se o nome não existir
+const char *nomeFronteira(PoliticaFronteira politica);
+int fronteiraPorNome(const char *nome, PoliticaFronteira *politica);
+const char *nomesFronteiras(void);
+
+#endif
@@ -0,0 +1,235 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ilhas.h"
+#include "aleatorio.h"
+
+void criarIlhas(ModeloIlhas *ilhas, int numIlhas) {
+    memset(ilhas, 0, sizeof(*ilhas));
+    if (numIlhas < 1 || numIlhas > MAX_ILHAS) {
+        printf("Numero de ilhas invalido: %d (de 1 a %d)\n", numIlhas, MAX_ILHAS);
+        exit(1);
+    }
+    ilhas->capacidade = numIlhas;
+    ilhas->enxames = (Swarm *)calloc(numIlhas, sizeof(Swarm));
+    ilhas->resultados = (ResultadoPSO *)calloc(numIlhas, sizeof(ResultadoPSO));
+    ilhas->pontos = (PontoMigracao *)calloc(numIlhas, sizeof(PontoMigracao));
+    ilhas->aneis = (AnelMigracao *)calloc((size_t)numIlhas * numIlhas, sizeof(AnelMigracao));
+    ilhas->encerradas = (int *)calloc(numIlhas, sizeof(int));
+    if (ilhas->enxames == NULL || ilhas->resultados == NULL || ilhas->pontos == NULL || ilhas->aneis == NULL || ilhas->encerradas == NULL) {
+        printf("Erro ao alocar o modelo de ilhas\n");
+        exit(1);
+    }
+    iniciarGrupo(&ilhas->grupo, numIlhas);
+}
+
+// Aloca os rascunhos das mensagens para a dimensão e o número de migrantes da execução
+static void prepararMensagens(ModeloIlhas *ilhas, int migrantes) {
+    size_t tamanho = (size_t)ilhas->doublesPorMensagem;
+
+    if (ilhas->saidas == NULL || ilhas->alocadoMensagens < tamanho) {
+        free(ilhas->saidas);
+        free(ilhas->chegadas);
+        ilhas->saidas = (double *)malloc((size_t)ilhas->capacidade * tamanho * sizeof(double));
+        ilhas->chegadas = (double *)malloc((size_t)ilhas->capacidade * ilhas->capacidade * tamanho * sizeof(double));
+        ilhas->alocadoMensagens = tamanho;
+    }
+    if (ilhas->escolhidos == NULL || ilhas->alocadoMigrantes < migrantes) {
+        free(ilhas->escolhidos);
+        ilhas->escolhidos = (int *)malloc((size_t)ilhas->capacidade * migrantes * sizeof(int));
+        ilhas->alocadoMigrantes = migrantes;
+    }
+    if (ilhas->saidas == NULL || ilhas->chegadas == NULL || ilhas->escolhidos == NULL) {
+        printf("Erro ao alocar as mensagens de migracao\n");
+        exit(1);
+    }
+}
+
+// Escreve na mensagem a aptidão e a posição dos melhores pBest da ilha (os que faltarem, numa
+// ilha com menos partículas que migrantes, vão com aptidão DBL_MAX e são ignorados no destino)
+static void montarEmigrantes(const Swarm *enxame, int migrantes, int *escolhidos, double *mensagem) {
+    int dimensoes = enxame->dimensions;
+
+    for (int j = 0; j < migrantes; j++) {
+        int melhor = -1;
+        for (int i = 0; i < enxame->numParticles; i++) {
+            int repetida = 0;
+            for (int k = 0; k < j && !repetida; k++) {
+                repetida = escolhidos[k] == i;
+            }
+            if (!repetida && (melhor < 0 || enxame->bestFitness[i] < enxame->bestFitness[melhor])) {
+                melhor = i;
+            }
+        }
+        escolhidos[j] = melhor;
+        double *migrante = &mensagem[(size_t)j * (dimensoes + 1)];
+        migrante[0] = melhor >= 0 ? enxame->bestFitness[melhor] : DBL_MAX;
+        for (int d = 0; d < dimensoes; d++) {
+            migrante[d + 1] = melhor >= 0 ? COORD(enxame, bestPosition, d, melhor) : 0.0;
+        }
+    }
+}
+
+// Põe o imigrante no lugar do pior pBest da ilha, se ele for melhor; a velocidade fica a da partícula
+static void acolherImigrante(Swarm *enxame, const double *migrante) {
+    double aptidao = migrante[0];
+    int pior = 0;
+
+    for (int i = 1; i < enxame->numParticles; i++) {
+        if (enxame->bestFitness[i] > enxame->bestFitness[pior]) {
+            pior = i;
+        }
+    }
+    if (!(aptidao < enxame->bestFitness[pior])) {
+        return;
+    }
+    for (int d = 0; d < enxame->dimensions; d++) {
+        COORD(enxame, position, d, pior) = migrante[d + 1];
+        COORD(enxame, bestPosition, d, pior) = migrante[d + 1];
+    }
+    enxame->fitness[pior] = aptidao;
+    enxame->bestFitness[pior] = aptidao;
+    if (aptidao < enxame->globalBestFitness) {
+        enxame->globalBestFitness = aptidao;
+        for (int d = 0; d < enxame->dimensions; d++) {
+            enxame->globalBestPosition[d] = migrante[d + 1];
+        }
+    }
+}
+
+// Migração da ilha (chamada pelo motor entre iterações): envia os melhores a cada destino, espera
+// a mensagem desta migração de cada origem e acolhe os imigrantes na ordem das origens
+static void migrarIlha(PontoMigracao *ponto, Swarm *enxame, int iteracao) {
+    ModeloIlhas *ilhas = (ModeloIlhas *)ponto->contexto;
+    const PoliticaMigracao *politica = &ilhas->parametros->ilhas;
+    int ilha = (int)(ponto - ilhas->pontos);
+    int capacidade = ilhas->capacidade;
+    size_t tamanho = (size_t)ilhas->doublesPorMensagem;
+    long long epoca = iteracao / ponto->intervalo;
+    double *saida = &ilhas->saidas[(size_t)ilha * tamanho];
+    double *chegadas = &ilhas->chegadas[(size_t)ilha * capacidade * tamanho];
+    int vizinhos[MAX_ILHAS];
+    int recebidas = 0;
+
+    montarEmigrantes(enxame, politica->migrantes, &ilhas->escolhidos[(size_t)ilha * politica->migrantes], saida);
+    int numDestinos = destinosDaMigracao(politica, ilha, ilhas->numIlhas, epoca, ilhas->sementeMigracao, vizinhos);
+    for (int k = 0; k < numDestinos; k++) {
+        enviarMensagem(&ilhas->aneis[(size_t)ilha * capacidade + vizinhos[k]], saida, &ilhas->encerradas[vizinhos[k]]);
+    }
+
+    // as mensagens são copiadas antes de acolhidas para devolver logo o espaço do anel à origem
+    int numOrigens = origensDaMigracao(politica, ilha, ilhas->numIlhas, epoca, ilhas->sementeMigracao, vizinhos);
+    for (int k = 0; k < numOrigens; k++) {
+        AnelMigracao *anel = &ilhas->aneis[(size_t)vizinhos[k] * capacidade + ilha];
+        const double *mensagem = esperarMensagem(anel, &ilhas->encerradas[vizinhos[k]]);
+        if (mensagem != NULL) {
+            memcpy(&chegadas[(size_t)recebidas * tamanho], mensagem, tamanho * sizeof(double));
+            liberarMensagem(anel);
+            recebidas++;
+        }
+    }
+    for (int m = 0; m < recebidas; m++) {
+        for (int j = 0; j < politica->migrantes; j++) {
+            acolherImigrante(enxame, &chegadas[(size_t)m * tamanho + (size_t)j * (enxame->dimensions + 1)]);
+        }
+    }
+}
+
+// Tarefa do grupo: executa a ilha inteira com a sua parte da população e do orçamento
+static void executarIlha(int tarefa, int trabalhador, void *contexto) {
+    ModeloIlhas *ilhas = (ModeloIlhas *)contexto;
+    Swarm *enxame = &ilhas->enxames[tarefa];
+    ParametrosPSO parametros = *ilhas->parametros;
+    int populacao = ilhas->populacao / ilhas->numIlhas + (tarefa < ilhas->populacao % ilhas->numIlhas);
+    (void)trabalhador;
+
+    // cada ilha roda inteira na sua thread, sem nada compartilhado com as outras além dos anéis
+    parametros.telemetria = NULL;
+    parametros.instrumentacao = NULL;
+    parametros.grupo = NULL;
+    parametros.salvamento = NULL;
+    parametros.vizinhanca = NULL;
+    parametros.elite = NULL;
+    parametros.migracao = ilhas->numIlhas > 1 && parametros.ilhas.intervalo > 0 ? &ilhas->pontos[tarefa] : NULL;
+    if (parametros.parada.avaliacoesMaximas > 0) {
+        long long parte = parametros.parada.avaliacoesMaximas / ilhas->numIlhas;
+        parametros.parada.avaliacoesMaximas = parte > 0 ? parte : 1;
+    }
+
+    semearGerador(&enxame->gerador, ilhas->tipoGerador, ilhas->semente);
+    for (int k = 0; k < tarefa; k++) {
+        saltarGerador(&enxame->gerador);
+    }
+    enxame->objetivo = parametros.objetivo;
+    inicializarEnxame(enxame, populacao, parametros.dimensoes, parametros.posMin, parametros.posMax, parametros.velMax);
+    executarPSOConfigurado(enxame, &parametros, &ilhas->resultados[tarefa]);
+    __atomic_store_n(&ilhas->encerradas[tarefa], 1, __ATOMIC_RELEASE);
+}
+
+double executarIlhas(ModeloIlhas *ilhas, const ParametrosPSO *parametros, int populacao, TipoGerador tipoGerador,
+                     uint64_t semente, ResultadoPSO *resultado, double *melhorPosicao) {
+    const PoliticaMigracao *politica = &parametros->ilhas;
+    int numIlhas = politica->numIlhas < ilhas->capacidade ? politica->numIlhas : ilhas->capacidade;
+    int melhor = 0;
+
+    ilhas->parametros = parametros;
+    ilhas->numIlhas = numIlhas < populacao ? numIlhas : (populacao > 0 ? populacao : 1);
+    ilhas->populacao = populacao;
+    ilhas->doublesPorMensagem = politica->migrantes * (parametros->dimensoes + 1);
+    ilhas->tipoGerador = tipoGerador;
+    ilhas->semente = semente;
+    ilhas->sementeMigracao = misturar64(semente ^ 0x6d696772616361ULL);
+    prepararMensagens(ilhas, politica->migrantes);
+    for (int origem = 0; origem < ilhas->numIlhas; origem++) {
+        ilhas->encerradas[origem] = 0;
+        ilhas->pontos[origem].intervalo = politica->intervalo;
+        ilhas->pontos[origem].migrar = migrarIlha;
+        ilhas->pontos[origem].contexto = ilhas;
+        for (int destino = 0; destino < ilhas->numIlhas; destino++) {
+            if (destino != origem) {
+                prepararAnel(&ilhas->aneis[(size_t)origem * ilhas->capacidade + destino], ilhas->doublesPorMensagem);
+            }
+        }
+    }
+
+    // as ilhas se esperam nas migrações: o grupo tem uma thread para cada uma
+    executarNoGrupo(&ilhas->grupo, ilhas->numIlhas, executarIlha, ilhas);
+
+    ResultadoPSO total = ilhas->resultados[0];
+    for (int k = 1; k < ilhas->numIlhas; k++) {
+        const ResultadoPSO *parcial = &ilhas->resultados[k];
+        if (parcial->melhor < ilhas->resultados[melhor].melhor) {
+            melhor = k;
+        }
+        total.avaliacoes += parcial->avaliacoes;
+        total.iteracoes = parcial->iteracoes > total.iteracoes ? parcial->iteracoes : total.iteracoes;
+    }
+    total.melhor = ilhas->resultados[melhor].melhor;
+    total.criterio = ilhas->resultados[melhor].criterio;
+    memcpy(melhorPosicao, ilhas->enxames[melhor].globalBestPosition, (size_t)parametros->dimensoes * sizeof(double));
+    if (resultado != NULL) {
+        *resultado = total;
+    }
+    return total.melhor;
+}
+
+void liberarIlhas(ModeloIlhas *ilhas) {
+    encerrarGrupo(&ilhas->grupo);
+    for (int k = 0; k < ilhas->capacidade; k++) {
+        liberarEnxame(&ilhas->enxames[k]);
+    }
+    for (size_t k = 0; k < (size_t)ilhas->capacidade * ilhas->capacidade; k++) {
+        liberarAnel(&ilhas->aneis[k]);
+    }
+    free(ilhas->enxames);
+    free(ilhas->resultados);
+    free(ilhas->pontos);
+    free(ilhas->aneis);
+    free(ilhas->encerradas);
+    free(ilhas->saidas);
+    free(ilhas->chegadas);
+    free(ilhas->escolhidos);
+    memset(ilhas, 0, sizeof(*ilhas));
+}
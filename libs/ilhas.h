@@ -0,0 +1,49 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef ILHAS_H
+#define ILHAS_H
+#include "motor.h"
+#include "migracao.h"
+
+// Subenxames de uma execução, cada um numa thread do grupo com a sua arena, trocando os melhores
+// pBest pelos anéis de migração. Tudo é reaproveitado entre as execuções do trabalhador.
+typedef struct {
+   int capacidade;              // Ilhas com arena e thread
+   Swarm *enxames;              // Arena de cada ilha [capacidade]
+   ResultadoPSO *resultados;    // Resumo de cada ilha na execução [capacidade]
+   PontoMigracao *pontos;       // Ponto de migração de cada ilha [capacidade]
+   AnelMigracao *aneis;         // Anel de cada par [origem * capacidade + destino]
+   int *encerradas;             // 1 = a ilha terminou a execução [capacidade]
+   double *saidas;              // Mensagem montada por cada ilha [capacidade][doublesPorMensagem]
+   double *chegadas;            // Imigrantes recebidos por cada ilha [capacidade][capacidade * doublesPorMensagem]
+   int *escolhidos;             // Emigrantes escolhidos por cada ilha [capacidade][migrantes]
+   size_t alocadoMensagens;     // doublesPorMensagem para o qual saidas e chegadas foram alocados
+   int alocadoMigrantes;        // migrantes para o qual escolhidos foi alocado
+   GrupoTrabalho grupo;         // Uma thread por ilha
+   // execução em andamento
+   const ParametrosPSO *parametros;
+   int numIlhas;                // Ilhas da execução (não mais que a população)
+   int populacao;               // População total, repartida entre as ilhas
+   int doublesPorMensagem;      // migrantes * (1 + dimensoes): aptidão e posição de cada migrante
+   TipoGerador tipoGerador;
+   uint64_t semente;            // Semente da execução (a ilha k usa o fluxo saltado k vezes)
+   uint64_t sementeMigracao;    // Sorteio dos destinos da topologia aleatória
+} ModeloIlhas;
+
+
+// Cria o grupo com uma thread por ilha e as arenas vazias (numIlhas <= MAX_ILHAS)
+void criarIlhas(ModeloIlhas *ilhas, int numIlhas);
+
+
+// Executa o PSO como parametros->ilhas.numIlhas subenxames que dividem a população e o orçamento
+// de avaliações. A ilha 0 usa o fluxo da semente e a ilha k o mesmo fluxo saltado k vezes; cada
+// ilha espera as mensagens das suas origens em cada migração, então o resultado não depende de
+// como as threads se alternam. Devolve o melhor gBest das ilhas (a posição em melhorPosicao) e,
+// em resultado, a soma das avaliações, a maior contagem de iterações e o critério da melhor ilha.
+double executarIlhas(ModeloIlhas *ilhas, const ParametrosPSO *parametros, int populacao, TipoGerador tipoGerador,
+                     uint64_t semente, ResultadoPSO *resultado, double *melhorPosicao);
+
+
+// Encerra as threads e libera as arenas e os anéis
+void liberarIlhas(ModeloIlhas *ilhas);
+
+#endif
@@ -0,0 +1,179 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "instrumentacao.h"
+#include "tempo.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+static const char *NOMES_FASES[NUM_FASES] = {"velocidade", "posicao", "avaliacao", "melhores", "fundida", "parada"};
+static const char *NOMES_CONTADORES[NUM_CONTADORES] = {"ciclos", "instrucoes", "falhas_cache", "falhas_desvio"};
+
+void criarInstrumentacao(Instrumentacao *instrumentacao, int usarContadores) {
+    memset(instrumentacao, 0, sizeof(*instrumentacao));
+    instrumentacao->usarContadores = usarContadores;
+    for (int c = 0; c < NUM_CONTADORES; c++) {
+        instrumentacao->descritores[c] = -1;
+    }
+}
+
+#ifdef __linux__
+// Abre um contador só do espaço de usuário para a thread atual, em qualquer CPU
+static int abrirContador(unsigned long long configuracao) {
+    struct perf_event_attr atributos;
+
+    memset(&atributos, 0, sizeof(atributos));
+    atributos.type = PERF_TYPE_HARDWARE;
+    atributos.size = sizeof(atributos);
+    atributos.config = configuracao;
+    atributos.exclude_kernel = 1;
+    atributos.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &atributos, 0, -1, -1, 0);
+}
+#endif
+
+// Os contadores pertencem à thread que os abre, então são abertos na primeira execução dela
+static void abrirContadores(Instrumentacao *instrumentacao) {
+    instrumentacao->contadoresAbertos = 1;
+#ifdef __linux__
+    const unsigned long long configuracoes[NUM_CONTADORES] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+    };
+    for (int c = 0; c < NUM_CONTADORES; c++) {
+        instrumentacao->descritores[c] = abrirContador(configuracoes[c]);
+    }
+#endif
+}
+
+static void lerContadores(const Instrumentacao *instrumentacao, unsigned long long valores[]) {
+    for (int c = 0; c < NUM_CONTADORES; c++) {
+        valores[c] = 0;
+#ifdef __linux__
+        if (instrumentacao->descritores[c] >= 0 && read(instrumentacao->descritores[c], &valores[c], sizeof(valores[c])) != sizeof(valores[c])) {
+            valores[c] = 0;
+        }
+#endif
+    }
+}
+
+void iniciarExecucaoInstrumentada(Instrumentacao *instrumentacao) {
+    if (!instrumentacao->usarContadores) {
+        return;
+    }
+    if (!instrumentacao->contadoresAbertos) {
+        abrirContadores(instrumentacao);
+    }
+    lerContadores(instrumentacao, instrumentacao->inicioContadores);
+}
+
+void terminarExecucaoInstrumentada(Instrumentacao *instrumentacao) {
+    instrumentacao->execucoes++;
+    if (!instrumentacao->usarContadores) {
+        return;
+    }
+    unsigned long long fim[NUM_CONTADORES];
+    lerContadores(instrumentacao, fim);
+    for (int c = 0; c < NUM_CONTADORES; c++) {
+        instrumentacao->contadores[c] += fim[c] - instrumentacao->inicioContadores[c];
+    }
+}
+
+void somarInstrumentacao(Instrumentacao *total, const Instrumentacao *parcial) {
+    for (int f = 0; f < NUM_FASES; f++) {
+        total->marcas[f] += parcial->marcas[f];
+        total->chamadas[f] += parcial->chamadas[f];
+    }
+    for (int c = 0; c < NUM_CONTADORES; c++) {
+        total->contadores[c] += parcial->contadores[c];
+        // o contador só conta como disponível se abriu em algum trabalhador
+        if (parcial->descritores[c] >= 0) {
+            total->descritores[c] = parcial->descritores[c];
+        }
+    }
+    total->execucoes += parcial->execucoes;
+    total->usarContadores |= parcial->usarContadores;
+}
+
+void liberarInstrumentacao(Instrumentacao *instrumentacao) {
+    for (int c = 0; c < NUM_CONTADORES; c++) {
+#ifdef __linux__
+        if (instrumentacao->descritores[c] >= 0) {
+            close(instrumentacao->descritores[c]);
+        }
+#endif
+        instrumentacao->descritores[c] = -1;
+    }
+}
+
+// Segundos por marca de tempo, medidos contra o relógio monotônico
+static double segundosPorMarca(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    double inicio = tempoAtual(), agora;
+    unsigned long long marcaInicio = marcaTempo();
+    do {
+        agora = tempoAtual();
+    } while (agora - inicio < 0.02);
+    return (agora - inicio) / (double)(marcaTempo() - marcaInicio);
+#else
+    return 1e-9;
+#endif
+}
+
+void relatarInstrumentacao(const Instrumentacao *total, const char *caminhoJSON) {
+    double escala = segundosPorMarca(), soma = 0.0;
+    FILE *arquivo = fopen(caminhoJSON, "w");
+
+    if (arquivo == NULL) {
+        printf("Erro ao abrir o arquivo %s\n", caminhoJSON);
+        exit(1);
+    }
+    for (int f = 0; f < NUM_FASES; f++) {
+        soma += total->marcas[f] * escala;
+    }
+
+    printf("\n\t\t =====| INSTRUMENTACAO (%lld EXECUCOES) |=====\n\n", total->execucoes);
+    printf("%-12s %14s %12s %8s %14s\n", "fase", "chamadas", "tempo_s", "%", "ns/chamada");
+    fprintf(arquivo, "{\n  \"execucoes\": %lld,\n  \"segundos_por_marca\": %.6e,\n  \"fases\": {\n", total->execucoes, escala);
+    for (int f = 0; f < NUM_FASES; f++) {
+        double segundos = total->marcas[f] * escala;
+        double porChamada = total->chamadas[f] > 0 ? segundos / total->chamadas[f] * 1e9 : 0.0;
+        if (total->chamadas[f] > 0) {
+            printf("%-12s %14lld %12.6f %7.2f%% %14.1f\n", NOMES_FASES[f], total->chamadas[f], segundos,
+                   soma > 0 ? 100.0 * segundos / soma : 0.0, porChamada);
+        }
+        fprintf(arquivo, "    \"%s\": {\"chamadas\": %lld, \"segundos\": %.9f, \"ns_por_chamada\": %.3f}%s\n",
+                NOMES_FASES[f], total->chamadas[f], segundos, porChamada, f + 1 < NUM_FASES ? "," : "");
+    }
+    fprintf(arquivo, "  }");
+
+    if (total->usarContadores) {
+        // herdar os contadores não serviria: as threads do grupo vivem a varredura toda e a contagem de
+        // uma thread herdeira só chega ao descritor quando ela termina, não a cada execução
+        printf("\ncontadores da thread que executa o enxame (sem as threads do grupo, das ilhas e dos avaliadores)\n");
+        fprintf(arquivo, ",\n  \"escopo_contadores\": \"thread_chamadora\"");
+        fprintf(arquivo, ",\n  \"contadores\": {\n");
+        for (int c = 0; c < NUM_CONTADORES; c++) {
+            int disponivel = total->descritores[c] >= 0;
+            if (disponivel) {
+                printf("%-14s %20llu\n", NOMES_CONTADORES[c], total->contadores[c]);
+                fprintf(arquivo, "    \"%s\": %llu", NOMES_CONTADORES[c], total->contadores[c]);
+            } else {
+                printf("%-14s %20s\n", NOMES_CONTADORES[c], "indisponivel");
+                fprintf(arquivo, "    \"%s\": null", NOMES_CONTADORES[c]);
+            }
+            fprintf(arquivo, "%s\n", c + 1 < NUM_CONTADORES ? "," : "");
+        }
+        fprintf(arquivo, "  }");
+        if (total->descritores[CONTADOR_CICLOS] >= 0 && total->descritores[CONTADOR_INSTRUCOES] >= 0 && total->contadores[CONTADOR_CICLOS] > 0) {
+            printf("%-14s %20.3f\n", "IPC", (double)total->contadores[CONTADOR_INSTRUCOES] / total->contadores[CONTADOR_CICLOS]);
+        }
+    }
+    fprintf(arquivo, "\n}\n");
+    fclose(arquivo);
+    printf("\n INFO: Instrumentacao gravada em %s\n", caminhoJSON);
+}
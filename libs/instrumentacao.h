@@ -0,0 +1,107 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef INSTRUMENTACAO_H
+#define INSTRUMENTACAO_H
+
+// Compile com -DPSO_INSTRUMENTACAO=1 para medir o tempo de cada fase do laço do PSO.
+// Desligada (padrão), os macros abaixo somem e o laço fica igual ao sem instrumentação.
+#ifndef PSO_INSTRUMENTACAO
+#define PSO_INSTRUMENTACAO 0
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+// Fases medidas dentro de uma iteração
+typedef enum {
+   FASE_VELOCIDADE,   // atualizarVelocidade
+   FASE_POSICAO,      // atualizarPosicao (com o clamp)
+   FASE_AVALIACAO,    // Função objetivo no enxame todo
+   FASE_MELHORES,     // Atualização de pBest, gBest e líderes das vizinhanças
+   FASE_FUNDIDA,      // Iteração do motor fundido ou paralelo (as quatro fases juntas, por bloco ou grão)
+   FASE_PARADA,       // Verificação dos critérios de parada
+   NUM_FASES
+} FaseInstrumentada;
+
+// Contadores de hardware lidos por execução (perf_event_open, só no Linux). Contam só a thread
+// que executa o enxame: o trabalho das threads do motor paralelo, das ilhas e dos avaliadores fica de fora.
+typedef enum {
+   CONTADOR_CICLOS,
+   CONTADOR_INSTRUCOES,
+   CONTADOR_FALHAS_CACHE,
+   CONTADOR_FALHAS_DESVIO,
+   NUM_CONTADORES
+} ContadorHardware;
+
+// Acumuladores de um trabalhador (um por thread; alinhado para não dividir linha de cache)
+typedef struct Instrumentacao {
+   unsigned long long marcas[NUM_FASES];    // Marcas de tempo (ciclos do TSC ou ns) por fase
+   long long chamadas[NUM_FASES];           // Vezes que cada fase rodou
+   long long execucoes;                     // Execuções medidas
+   int usarContadores;                      // 1 = ler os contadores de hardware
+   int contadoresAbertos;                   // Os descritores já foram abertos nesta thread
+   int descritores[NUM_CONTADORES];         // -1 = contador indisponível
+   unsigned long long contadores[NUM_CONTADORES];        // Somados sobre as execuções
+   unsigned long long inicioContadores[NUM_CONTADORES];  // Leitura no início da execução
+} __attribute__((aligned(64))) Instrumentacao;
+
+
+// Marca de tempo barata: rdtsc no x86, relógio monotônico em ns nos demais
+static inline unsigned long long marcaTempo(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    return (unsigned long long)agora.tv_sec * 1000000000ULL + (unsigned long long)agora.tv_nsec;
+#endif
+}
+
+
+// Zera os acumuladores; os contadores de hardware são abertos na primeira execução da thread
+void criarInstrumentacao(Instrumentacao *instrumentacao, int usarContadores);
+
+
+// Lê os contadores no início e no fim de uma execução (chamadas pela thread que executa)
+void iniciarExecucaoInstrumentada(Instrumentacao *instrumentacao);
+void terminarExecucaoInstrumentada(Instrumentacao *instrumentacao);
+
+
+// Soma os acumuladores de um trabalhador no total
+void somarInstrumentacao(Instrumentacao *total, const Instrumentacao *parcial);
+
+
+// Fecha os contadores de hardware
+void liberarInstrumentacao(Instrumentacao *instrumentacao);
+
+
+// Imprime a tabela por fase e grava o mesmo resumo em JSON
+void relatarInstrumentacao(const Instrumentacao *total, const char *caminhoJSON);
+
+
+// Pontos de medição usados pelos motores: sem PSO_INSTRUMENTACAO sobra só o comando
+#if PSO_INSTRUMENTACAO
+#define INSTRUMENTAR_FASE(instrumentacao, fase, comando) \
+    do { \
+        if ((instrumentacao) != NULL) { \
+            unsigned long long inicioFase_ = marcaTempo(); \
+            comando; \
+            (instrumentacao)->marcas[fase] += marcaTempo() - inicioFase_; \
+            (instrumentacao)->chamadas[fase]++; \
+        } else { \
+            comando; \
+        } \
+    } while (0)
+#define INSTRUMENTAR_EXECUCAO_INICIO(instrumentacao) \
+    do { if ((instrumentacao) != NULL) iniciarExecucaoInstrumentada(instrumentacao); } while (0)
+#define INSTRUMENTAR_EXECUCAO_FIM(instrumentacao) \
+    do { if ((instrumentacao) != NULL) terminarExecucaoInstrumentada(instrumentacao); } while (0)
+#else
+#define INSTRUMENTAR_FASE(instrumentacao, fase, comando) do { comando; } while (0)
+#define INSTRUMENTAR_EXECUCAO_INICIO(instrumentacao) ((void)0)
+#define INSTRUMENTAR_EXECUCAO_FIM(instrumentacao) ((void)0)
+#endif
+
+#endif
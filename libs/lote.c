@@ -0,0 +1,392 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#include "lote.h"
+#include "tempo.h"
+
+// Arredonda para um múltiplo da linha de cache (em doubles)
+static size_t arredondarLinha(size_t quantidade) {
+    return (quantidade + DOUBLES_POR_LINHA - 1) / DOUBLES_POR_LINHA * DOUBLES_POR_LINHA;
+}
+
+// Distribui os vetores do lote na arena, realocando apenas se ela não couber
+static void prepararLote(LoteEnxames *lote, int numEnxames, int numParticulas, int dimensoes) {
+    size_t largura = (size_t)(numEnxames + LANES_LOTE - 1) / LANES_LOTE * LANES_LOTE;
+    size_t bloco = (size_t)dimensoes * numParticulas * largura;
+    size_t porParticula = (size_t)numParticulas * largura;
+    size_t porEnxame = arredondarLinha(largura);
+    // 5 blocos, 2 vetores por partícula, gBest, 7 vetores de doubles, estado (4), avaliações e 3 vetores de int
+    size_t total = 5 * bloco + 2 * porParticula + (size_t)dimensoes * largura + 7 * porEnxame + 4 * porEnxame + porEnxame + 2 * porEnxame;
+    size_t bytes = total * sizeof(double) + ALINHAMENTO_ENXAME;
+
+    if (lote->arena == NULL || lote->capacidadeArena < bytes) {
+        free(lote->arena);
+        lote->arena = malloc(bytes);
+        if (lote->arena == NULL) {
+            printf("Erro ao alocar o lote de %d enxames\n", numEnxames);
+            exit(1);
+        }
+        lote->capacidadeArena = bytes;
+    }
+
+    uintptr_t endereco = (uintptr_t)lote->arena;
+    double *base = (double *)((endereco + ALINHAMENTO_ENXAME - 1) & ~(uintptr_t)(ALINHAMENTO_ENXAME - 1));
+
+    lote->position = base;
+    lote->velocity = lote->position + bloco;
+    lote->bestPosition = lote->velocity + bloco;
+    lote->r1 = lote->bestPosition + bloco;
+    lote->r2 = lote->r1 + bloco;
+    lote->fitness = lote->r2 + bloco;
+    lote->bestFitness = lote->fitness + porParticula;
+    lote->globalBestPosition = lote->bestFitness + porParticula;
+    lote->globalBestFitness = lote->globalBestPosition + (size_t)dimensoes * largura;
+    lote->ativo = lote->globalBestFitness + porEnxame;
+    lote->ultimoMelhor = lote->ativo + porEnxame;
+    lote->w = lote->ultimoMelhor + porEnxame;
+    lote->c1 = lote->w + porEnxame;
+    lote->c2 = lote->c1 + porEnxame;
+    lote->indiceGlobal = lote->c2 + porEnxame;
+    lote->estado = (uint64_t *)(lote->indiceGlobal + porEnxame);
+    lote->avaliacoes = (long long *)(lote->estado + 4 * porEnxame);
+    lote->semMelhora = (int *)(lote->avaliacoes + porEnxame);
+    lote->iteracoes = lote->semMelhora + porEnxame;
+    lote->criterio = (CriterioParada *)(lote->iteracoes + porEnxame);
+    lote->numEnxames = numEnxames;
+    lote->largura = (int)largura;
+    lote->numParticulas = numParticulas;
+    lote->dimensoes = dimensoes;
+}
+
+static inline uint64_t rotacionar(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline double bitsParaDouble(uint64_t bits) {
+    double x;
+    memcpy(&x, &bits, sizeof x);
+    return x;
+}
+
+// Igual a paraUniforme, mas sem a conversão de inteiro de 64 bits (que o SSE2 não tem em vetor):
+// as duas metades de 32 bits viram doubles por soma de constantes mágicas. As somas são exatas
+// para valores abaixo de 2^53, então o resultado é o mesmo bit a bit.
+static inline double uniformeVetorizavel(uint64_t bits) {
+    uint64_t valor = bits >> 11;
+    double alto = bitsParaDouble(0x4530000000000000ULL | (valor >> 32)) - 19342813118337666422669312.0; // 2^84 + 2^52
+    double baixo = bitsParaDouble(0x4330000000000000ULL | (valor & 0xFFFFFFFFULL));
+    return (alto + baixo) * (1.0 / 9007199254740992.0);
+}
+
+// Sorteia n linhas de uniformes, uma lane por enxame; a ordem dos sorteios de cada enxame é a
+// mesma de gerarUniformes(n) no enxame isolado. O estado de um grupo de LANES_LOTE lanes fica em
+// variáveis locais (registradores) durante as n linhas e o passo do xoshiro vetoriza atravessando os enxames.
+static void gerarLinhasLote(LoteEnxames *lote, double *saida, int n) {
+    int largura = lote->largura;
+    uint64_t *estado = lote->estado;
+
+    for (int base = 0; base < lote->numEnxames; base += LANES_LOTE) {
+        uint64_t s0[LANES_LOTE], s1[LANES_LOTE], s2[LANES_LOTE], s3[LANES_LOTE];
+        for (int s = 0; s < LANES_LOTE; s++) {
+            s0[s] = estado[base + s];
+            s1[s] = estado[largura + base + s];
+            s2[s] = estado[2 * largura + base + s];
+            s3[s] = estado[3 * largura + base + s];
+        }
+        for (int p = 0; p < n; p++) {
+            double *restrict linha = &saida[(size_t)p * largura + base];
+            // sem o desenrolamento completo o GCC vetoriza este laço em vez de deixá-lo escalar
+#pragma GCC unroll 1
+            for (int s = 0; s < LANES_LOTE; s++) {
+                // * 5 e * 9 como deslocamento e soma: o SSE2 não multiplica inteiros de 64 bits
+                uint64_t x = rotacionar((s1[s] << 2) + s1[s], 7);
+                uint64_t resultado = (x << 3) + x;
+                uint64_t t = s1[s] << 17;
+                s2[s] ^= s0[s];
+                s3[s] ^= s1[s];
+                s1[s] ^= s2[s];
+                s0[s] ^= s3[s];
+                s2[s] ^= t;
+                s3[s] = rotacionar(s3[s], 45);
+                linha[s] = uniformeVetorizavel(resultado);
+            }
+        }
+        for (int s = 0; s < LANES_LOTE; s++) {
+            estado[base + s] = s0[s];
+            estado[largura + base + s] = s1[s];
+            estado[2 * largura + base + s] = s2[s];
+            estado[3 * largura + base + s] = s3[s];
+        }
+    }
+}
+
+// Avalia todas as lanes de uma vez: o lote é um bloco dimensão-major de numParticulas * largura partículas
+static void avaliarLote(LoteEnxames *lote) {
+    int n = lote->numParticulas * lote->largura;
+    lote->objetivo.kernel(lote->position, n, lote->dimensoes, n, lote->fitness);
+}
+
+// pBest e gBest de uma partícula em todas as lanes; mascara[s] = 1 onde o pBest melhorou.
+// & em vez de &&, e as cargas fora das seleções: sem desvio o laço vetoriza atravessando os enxames
+static void melhorarLinhaLote(int largura, const double *restrict ativo, const double *restrict aptidao,
+                              double *restrict melhor, double *restrict mascara, double *restrict globalFitness,
+                              double *restrict indiceGlobal, double particula) {
+    for (int s = 0; s < largura; s++) {
+        double valor = aptidao[s], pessoal = melhor[s], coletivo = globalFitness[s], indice = indiceGlobal[s];
+        int melhorou = (ativo[s] != 0.0) & (valor < pessoal);
+        int global = (ativo[s] != 0.0) & (valor < coletivo);
+        melhor[s] = melhorou ? valor : pessoal;
+        mascara[s] = melhorou ? 1.0 : 0.0;
+        globalFitness[s] = global ? valor : coletivo;
+        indiceGlobal[s] = global ? particula : indice;
+    }
+}
+
+// Atualiza pBest e gBest dos enxames ativos (mesma regra do motor clássico: primeira partícula estritamente melhor).
+// As melhoras de pBest ficam numa máscara [numParticulas][largura] (o bloco r2, livre até o próximo moverLote),
+// que tem o formato de uma dimensão do pBest: cada dimensão é atualizada num laço só de numParticulas * largura.
+static void atualizarMelhoresLote(LoteEnxames *lote) {
+    int largura = lote->largura;
+    size_t n = (size_t)lote->numParticulas * largura;
+    const double *restrict ativo = lote->ativo;
+    double *restrict globalFitness = lote->globalBestFitness;
+    double *restrict indiceGlobal = lote->indiceGlobal;
+
+    for (int s = 0; s < largura; s++) {
+        indiceGlobal[s] = -1.0;
+    }
+    for (int p = 0; p < lote->numParticulas; p++) {
+        melhorarLinhaLote(largura, ativo, &lote->fitness[(size_t)p * largura], &lote->bestFitness[(size_t)p * largura],
+                          &lote->r2[(size_t)p * largura], globalFitness, indiceGlobal, p);
+    }
+    for (int d = 0; d < lote->dimensoes; d++) {
+        const double *restrict mascara = lote->r2;
+        const double *restrict posicao = &COORD_LOTE(lote, position, d, 0, 0);
+        double *restrict melhorPosicao = &COORD_LOTE(lote, bestPosition, d, 0, 0);
+        for (size_t k = 0; k < n; k++) {
+            double nova = posicao[k], antiga = melhorPosicao[k];
+            melhorPosicao[k] = mascara[k] != 0.0 ? nova : antiga;
+        }
+    }
+    for (int s = 0; s < lote->numEnxames; s++) {
+        int p = (int)indiceGlobal[s];
+        if (p >= 0) {
+            for (int d = 0; d < lote->dimensoes; d++) {
+                lote->globalBestPosition[(size_t)d * largura + s] = COORD_LOTE(lote, position, d, p, s);
+            }
+        }
+    }
+}
+
+void inicializarLote(LoteEnxames *lote, const unsigned long long sementes[], int numEnxames,
+                     int numParticulas, int dimensoes, double posMin, double posMax, double velMax) {
+    prepararLote(lote, numEnxames, numParticulas, dimensoes);
+    if (lote->objetivo.kernel == NULL) {
+        objetivoPorNome("eggholder", dimensoes, &lote->objetivo);
+    }
+    int largura = lote->largura;
+
+    // cada lane recebe o estado que semearGerador daria ao enxame isolado; as lanes de sobra ficam desligadas
+    for (int s = 0; s < largura; s++) {
+        GeradorAleatorio gerador;
+        semearGerador(&gerador, GERADOR_XOSHIRO256, s < numEnxames ? sementes[s] : 0);
+        for (int k = 0; k < 4; k++) {
+            lote->estado[(size_t)k * largura + s] = gerador.estado[k];
+        }
+        lote->ativo[s] = s < numEnxames ? 1.0 : 0.0;
+        lote->globalBestFitness[s] = DBL_MAX;
+        lote->avaliacoes[s] = 0;
+        lote->semMelhora[s] = 0;
+        lote->iteracoes[s] = 0;
+        lote->criterio[s] = PARADA_NENHUMA;
+    }
+    for (size_t k = 0; k < (size_t)numParticulas * largura; k++) {
+        lote->fitness[k] = DBL_MAX;
+        lote->bestFitness[k] = DBL_MAX;
+    }
+
+    for (int d = 0; d < dimensoes; d++) {
+        double *posicao = &COORD_LOTE(lote, position, d, 0, 0);
+        double *velocidade = &COORD_LOTE(lote, velocity, d, 0, 0);
+        double *melhor = &COORD_LOTE(lote, bestPosition, d, 0, 0);
+        size_t n = (size_t)numParticulas * largura;
+
+        gerarLinhasLote(lote, posicao, numParticulas);
+        gerarLinhasLote(lote, velocidade, numParticulas);
+        for (size_t k = 0; k < n; k++) {
+            posicao[k] = posMin + (posMax - posMin) * posicao[k];
+            velocidade[k] = -velMax + 2 * velMax * velocidade[k];
+            melhor[k] = posicao[k];
+        }
+    }
+
+    avaliarLote(lote);
+    atualizarMelhoresLote(lote);
+    for (int s = 0; s < numEnxames; s++) {
+        lote->avaliacoes[s] = numParticulas;
+        lote->ultimoMelhor[s] = lote->globalBestFitness[s];
+    }
+}
+
+// Velocidade e posição de todas as lanes. As dos enxames parados também andam, sem máscara: pBest,
+// gBest e contadores deles não mudam mais e nada que é lido deles depende da posição ou da velocidade.
+static void moverLote(LoteEnxames *lote, const ParametrosPSO *parametros) {
+    int largura = lote->largura;
+    const double *restrict w = lote->w, *restrict c1 = lote->c1, *restrict c2 = lote->c2;
+    const Fronteira fronteira = fronteiraDosParametros(parametros);
+    int n = lote->numParticulas * largura;
+
+    for (int d = 0; d < lote->dimensoes; d++) {
+        const double *restrict global = &lote->globalBestPosition[(size_t)d * largura];
+        double *posicao = &COORD_LOTE(lote, position, d, 0, 0);
+        double *velocidade = &COORD_LOTE(lote, velocity, d, 0, 0);
+        double *r1 = &COORD_LOTE(lote, r1, d, 0, 0);
+
+        // mesma ordem de sorteio do motor clássico: r1 da dimensão inteira, depois r2
+        gerarLinhasLote(lote, r1, lote->numParticulas);
+        gerarLinhasLote(lote, &COORD_LOTE(lote, r2, d, 0, 0), lote->numParticulas);
+        for (int p = 0; p < lote->numParticulas; p++) {
+            const double *restrict x = &COORD_LOTE(lote, position, d, p, 0);
+            const double *restrict melhor = &COORD_LOTE(lote, bestPosition, d, p, 0);
+            const double *restrict a = &COORD_LOTE(lote, r1, d, p, 0);
+            const double *restrict b = &COORD_LOTE(lote, r2, d, p, 0);
+            double *restrict v = &COORD_LOTE(lote, velocity, d, p, 0);
+
+            for (int s = 0; s < largura; s++) {
+                v[s] = w[s] * v[s] + c1[s] * a[s] * (melhor[s] - x[s]) + c2[s] * b[s] * (global[s] - x[s]);
+            }
+        }
+        // o r1 já usado recebe os sorteios dos reinícios; a dimensão inteira anda numa chamada só
+        if (fronteira.politica == FRONTEIRA_REINICIAR) {
+            gerarLinhasLote(lote, r1, lote->numParticulas);
+        }
+        moverLinha(&fronteira, posicao, velocidade, r1, n);
+    }
+}
+
+// Maior distância ao gBest (raio) ou maior norma de velocidade do enxame s
+static double maiorNormaLote(const LoteEnxames *lote, int s, int velocidade) {
+    double maior = 0.0;
+    for (int p = 0; p < lote->numParticulas; p++) {
+        double quadrado = 0.0;
+        for (int d = 0; d < lote->dimensoes; d++) {
+            double valor = velocidade ? COORD_LOTE(lote, velocity, d, p, s)
+                                      : COORD_LOTE(lote, position, d, p, s) - lote->globalBestPosition[(size_t)d * lote->largura + s];
+            quadrado += valor * valor;
+        }
+        maior = quadrado > maior ? quadrado : maior;
+    }
+    return sqrt(maior);
+}
+
+// Aplica os critérios (na ordem do motor clássico) a cada enxame ativo; devolve quantos continuam
+static int verificarParadaLote(LoteEnxames *lote, const ParametrosPSO *parametros, double inicio) {
+    const CriteriosParada *criterios = &parametros->parada;
+    int ativos = 0;
+    int tempoEsgotado = criterios->tempoMaximo > 0 && tempoAtual() - inicio >= criterios->tempoMaximo;
+
+    for (int s = 0; s < lote->numEnxames; s++) {
+        CriterioParada criterio = PARADA_NENHUMA;
+        if (lote->ativo[s] == 0.0) {
+            continue;
+        }
+        if (!isnan(criterios->alvo) && lote->globalBestFitness[s] <= criterios->alvo) {
+            criterio = PARADA_ALVO;
+        } else if (criterios->estagnacao > 0 && lote->semMelhora[s] >= criterios->estagnacao) {
+            criterio = PARADA_ESTAGNACAO;
+        } else if (criterios->avaliacoesMaximas > 0 && lote->avaliacoes[s] + lote->numParticulas > criterios->avaliacoesMaximas) {
+            criterio = PARADA_AVALIACOES;
+        } else if (tempoEsgotado) {
+            criterio = PARADA_TEMPO;
+        } else if (criterios->raioMinimo > 0 && maiorNormaLote(lote, s, 0) < criterios->raioMinimo) {
+            criterio = PARADA_RAIO;
+        } else if (criterios->velocidadeMinima > 0 && maiorNormaLote(lote, s, 1) < criterios->velocidadeMinima) {
+            criterio = PARADA_VELOCIDADE;
+        } else if (lote->iteracoes[s] >= parametros->iteracoes) {
+            criterio = PARADA_ITERACOES;
+        }
+
+        if (criterio != PARADA_NENHUMA) {
+            lote->criterio[s] = criterio;
+            lote->ativo[s] = 0.0;
+        } else {
+            ativos++;
+        }
+    }
+    return ativos;
+}
+
+// Coeficientes de cada enxame para a próxima iteração (cada um com a própria iteração e o próprio sucesso)
+static void coeficientesDoLote(LoteEnxames *lote, const ParametrosPSO *parametros) {
+    Coeficientes base = {parametros->w, parametros->c1, parametros->c2};
+
+    for (int s = 0; s < lote->largura; s++) {
+        Coeficientes coeficientes = base;
+        if (parametros->agenda.tipo != AGENDA_FIXA && s < lote->numEnxames) {
+            double sucesso = parametros->agenda.tipo == AGENDA_ADAPTATIVA
+                           ? taxaDeSucesso(&lote->fitness[s], &lote->bestFitness[s], lote->numParticulas, lote->largura) : 0.0;
+            coeficientes = coeficientesDaIteracao(&parametros->agenda, base, lote->iteracoes[s], parametros->iteracoes, sucesso);
+        }
+        lote->w[s] = coeficientes.w;
+        lote->c1[s] = coeficientes.c1;
+        lote->c2[s] = coeficientes.c2;
+    }
+}
+
+void executarLote(LoteEnxames *lote, const ParametrosPSO *parametros, ResultadoPSO resultados[]) {
+    double inicio = parametros->parada.tempoMaximo > 0 ? tempoAtual() : 0.0;
+
+    coeficientesDoLote(lote, parametros);
+
+    INSTRUMENTAR_EXECUCAO_INICIO(parametros->instrumentacao);
+    for (;;) {
+        int ativos;
+        INSTRUMENTAR_FASE(parametros->instrumentacao, FASE_PARADA, ativos = verificarParadaLote(lote, parametros, inicio));
+        if (ativos == 0) {
+            break;
+        }
+        if (parametros->agenda.tipo != AGENDA_FIXA) {
+            coeficientesDoLote(lote, parametros);
+        }
+        INSTRUMENTAR_FASE(parametros->instrumentacao, FASE_VELOCIDADE, moverLote(lote, parametros)); // velocidade e posição juntas
+        INSTRUMENTAR_FASE(parametros->instrumentacao, FASE_AVALIACAO, avaliarLote(lote));
+        INSTRUMENTAR_FASE(parametros->instrumentacao, FASE_MELHORES, atualizarMelhoresLote(lote));
+
+        for (int s = 0; s < lote->numEnxames; s++) {
+            if (lote->ativo[s] == 0.0) {
+                continue;
+            }
+            lote->iteracoes[s]++;
+            lote->avaliacoes[s] += lote->numParticulas;
+            if (lote->globalBestFitness[s] < lote->ultimoMelhor[s]) {
+                lote->ultimoMelhor[s] = lote->globalBestFitness[s];
+                lote->semMelhora[s] = 0;
+            } else {
+                lote->semMelhora[s]++;
+            }
+        }
+    }
+    INSTRUMENTAR_EXECUCAO_FIM(parametros->instrumentacao);
+
+    for (int s = 0; s < lote->numEnxames; s++) {
+        resultados[s].melhor = lote->globalBestFitness[s];
+        resultados[s].iteracoes = lote->iteracoes[s];
+        resultados[s].avaliacoes = lote->avaliacoes[s];
+        resultados[s].criterio = lote->criterio[s];
+    }
+}
+
+void melhorPosicaoDoLote(const LoteEnxames *lote, int s, double *posicao) {
+    for (int d = 0; d < lote->dimensoes; d++) {
+        posicao[d] = lote->globalBestPosition[(size_t)d * lote->largura + s];
+    }
+}
+
+void liberarLote(LoteEnxames *lote) {
+    free(lote->arena);
+    lote->arena = NULL;
+    lote->capacidadeArena = 0;
+}
@@ -0,0 +1,76 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef LOTE_H
+#define LOTE_H
+#include <stddef.h>
+#include <stdint.h>
+#include "motor.h"
+
+// Enxames por vetor: a largura do lote é múltipla de 4 lanes (um registrador AVX2 de doubles).
+// Com 8 (AVX-512) um lote de 10 enxames carregaria 6 lanes mortas em todo laço; com 4, só 2.
+#define LANES_LOTE 4
+
+// Vários enxames pequenos independentes (mesma célula: partículas, dimensões e parâmetros)
+// evoluindo juntos. Tudo é enxame-major: o valor do enxame s da partícula p na dimensão d
+// fica em [(d * numParticulas + p) * largura + s], então o laço mais interno percorre
+// os enxames e vetoriza atravessando-os. Cada enxame tem o próprio gBest, o próprio fluxo
+// xoshiro256** (semeado como o do enxame isolado) e o próprio estado de parada;
+// os que param saem da máscara e o pBest, o gBest e os contadores deles ficam congelados.
+// O passo mais caro é o xoshiro: no build genérico (só SSE2) ele vetoriza em 2 lanes e custa quase o
+// mesmo que no motor clássico, então o lote só ganha pouco; com PSO_NATIVO (AVX2/AVX-512) ele vetoriza de fato.
+typedef struct {
+   void *arena;                // Bloco alocado (único malloc por lote)
+   size_t capacidadeArena;     // Tamanho da arena em bytes
+   double *position;           // Posições [dimensoes][numParticulas][largura]
+   double *velocity;           // Velocidades [dimensoes][numParticulas][largura]
+   double *bestPosition;       // pBest [dimensoes][numParticulas][largura]
+   double *r1;                 // Sorteios da componente cognitiva [dimensoes][numParticulas][largura]
+   double *r2;                 // Sorteios da componente social; depois, máscara das melhoras de pBest [dimensoes][numParticulas][largura]
+   double *fitness;            // Aptidão atual [numParticulas][largura]
+   double *bestFitness;        // Aptidão do pBest [numParticulas][largura]
+   double *globalBestPosition; // gBest de cada enxame [dimensoes][largura]
+   double *globalBestFitness;  // Aptidão do gBest [largura]
+   double *ativo;              // Máscara: 1 = enxame ainda evoluindo, 0 = parado [largura]
+   double *ultimoMelhor;       // gBest da última melhora (estagnação) [largura]
+   double *w;                  // Coeficientes da iteração de cada enxame (agenda por enxame) [largura]
+   double *c1;                 // [largura]
+   double *c2;                 // [largura]
+   double *indiceGlobal;       // Rascunho: partícula que melhorou o gBest na iteração, em double para vetorizar com as aptidões [largura]
+   uint64_t *estado;           // Estados xoshiro256** [4][largura]
+   long long *avaliacoes;      // Avaliações de cada enxame [largura]
+   int *semMelhora;            // Iterações seguidas sem melhorar o gBest [largura]
+   int *iteracoes;             // Iterações feitas por cada enxame [largura]
+   CriterioParada *criterio;   // Critério que parou cada enxame [largura]
+   int numEnxames;             // Enxames em uso (as lanes restantes ficam desligadas)
+   int largura;                // numEnxames arredondado para múltiplo de LANES_LOTE
+   int numParticulas;
+   int dimensoes;
+   Objetivo objetivo;          // Função objetivo (Eggholder se não for definida)
+} LoteEnxames;
+
+// Acessa o valor do enxame s, partícula p, dimensão d em um dos vetores do lote
+#define COORD_LOTE(lote, vetor, d, p, s) \
+    ((lote)->vetor[((size_t)(d) * (lote)->numParticulas + (p)) * (lote)->largura + (s)])
+
+
+// Inicializa numEnxames enxames, cada um com a sua semente, com as mesmas posições e velocidades
+// iniciais que inicializarEnxame daria a um enxame isolado com a mesma semente.
+// Reaproveita a arena do lote quando ela couber; o lote deve começar zerado.
+void inicializarLote(LoteEnxames *lote, const unsigned long long sementes[], int numEnxames,
+                     int numParticulas, int dimensoes, double posMin, double posMax, double velMax);
+
+
+// Evolui todos os enxames até cada um atingir o limite de iterações ou um critério de parada.
+// resultados[s] recebe o resumo do enxame s. Cada enxame segue a trajetória do motor clássico
+// com a mesma semente (a menos do último bit quando o kernel vetorizado e o escalar divergem),
+// exceto com FRONTEIRA_REINICIAR, que aqui sorteia os reinícios dimensão a dimensão.
+void executarLote(LoteEnxames *lote, const ParametrosPSO *parametros, ResultadoPSO resultados[]);
+
+
+// Copia o gBest do enxame s
+void melhorPosicaoDoLote(const LoteEnxames *lote, int s, double *posicao);
+
+
+// Libera a arena do lote
+void liberarLote(LoteEnxames *lote);
+
+#endif
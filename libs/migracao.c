@@ -0,0 +1,130 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "migracao.h"
+#include "aleatorio.h"
+
+// Voltas de espera ativa antes de ceder o núcleo a outra thread
+#define VOLTAS_ANTES_DE_CEDER 64
+
+void prepararAnel(AnelMigracao *anel, int doublesPorMensagem) {
+    if (anel->mensagens == NULL || anel->doublesPorMensagem < doublesPorMensagem) {
+        free(anel->mensagens);
+        anel->mensagens = (double *)malloc((size_t)CAPACIDADE_ANEL_MIGRACAO * doublesPorMensagem * sizeof(double));
+        if (anel->mensagens == NULL) {
+            printf("Erro ao alocar o anel de migracao\n");
+            exit(1);
+        }
+    }
+    anel->doublesPorMensagem = doublesPorMensagem;
+    esvaziarAnel(anel);
+}
+
+void esvaziarAnel(AnelMigracao *anel) {
+    anel->escrita = 0;
+    anel->leitura = 0;
+}
+
+int enviarMensagem(AnelMigracao *anel, const double *mensagem, const int *destinoEncerrado) {
+    long long escrita = anel->escrita;
+
+    for (int volta = 0; escrita - __atomic_load_n(&anel->leitura, __ATOMIC_ACQUIRE) >= CAPACIDADE_ANEL_MIGRACAO; volta++) {
+        // o destino que já encerrou não vai mais consumir: a mensagem é descartada
+        if (__atomic_load_n(destinoEncerrado, __ATOMIC_ACQUIRE)) {
+            return 0;
+        }
+        if (volta >= VOLTAS_ANTES_DE_CEDER) {
+            sched_yield();
+        }
+    }
+    memcpy(&anel->mensagens[(size_t)(escrita % CAPACIDADE_ANEL_MIGRACAO) * anel->doublesPorMensagem], mensagem,
+           (size_t)anel->doublesPorMensagem * sizeof(double));
+    __atomic_store_n(&anel->escrita, escrita + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+const double *esperarMensagem(AnelMigracao *anel, const int *origemEncerrada) {
+    long long leitura = anel->leitura;
+
+    for (int volta = 0; __atomic_load_n(&anel->escrita, __ATOMIC_ACQUIRE) <= leitura; volta++) {
+        // a origem publica antes de se dar por encerrada: olhar o contador de novo depois da marca
+        // separa "ainda não publicou" de "não vai mais publicar"
+        if (__atomic_load_n(origemEncerrada, __ATOMIC_ACQUIRE)) {
+            if (__atomic_load_n(&anel->escrita, __ATOMIC_ACQUIRE) > leitura) {
+                break;
+            }
+            return NULL;
+        }
+        if (volta >= VOLTAS_ANTES_DE_CEDER) {
+            sched_yield();
+        }
+    }
+    return &anel->mensagens[(size_t)(leitura % CAPACIDADE_ANEL_MIGRACAO) * anel->doublesPorMensagem];
+}
+
+void liberarMensagem(AnelMigracao *anel) {
+    __atomic_store_n(&anel->leitura, anel->leitura + 1, __ATOMIC_RELEASE);
+}
+
+void liberarAnel(AnelMigracao *anel) {
+    free(anel->mensagens);
+    memset(anel, 0, sizeof(*anel));
+}
+
+// Deslocamento da topologia aleatória na migração epoca: entre 1 e numIlhas - 1, igual para todas
+static int deslocamentoDaMigracao(int numIlhas, long long epoca, uint64_t semente) {
+    return 1 + (int)(misturar64(semente + 0x9e3779b97f4a7c15ULL * (uint64_t)(epoca + 1)) % (uint64_t)(numIlhas - 1));
+}
+
+// Vizinhos da ilha numa direção: sentido = +1 para destinos, -1 para origens
+static int vizinhosDaMigracao(const PoliticaMigracao *politica, int ilha, int numIlhas, long long epoca, uint64_t semente,
+                              int sentido, int *vizinhos) {
+    int deslocamento = 1;
+
+    if (numIlhas < 2) {
+        return 0;
+    }
+    if (politica->topologia == MIGRACAO_TODOS) {
+        int total = 0;
+        for (int outra = 0; outra < numIlhas; outra++) {
+            if (outra != ilha) {
+                vizinhos[total++] = outra;
+            }
+        }
+        return total;
+    }
+    if (politica->topologia == MIGRACAO_ALEATORIA) {
+        deslocamento = deslocamentoDaMigracao(numIlhas, epoca, semente);
+    }
+    vizinhos[0] = ((ilha + sentido * deslocamento) % numIlhas + numIlhas) % numIlhas;
+    return 1;
+}
+
+int destinosDaMigracao(const PoliticaMigracao *politica, int ilha, int numIlhas, long long epoca, uint64_t semente, int *destinos) {
+    return vizinhosDaMigracao(politica, ilha, numIlhas, epoca, semente, 1, destinos);
+}
+
+int origensDaMigracao(const PoliticaMigracao *politica, int ilha, int numIlhas, long long epoca, uint64_t semente, int *origens) {
+    return vizinhosDaMigracao(politica, ilha, numIlhas, epoca, semente, -1, origens);
+}
+
+const char *nomeMigracao(TopologiaMigracao topologia) {
+    static const char *NOMES[] = {"anel", "todos", "aleatoria"};
+    return NOMES[topologia];
+}
+
+int migracaoPorNome(const char *nome, TopologiaMigracao *topologia) {
+    for (int k = MIGRACAO_ANEL; k <= MIGRACAO_ALEATORIA; k++) {
+        if (strcmp(nome, nomeMigracao((TopologiaMigracao)k)) == 0) {
+            *topologia = (TopologiaMigracao)k;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+const char *nomesMigracoes(void) {
+    return "anel, todos, aleatoria";
+}
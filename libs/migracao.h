@@ -0,0 +1,80 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef MIGRACAO_H
+#define MIGRACAO_H
+#include <stdint.h>
+
+// Maior número de ilhas de uma execução
+#define MAX_ILHAS 64
+
+// Mensagens que cabem num anel: a ilha de origem pode adiantar até tantas migrações
+#define CAPACIDADE_ANEL_MIGRACAO 4
+
+// Migração padrão: os 2 melhores de cada ilha a cada 10 iterações
+#define INTERVALO_MIGRACAO_PADRAO 10
+#define MIGRANTES_PADRAO 2
+
+// Para quem cada ilha manda os seus melhores a cada migração
+typedef enum {
+   MIGRACAO_ANEL,      // Para a ilha seguinte (i -> i + 1)
+   MIGRACAO_TODOS,     // Para todas as outras
+   MIGRACAO_ALEATORIA  // Para a ilha a um deslocamento sorteado a cada migração (o mesmo para todas)
+} TopologiaMigracao;
+
+// Modelo de ilhas: subenxames em threads próprias trocando partículas de tempos em tempos
+typedef struct {
+   int numIlhas;                // Subenxames da execução (1 = enxame único)
+   int intervalo;               // Iterações entre migrações (0 = ilhas isoladas)
+   int migrantes;               // Melhores partículas enviadas a cada destino
+   TopologiaMigracao topologia;
+} PoliticaMigracao;
+
+// Fila lock-free de um produtor e um consumidor (uma por par de ilhas). Os contadores ficam em
+// linhas de cache separadas: cada ilha só escreve o seu e lê o da outra com acquire.
+typedef struct {
+   long long escrita;           // Mensagens publicadas (só a origem escreve)
+   char separacao1[64 - sizeof(long long)];
+   long long leitura;           // Mensagens consumidas (só o destino escreve)
+   char separacao2[64 - sizeof(long long)];
+   double *mensagens;           // [CAPACIDADE_ANEL_MIGRACAO][doublesPorMensagem]
+   int doublesPorMensagem;
+} AnelMigracao;
+
+
+// Aloca as mensagens do anel (realoca só se não couberem) e o esvazia; o anel deve começar zerado
+void prepararAnel(AnelMigracao *anel, int doublesPorMensagem);
+
+
+// Esvazia o anel para uma nova execução (sem threads usando ele)
+void esvaziarAnel(AnelMigracao *anel);
+
+
+// Publica uma mensagem; com o anel cheio espera o destino consumir, a menos que ele já tenha
+// encerrado (*destinoEncerrado != 0), caso em que a mensagem é descartada. Retorna 1 se publicou.
+int enviarMensagem(AnelMigracao *anel, const double *mensagem, const int *destinoEncerrado);
+
+
+// Espera a próxima mensagem do anel e devolve onde ela está (válida até liberarMensagem);
+// NULL se a origem encerrou sem publicar mais nada
+const double *esperarMensagem(AnelMigracao *anel, const int *origemEncerrada);
+
+
+// Devolve ao produtor o espaço da mensagem lida
+void liberarMensagem(AnelMigracao *anel);
+
+
+// Libera as mensagens do anel
+void liberarAnel(AnelMigracao *anel);
+
+
+// Destinos (e origens) da ilha na migração de número epoca; devolvem quantos. Todas as ilhas
+// calculam a mesma tabela, então cada uma sabe de quem esperar mensagem em cada migração.
+int destinosDaMigracao(const PoliticaMigracao *politica, int ilha, int numIlhas, long long epoca, uint64_t semente, int *destinos);
+int origensDaMigracao(const PoliticaMigracao *politica, int ilha, int numIlhas, long long epoca, uint64_t semente, int *origens);
+
+
+// Nome e conversão a partir do nome (anel, todos, aleatoria); a conversão retorna 0 se o nome não existir
+const char *nomeMigracao(TopologiaMigracao topologia);
+int migracaoPorNome(const char *nome, TopologiaMigracao *topologia);
+const char *nomesMigracoes(void);
+
+#endif
@@ -0,0 +1,704 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "motor.h"
+#include "substituto.h"
+#include "tempo.h"
+
+ParametrosPSO parametrosPadrao(void) {
+    ParametrosPSO parametros;
+    parametros.iteracoes = 100;
+    parametros.dimensoes = 2;
+    parametros.w = 0.5;
+    parametros.c1 = 1.5;
+    parametros.c2 = 1.5;
+    parametros.posMin = -512;
+    parametros.posMax = 512;
+    parametros.velMax = 77;
+    parametros.fronteira = FRONTEIRA_ABSORVER;
+    parametros.limitarVelocidade = 0;
+    parametros.agenda = agendaPadrao(AGENDA_FIXA);
+    parametros.reinicio.estagnacao = 0;
+    parametros.reinicio.diametro = 0;
+    parametros.reinicio.fracao = 1.0;
+    parametros.elite = NULL;
+    parametros.motor = MOTOR_CLASSICO;
+    parametros.modoGBest = GBEST_SINCRONO;
+    parametros.tamanhoBloco = TAMANHO_BLOCO_PADRAO;
+    parametros.grao = GRAO_PADRAO;
+    parametros.grupo = NULL;
+    objetivoPorNome("eggholder", parametros.dimensoes, &parametros.objetivo);
+    parametros.telemetria = NULL;
+    parametros.instrumentacao = NULL;
+    parametros.parada.alvo = NAN;
+    parametros.parada.estagnacao = 0;
+    parametros.parada.raioMinimo = 0;
+    parametros.parada.velocidadeMinima = 0;
+    parametros.parada.tempoMaximo = 0;
+    parametros.parada.avaliacoesMaximas = 0;
+    parametros.salvamento = NULL;
+    parametros.topologia = TOPOLOGIA_GLOBAL;
+    parametros.vizinhosAleatorios = VIZINHOS_ALEATORIOS_PADRAO;
+    parametros.vizinhanca = NULL;
+    parametros.ilhas.numIlhas = 1;
+    parametros.ilhas.intervalo = INTERVALO_MIGRACAO_PADRAO;
+    parametros.ilhas.migrantes = MIGRANTES_PADRAO;
+    parametros.ilhas.topologia = MIGRACAO_ANEL;
+    parametros.migracao = NULL;
+    return parametros;
+}
+
+// Sorteia posições e velocidades iniciais
+void sortearEnxame(Swarm *enxame, int numParticulas, int dimensoes, double posMin, double posMax, double velMax) {
+    prepararEnxame(enxame, numParticulas, dimensoes);
+    if (enxame->objetivo.kernel == NULL) {
+        objetivoPorNome("eggholder", dimensoes, &enxame->objetivo);
+    }
+    enxame->globalBestFitness = DBL_MAX;
+    enxame->avaliacoes = 0;
+
+    for (int i = 0; i < numParticulas; i++) {
+        enxame->fitness[i] = DBL_MAX;
+        enxame->bestFitness[i] = DBL_MAX;
+    }
+
+    for (int d = 0; d < dimensoes; d++) {
+        double *posicao = &COORD(enxame, position, d, 0);
+        double *velocidade = &COORD(enxame, velocity, d, 0);
+        double *melhor = &COORD(enxame, bestPosition, d, 0);
+
+        gerarUniformes(&enxame->gerador, posicao, numParticulas);
+        gerarUniformes(&enxame->gerador, velocidade, numParticulas);
+        for (int i = 0; i < numParticulas; i++) {
+            posicao[i] = posMin + (posMax - posMin) * posicao[i];
+            velocidade[i] = -velMax + 2 * velMax * velocidade[i];
+            melhor[i] = posicao[i];
+        }
+    }
+}
+
+// Inicializa o enxame
+void inicializarEnxame(Swarm *enxame, int numParticulas, int dimensoes, double posMin, double posMax, double velMax) {
+    sortearEnxame(enxame, numParticulas, dimensoes, posMin, posMax, velMax);
+
+    // avalia as posições iniciais para que pBest e gBest existam antes da primeira atualização de velocidade
+    atualizarMelhoresPosicoes(enxame);
+}
+
+// Avalia a aptidão
+double avaliarAptidao(const Swarm *enxame, int i) {
+    double aptidao;
+    avaliarObjetivo(&enxame->objetivo, &COORD(enxame, position, 0, i), enxame->stride, enxame->dimensions, 1, &aptidao);
+    return aptidao;
+}
+
+// Atualiza velocidade
+void atualizarVelocidade(Swarm *enxame, double w, double c1, double c2) {
+    for (int d = 0; d < enxame->dimensions; d++) {
+        double *velocidade = &COORD(enxame, velocity, d, 0);
+        const double *posicao = &COORD(enxame, position, d, 0);
+        const double *melhor = &COORD(enxame, bestPosition, d, 0);
+        double *r1 = &COORD(enxame, r1, d, 0);
+        double *r2 = &COORD(enxame, r2, d, 0);
+        double global = enxame->globalBestPosition[d];
+
+        // sorteia r1 e r2 da dimensão inteira de uma vez; o laço abaixo fica só com multiplica-soma
+        gerarUniformes(&enxame->gerador, r1, enxame->numParticles);
+        gerarUniformes(&enxame->gerador, r2, enxame->numParticles);
+        for (int i = 0; i < enxame->numParticles; i++) {
+            velocidade[i] = w * velocidade[i] +
+                            c1 * r1[i] * (melhor[i] - posicao[i]) +
+                            c2 * r2[i] * (global - posicao[i]);
+        }
+    }
+}
+
+Fronteira fronteiraDosParametros(const ParametrosPSO *parametros) {
+    Fronteira fronteira;
+    fronteira.politica = parametros->fronteira;
+    fronteira.posMin = parametros->posMin;
+    fronteira.posMax = parametros->posMax;
+    fronteira.limiteVelocidade = parametros->limitarVelocidade ? parametros->velMax : INFINITY;
+    return fronteira;
+}
+
+// Atualiza posição
+void atualizarPosicao(Swarm *enxame, const Fronteira *fronteira) {
+    for (int d = 0; d < enxame->dimensions; d++) {
+        double *posicao = &COORD(enxame, position, d, 0);
+        double *velocidade = &COORD(enxame, velocity, d, 0);
+        double *sorteio = &COORD(enxame, r1, d, 0);
+
+        // o r1 da dimensão já foi usado pela velocidade: serve de rascunho para os reinícios
+        if (fronteira->politica == FRONTEIRA_REINICIAR) {
+            gerarUniformes(&enxame->gerador, sorteio, enxame->numParticles);
+        }
+        moverLinha(fronteira, posicao, velocidade, sorteio, enxame->numParticles);
+    }
+}
+
+// Avalia as partículas [inicio, inicio + n); com o modelo substituto, as previstas piores que o
+// próprio pBest ficam com a previsão (que não muda pBest nem gBest). Retorna as avaliações de fato:
+// descartes do modelo e acertos do cache não gastam o orçamento de avaliações.
+static inline int avaliarParticulas(Swarm *enxame, int inicio, int n) {
+    if (enxame->objetivo.substituto != NULL) {
+        return avaliarComSubstituto(enxame->objetivo.substituto, &enxame->objetivo, &COORD(enxame, position, 0, inicio), enxame->stride, n,
+                                    &enxame->bestFitness[inicio], &enxame->fitness[inicio]);
+    }
+    return avaliarObjetivo(&enxame->objetivo, &COORD(enxame, position, 0, inicio), enxame->stride, enxame->dimensions, n, &enxame->fitness[inicio]);
+}
+
+// Avalia a função objetivo em todas as partículas
+static void avaliarEnxame(Swarm *enxame) {
+    enxame->avaliacoes += avaliarParticulas(enxame, 0, enxame->numParticles);
+}
+
+// Atualiza pBest e gBest com as aptidões já avaliadas
+static void atualizarMelhoresAvaliadas(Swarm *enxame) {
+    for (int i = 0; i < enxame->numParticles; i++) {
+        double aptidao = enxame->fitness[i];
+        if (aptidao < enxame->bestFitness[i]) {
+            enxame->bestFitness[i] = aptidao;
+            for (int d = 0; d < enxame->dimensions; d++) {
+                COORD(enxame, bestPosition, d, i) = COORD(enxame, position, d, i);
+            }
+        }
+        if (aptidao < enxame->globalBestFitness) {
+            enxame->globalBestFitness = aptidao;
+            for (int d = 0; d < enxame->dimensions; d++) {
+                enxame->globalBestPosition[d] = COORD(enxame, position, d, i);
+            }
+        }
+    }
+}
+
+// Atualiza melhores posições
+void atualizarMelhoresPosicoes(Swarm *enxame) {
+    avaliarEnxame(enxame);
+    atualizarMelhoresAvaliadas(enxame);
+}
+
+// Executa PSO
+double executarPSO(Swarm *enxame, int iteracoes, double w, double c1, double c2, double posMin, double posMax) {
+    ParametrosPSO parametros = parametrosPadrao();
+    parametros.iteracoes = iteracoes;
+    parametros.dimensoes = enxame->dimensions;
+    parametros.w = w;
+    parametros.c1 = c1;
+    parametros.c2 = c2;
+    parametros.posMin = posMin;
+    parametros.posMax = posMax;
+    return executarPSOConfigurado(enxame, &parametros, NULL);
+}
+
+// ========== Motor fundido ===========
+
+// Copia a posição da partícula i para o gBest
+static void copiarMelhorGlobal(Swarm *enxame, int i) {
+    enxame->globalBestFitness = enxame->fitness[i];
+    for (int d = 0; d < enxame->dimensions; d++) {
+        enxame->globalBestPosition[d] = COORD(enxame, position, d, i);
+    }
+}
+
+// Faz todas as etapas da iteração no bloco [inicio, fim) e devolve o índice da melhor aptidão do bloco.
+// Sempre inline: nas versões com dimensão constante (abaixo) os laços por dimensão são desenrolados.
+static inline __attribute__((always_inline))
+int iterarBloco(Swarm *enxame, const ParametrosPSO *parametros, int inicio, int fim, int dimensoes) {
+    int n = fim - inicio;
+    int melhorIndice = inicio;
+    Fronteira fronteira = fronteiraDosParametros(parametros);
+
+    for (int d = 0; d < dimensoes; d++) {
+        double *posicao = &COORD(enxame, position, d, inicio);
+        double *velocidade = &COORD(enxame, velocity, d, inicio);
+        const double *melhor = &COORD(enxame, bestPosition, d, inicio);
+        double *r1 = &COORD(enxame, r1, d, inicio);
+        double *r2 = &COORD(enxame, r2, d, inicio);
+        double global = enxame->globalBestPosition[d];
+
+        gerarUniformes(&enxame->gerador, r1, n);
+        gerarUniformes(&enxame->gerador, r2, n);
+        for (int i = 0; i < n; i++) {
+            velocidade[i] = parametros->w * velocidade[i] +
+                            parametros->c1 * r1[i] * (melhor[i] - posicao[i]) +
+                            parametros->c2 * r2[i] * (global - posicao[i]);
+        }
+        // a linha do bloco ainda está na L1; os reinícios sorteiam no r1 já usado
+        if (fronteira.politica == FRONTEIRA_REINICIAR) {
+            gerarUniformes(&enxame->gerador, r1, n);
+        }
+        moverLinha(&fronteira, posicao, velocidade, r1, n);
+    }
+
+    // o bloco ainda está na cache: avalia e atualiza os pBest sem nova passada pelo enxame
+    enxame->avaliacoes += avaliarParticulas(enxame, inicio, n);
+    for (int i = inicio; i < fim; i++) {
+        double aptidao = enxame->fitness[i];
+        if (aptidao < enxame->bestFitness[i]) {
+            enxame->bestFitness[i] = aptidao;
+            for (int d = 0; d < dimensoes; d++) {
+                COORD(enxame, bestPosition, d, i) = COORD(enxame, position, d, i);
+            }
+        }
+        if (aptidao < enxame->fitness[melhorIndice]) {
+            melhorIndice = i;
+        }
+    }
+    return melhorIndice;
+}
+
+typedef int (*IteracaoDeBloco)(Swarm *enxame, const ParametrosPSO *parametros, int inicio, int fim);
+
+// Versões do bloco especializadas para as dimensões mais usadas
+#define DEFINIR_ITERACAO(DIM) \
+    static int iterarBloco##DIM(Swarm *enxame, const ParametrosPSO *parametros, int inicio, int fim) { \
+        return iterarBloco(enxame, parametros, inicio, fim, DIM); \
+    }
+
+DEFINIR_ITERACAO(2)
+DEFINIR_ITERACAO(10)
+DEFINIR_ITERACAO(30)
+
+static int iterarBlocoN(Swarm *enxame, const ParametrosPSO *parametros, int inicio, int fim) {
+    return iterarBloco(enxame, parametros, inicio, fim, enxame->dimensions);
+}
+
+// Escolhe a versão do bloco uma vez por execução
+static IteracaoDeBloco iteracaoParaDimensao(int dimensoes) {
+    switch (dimensoes) {
+        case 2: return iterarBloco2;
+        case 10: return iterarBloco10;
+        case 30: return iterarBloco30;
+        default: return iterarBlocoN;
+    }
+}
+
+// Uma iteração do motor fundido, bloco a bloco
+static void iteracaoFundida(Swarm *enxame, const ParametrosPSO *parametros, IteracaoDeBloco iterar) {
+    int bloco = parametros->tamanhoBloco > 0 ? parametros->tamanhoBloco : TAMANHO_BLOCO_PADRAO;
+    int assincrono = parametros->modoGBest == GBEST_ASSINCRONO;
+    int melhorIndice = -1;
+    double melhorAptidao = enxame->globalBestFitness;
+
+    for (int inicio = 0; inicio < enxame->numParticles; inicio += bloco) {
+        int fim = inicio + bloco < enxame->numParticles ? inicio + bloco : enxame->numParticles;
+        int i = iterar(enxame, parametros, inicio, fim);
+
+        // o gBest é reduzido uma vez por bloco, não escrito a cada partícula
+        if (enxame->fitness[i] < melhorAptidao) {
+            melhorAptidao = enxame->fitness[i];
+            melhorIndice = i;
+            if (assincrono) {
+                copiarMelhorGlobal(enxame, i);
+            }
+        }
+    }
+    if (!assincrono && melhorIndice >= 0) {
+        copiarMelhorGlobal(enxame, melhorIndice);
+    }
+}
+
+double executarPSOFundido(Swarm *enxame, const ParametrosPSO *parametros) {
+    ParametrosPSO fundido = *parametros;
+    fundido.motor = MOTOR_FUNDIDO;
+    return executarPSOConfigurado(enxame, &fundido, NULL);
+}
+
+// ========== Motor paralelo ===========
+
+// Estado de uma iteração paralela compartilhado pelas tarefas
+typedef struct {
+    Swarm *enxame;
+    const ParametrosPSO *parametros;
+    int grao;
+    int *melhorDoGrao; // Partícula de menor aptidão de cada grão (a primeira em caso de empate)
+    Fronteira fronteira;
+    double *sorteio;   // Uniformes dos reinícios na fronteira [dimensoes][stride] (NULL = outra política)
+} IteracaoParalela;
+
+// Move, avalia e atualiza os pBest de um grão; o gBest não é tocado (só a junção o escreve)
+static void iterarGrao(int tarefa, int trabalhador, void *contexto) {
+    IteracaoParalela *iteracao = (IteracaoParalela *)contexto;
+    Swarm *enxame = iteracao->enxame;
+    const ParametrosPSO *parametros = iteracao->parametros;
+    int inicio = tarefa * iteracao->grao;
+    int fim = inicio + iteracao->grao < enxame->numParticles ? inicio + iteracao->grao : enxame->numParticles;
+    int melhorIndice = inicio;
+    (void)trabalhador;
+
+    for (int d = 0; d < enxame->dimensions; d++) {
+        double *posicao = &COORD(enxame, position, d, 0);
+        double *velocidade = &COORD(enxame, velocity, d, 0);
+        const double *melhor = &COORD(enxame, bestPosition, d, 0);
+        const double *r1 = &COORD(enxame, r1, d, 0);
+        const double *r2 = &COORD(enxame, r2, d, 0);
+        const double *sorteio = iteracao->sorteio != NULL ? &iteracao->sorteio[(size_t)d * enxame->stride + inicio] : NULL;
+        double global = enxame->globalBestPosition[d];
+
+        for (int i = inicio; i < fim; i++) {
+            velocidade[i] = parametros->w * velocidade[i] +
+                            parametros->c1 * r1[i] * (melhor[i] - posicao[i]) +
+                            parametros->c2 * r2[i] * (global - posicao[i]);
+        }
+        moverLinha(&iteracao->fronteira, &posicao[inicio], &velocidade[inicio], sorteio, fim - inicio);
+    }
+
+    // os grãos somam ao mesmo contador: a soma não depende da ordem em que terminam
+    int reais = avaliarObjetivo(&enxame->objetivo, &COORD(enxame, position, 0, inicio), enxame->stride, enxame->dimensions, fim - inicio, &enxame->fitness[inicio]);
+    __atomic_fetch_add(&enxame->avaliacoes, (long long)reais, __ATOMIC_RELAXED);
+    for (int i = inicio; i < fim; i++) {
+        double aptidao = enxame->fitness[i];
+        if (aptidao < enxame->bestFitness[i]) {
+            enxame->bestFitness[i] = aptidao;
+            for (int d = 0; d < enxame->dimensions; d++) {
+                COORD(enxame, bestPosition, d, i) = COORD(enxame, position, d, i);
+            }
+        }
+        if (aptidao < enxame->fitness[melhorIndice]) {
+            melhorIndice = i;
+        }
+    }
+    iteracao->melhorDoGrao[tarefa] = melhorIndice;
+}
+
+// Uma iteração do motor paralelo
+static void iteracaoParalela(Swarm *enxame, const ParametrosPSO *parametros, IteracaoParalela *iteracao) {
+    int numGraos = (enxame->numParticles + iteracao->grao - 1) / iteracao->grao;
+    int melhorIndice = -1;
+    double melhorAptidao = enxame->globalBestFitness;
+
+    // sorteios na thread chamadora, na ordem do motor clássico: o fluxo não depende da divisão em grãos
+    for (int d = 0; d < enxame->dimensions; d++) {
+        gerarUniformes(&enxame->gerador, &COORD(enxame, r1, d, 0), enxame->numParticles);
+        gerarUniformes(&enxame->gerador, &COORD(enxame, r2, d, 0), enxame->numParticles);
+    }
+    if (iteracao->sorteio != NULL) {
+        for (int d = 0; d < enxame->dimensions; d++) {
+            gerarUniformes(&enxame->gerador, &iteracao->sorteio[(size_t)d * enxame->stride], enxame->numParticles);
+        }
+    }
+
+    if (parametros->grupo != NULL) {
+        executarNoGrupo(parametros->grupo, numGraos, iterarGrao, iteracao);
+    } else {
+        for (int g = 0; g < numGraos; g++) {
+            iterarGrao(g, 0, iteracao);
+        }
+    }
+
+    // junção dos mínimos em ordem de grão: o mesmo gBest que a varredura serial escolheria
+    for (int g = 0; g < numGraos; g++) {
+        int i = iteracao->melhorDoGrao[g];
+        if (enxame->fitness[i] < melhorAptidao) {
+            melhorAptidao = enxame->fitness[i];
+            melhorIndice = i;
+        }
+    }
+    if (melhorIndice >= 0) {
+        copiarMelhorGlobal(enxame, melhorIndice);
+    }
+}
+
+double executarPSOParalelo(Swarm *enxame, const ParametrosPSO *parametros) {
+    ParametrosPSO paralelo = *parametros;
+    paralelo.motor = MOTOR_PARALELO;
+    return executarPSOConfigurado(enxame, &paralelo, NULL);
+}
+
+int motorPorNome(const char *nome, TipoMotor *motor) {
+    if (strcmp(nome, "classico") == 0) {
+        *motor = MOTOR_CLASSICO;
+        return 1;
+    }
+    if (strcmp(nome, "fundido") == 0) {
+        *motor = MOTOR_FUNDIDO;
+        return 1;
+    }
+    if (strcmp(nome, "paralelo") == 0) {
+        *motor = MOTOR_PARALELO;
+        return 1;
+    }
+    return 0;
+}
+
+const char *nomesMotores(void) {
+    return "classico, fundido, paralelo";
+}
+
+// ========== Critérios de parada ===========
+
+// Estado dos critérios ao longo de uma execução
+typedef struct {
+    double inicio;         // Instante de início (só com orçamento de tempo)
+    double ultimoMelhor;   // gBest da última melhora
+    int semMelhora;        // Iterações seguidas sem melhorar o gBest
+} ControleParada;
+
+// Maior distância de uma partícula ao gBest
+static double raioDoEnxame(const Swarm *enxame) {
+    double maior = 0.0;
+    for (int i = 0; i < enxame->numParticles; i++) {
+        double quadrado = 0.0;
+        for (int d = 0; d < enxame->dimensions; d++) {
+            double diferenca = COORD(enxame, position, d, i) - enxame->globalBestPosition[d];
+            quadrado += diferenca * diferenca;
+        }
+        maior = quadrado > maior ? quadrado : maior;
+    }
+    return sqrt(maior);
+}
+
+// Maior norma de velocidade entre as partículas
+static double velocidadeDoEnxame(const Swarm *enxame) {
+    double maior = 0.0;
+    for (int i = 0; i < enxame->numParticles; i++) {
+        double quadrado = 0.0;
+        for (int d = 0; d < enxame->dimensions; d++) {
+            double v = COORD(enxame, velocity, d, i);
+            quadrado += v * v;
+        }
+        maior = quadrado > maior ? quadrado : maior;
+    }
+    return sqrt(maior);
+}
+
+// Verifica os critérios ligados; os mais baratos primeiro
+static CriterioParada verificarParada(const Swarm *enxame, const ParametrosPSO *parametros, const ControleParada *controle) {
+    const CriteriosParada *criterios = &parametros->parada;
+
+    if (!isnan(criterios->alvo) && enxame->globalBestFitness <= criterios->alvo) {
+        return PARADA_ALVO;
+    }
+    if (criterios->estagnacao > 0 && controle->semMelhora >= criterios->estagnacao) {
+        return PARADA_ESTAGNACAO;
+    }
+    if (criterios->avaliacoesMaximas > 0 && enxame->avaliacoes + enxame->numParticles > criterios->avaliacoesMaximas) {
+        return PARADA_AVALIACOES;
+    }
+    if (criterios->tempoMaximo > 0 && tempoAtual() - controle->inicio >= criterios->tempoMaximo) {
+        return PARADA_TEMPO;
+    }
+    if (criterios->raioMinimo > 0 && raioDoEnxame(enxame) < criterios->raioMinimo) {
+        return PARADA_RAIO;
+    }
+    if (criterios->velocidadeMinima > 0 && velocidadeDoEnxame(enxame) < criterios->velocidadeMinima) {
+        return PARADA_VELOCIDADE;
+    }
+    return PARADA_NENHUMA;
+}
+
+// Estado dos reinícios ao longo de uma execução
+typedef struct {
+    ArquivoElite *elite;   // NULL = reinícios desligados
+    double melhor;         // gBest desde o último reinício
+    int semMelhora;        // Iterações seguidas sem melhorar esse gBest
+} ControleReinicio;
+
+// Reinicia o enxame (ou parte dele) dentro da arena se ele estagnou ou encolheu demais;
+// o gBest vai antes para o arquivo de elite. No reinício inteiro a estagnação da parada
+// passa a contar do gBest novo, como numa execução que começa agora.
+static void reiniciarSeEstagnado(Swarm *enxame, const ParametrosPSO *parametros, ControleReinicio *controle, ControleParada *parada) {
+    const PoliticaReinicio *politica = &parametros->reinicio;
+    long long maximas = parametros->parada.avaliacoesMaximas;
+
+    if (enxame->globalBestFitness < controle->melhor) {
+        controle->melhor = enxame->globalBestFitness;
+        controle->semMelhora = 0;
+    } else {
+        controle->semMelhora++;
+    }
+    int estagnou = politica->estagnacao > 0 && controle->semMelhora >= politica->estagnacao;
+    if (!estagnou && !(politica->diametro > 0 && raioDoEnxame(enxame) < politica->diametro * (parametros->posMax - parametros->posMin))) {
+        return;
+    }
+    // o reinício do enxame inteiro avalia as partículas novas: só se couber no orçamento de avaliações
+    int inteiro = ceil(politica->fracao * enxame->numParticles) >= enxame->numParticles;
+    if (inteiro && maximas > 0 && enxame->avaliacoes + 2LL * enxame->numParticles > maximas) {
+        return;
+    }
+
+    arquivarMelhor(controle->elite, enxame);
+    if (reiniciarParticulas(enxame, politica->fracao, parametros->posMin, parametros->posMax, parametros->velMax) == enxame->numParticles) {
+        atualizarMelhoresPosicoes(enxame);
+        parada->ultimoMelhor = enxame->globalBestFitness;
+        parada->semMelhora = 0;
+    }
+    controle->melhor = enxame->globalBestFitness;
+    controle->semMelhora = 0;
+}
+
+// Salva o estado entre iterações quando o intervalo do ponto de salvamento tiver passado
+static void salvarSeDevido(PontoSalvamento *salvamento, const Swarm *enxame, int iter, const ControleParada *controle) {
+    double agora = tempoAtual();
+    if (agora < salvamento->proximo) {
+        return;
+    }
+    ProgressoPSO progresso;
+    progresso.iteracao = iter;
+    progresso.semMelhora = controle->semMelhora;
+    progresso.ultimoMelhor = controle->ultimoMelhor;
+    salvamento->salvar(salvamento, enxame, &progresso);
+    salvamento->proximo = agora + salvamento->intervalo;
+}
+
+const char *nomeCriterio(CriterioParada criterio) {
+    static const char *NOMES[] = {"nenhum", "iteracoes", "alvo", "estagnacao", "raio", "velocidade", "tempo", "avaliacoes"};
+    return NOMES[criterio];
+}
+
+double executarPSOConfigurado(Swarm *enxame, const ParametrosPSO *parametros, ResultadoPSO *resultado) {
+    IteracaoDeBloco iterar = iteracaoParaDimensao(enxame->dimensions);
+    IteracaoParalela paralela;
+    Topologia propria;
+    Topologia *vizinhanca = NULL;
+    ArquivoElite elitePropria;
+    ControleReinicio reinicio;
+    CriterioParada criterio;
+    ControleParada controle;
+    int iter = 0;
+
+    Fronteira fronteira = fronteiraDosParametros(parametros);
+    // cópia dos parâmetros com os coeficientes da iteração: a agenda só escreve w, c1 e c2 nela
+    ParametrosPSO atual = *parametros;
+    Coeficientes base = {parametros->w, parametros->c1, parametros->c2};
+
+    // um índice de mínimo por grão (e os sorteios dos reinícios), alocados uma vez por execução
+    paralela.melhorDoGrao = NULL;
+    paralela.sorteio = NULL;
+    if (parametros->motor == MOTOR_PARALELO) {
+        paralela.enxame = enxame;
+        paralela.parametros = &atual;
+        paralela.grao = parametros->grao > 0 ? parametros->grao : GRAO_PADRAO;
+        paralela.fronteira = fronteira;
+        paralela.melhorDoGrao = (int *)malloc(((size_t)enxame->numParticles / paralela.grao + 1) * sizeof(int));
+        if (parametros->fronteira == FRONTEIRA_REINICIAR) {
+            paralela.sorteio = (double *)malloc((size_t)enxame->dimensions * enxame->stride * sizeof(double));
+        }
+        if (paralela.melhorDoGrao == NULL || (parametros->fronteira == FRONTEIRA_REINICIAR && paralela.sorteio == NULL)) {
+            printf("Erro ao alocar o motor paralelo\n");
+            exit(1);
+        }
+    }
+
+    // topologia local: a tabela é montada para este enxame e os líderes saem dos pBest iniciais
+    if (parametros->topologia != TOPOLOGIA_GLOBAL) {
+        memset(&propria, 0, sizeof(propria));
+        vizinhanca = parametros->vizinhanca != NULL ? parametros->vizinhanca : &propria;
+        montarTopologia(vizinhanca, parametros->topologia, parametros->vizinhosAleatorios, enxame);
+        atualizarLideres(vizinhanca, enxame);
+    }
+
+    // reinícios: o arquivo de elite guarda os gBest de antes de cada reinício
+    reinicio.elite = NULL;
+    reinicio.melhor = enxame->globalBestFitness;
+    reinicio.semMelhora = 0;
+    if (parametros->reinicio.estagnacao > 0 || parametros->reinicio.diametro > 0) {
+        memset(&elitePropria, 0, sizeof(elitePropria));
+        reinicio.elite = parametros->elite != NULL ? parametros->elite : &elitePropria;
+        prepararElite(reinicio.elite, ELITE_PADRAO, enxame->dimensions);
+    }
+
+    controle.inicio = parametros->parada.tempoMaximo > 0 ? tempoAtual() : 0.0;
+    controle.ultimoMelhor = enxame->globalBestFitness;
+    controle.semMelhora = 0;
+    // continuação de um salvamento: o enxame já foi restaurado, falta o progresso
+    if (parametros->salvamento != NULL && parametros->salvamento->retomar != NULL) {
+        iter = parametros->salvamento->retomar->iteracao;
+        controle.ultimoMelhor = parametros->salvamento->retomar->ultimoMelhor;
+        controle.semMelhora = parametros->salvamento->retomar->semMelhora;
+    }
+
+    INSTRUMENTAR_EXECUCAO_INICIO(parametros->instrumentacao);
+    for (;;) {
+        INSTRUMENTAR_FASE(parametros->instrumentacao, FASE_PARADA, criterio = verificarParada(enxame, parametros, &controle));
+        if (criterio != PARADA_NENHUMA) {
+            break;
+        }
+        if (iter >= parametros->iteracoes) {
+            criterio = PARADA_ITERACOES;
+            break;
+        }
+        // a agenda adaptativa lê o sucesso direto das aptidões do enxame: continua igual após uma retomada
+        if (parametros->agenda.tipo != AGENDA_FIXA) {
+            double sucesso = parametros->agenda.tipo == AGENDA_ADAPTATIVA
+                           ? taxaDeSucesso(enxame->fitness, enxame->bestFitness, enxame->numParticles, 1) : 0.0;
+            Coeficientes coeficientes = coeficientesDaIteracao(&parametros->agenda, base, iter, parametros->iteracoes, sucesso);
+            atual.w = coeficientes.w;
+            atual.c1 = coeficientes.c1;
+            atual.c2 = coeficientes.c2;
+        }
+
+        if (vizinhanca != NULL) {
+            INSTRUMENTAR_FASE(parametros->instrumentacao, FASE_VELOCIDADE, atualizarVelocidadeLocal(enxame, vizinhanca, atual.w, atual.c1, atual.c2));
+            INSTRUMENTAR_FASE(parametros->instrumentacao, FASE_POSICAO, atualizarPosicao(enxame, &fronteira));
+            INSTRUMENTAR_FASE(parametros->instrumentacao, FASE_AVALIACAO, avaliarEnxame(enxame));
+            INSTRUMENTAR_FASE(parametros->instrumentacao, FASE_MELHORES, atualizarMelhoresAvaliadas(enxame));
+        } else if (parametros->motor == MOTOR_FUNDIDO) {
+            INSTRUMENTAR_FASE(parametros->instrumentacao, FASE_FUNDIDA, iteracaoFundida(enxame, &atual, iterar));
+        } else if (parametros->motor == MOTOR_PARALELO) {
+            INSTRUMENTAR_FASE(parametros->instrumentacao, FASE_FUNDIDA, iteracaoParalela(enxame, &atual, &paralela));
+        } else {
+            INSTRUMENTAR_FASE(parametros->instrumentacao, FASE_VELOCIDADE, atualizarVelocidade(enxame, atual.w, atual.c1, atual.c2));
+            INSTRUMENTAR_FASE(parametros->instrumentacao, FASE_POSICAO, atualizarPosicao(enxame, &fronteira));
+            INSTRUMENTAR_FASE(parametros->instrumentacao, FASE_AVALIACAO, avaliarEnxame(enxame));
+            INSTRUMENTAR_FASE(parametros->instrumentacao, FASE_MELHORES, atualizarMelhoresAvaliadas(enxame));
+        }
+        iter++;
+        TELEMETRIA_REGISTRAR(parametros->telemetria, enxame);
+
+        if (enxame->globalBestFitness < controle.ultimoMelhor) {
+            controle.ultimoMelhor = enxame->globalBestFitness;
+            controle.semMelhora = 0;
+        } else {
+            controle.semMelhora++;
+            // sem melhora do gBest a topologia aleatória é religada (adaptativa, como no SPSO 2011)
+            if (vizinhanca != NULL) {
+                religarTopologia(vizinhanca, enxame);
+            }
+        }
+        if (reinicio.elite != NULL) {
+            reiniciarSeEstagnado(enxame, parametros, &reinicio, &controle);
+        }
+        // os imigrantes entram como pBest: os líderes da topologia local já os enxergam
+        if (parametros->migracao != NULL && iter % parametros->migracao->intervalo == 0) {
+            parametros->migracao->migrar(parametros->migracao, enxame, iter);
+        }
+        if (vizinhanca != NULL) {
+            INSTRUMENTAR_FASE(parametros->instrumentacao, FASE_MELHORES, atualizarLideres(vizinhanca, enxame));
+        }
+
+        if (parametros->salvamento != NULL && iter % ITERACOES_ENTRE_SALVAMENTOS == 0) {
+            salvarSeDevido(parametros->salvamento, enxame, iter, &controle);
+        }
+    }
+
+    INSTRUMENTAR_EXECUCAO_FIM(parametros->instrumentacao);
+    free(paralela.melhorDoGrao);
+    free(paralela.sorteio);
+    if (vizinhanca == &propria) {
+        liberarTopologia(&propria);
+    }
+    // o resultado é o melhor de todos os reinícios
+    if (reinicio.elite != NULL) {
+        arquivarMelhor(reinicio.elite, enxame);
+        if (reinicio.elite->tamanho > 0 && reinicio.elite->aptidoes[0] < enxame->globalBestFitness) {
+            enxame->globalBestFitness = reinicio.elite->aptidoes[0];
+            memcpy(enxame->globalBestPosition, reinicio.elite->posicoes, (size_t)enxame->dimensions * sizeof(double));
+        }
+        if (reinicio.elite == &elitePropria) {
+            liberarElite(&elitePropria);
+        }
+    }
+
+    if (resultado != NULL) {
+        resultado->melhor = enxame->globalBestFitness;
+        resultado->iteracoes = iter;
+        resultado->avaliacoes = enxame->avaliacoes;
+        resultado->criterio = criterio;
+    }
+    return enxame->globalBestFitness;
+}
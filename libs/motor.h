@@ -0,0 +1,186 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef MOTOR_H
+#define MOTOR_H
+#include "enxame.h"
+#include "eggholder.h"
+#include "objetivos.h"
+#include "telemetria.h"
+#include "instrumentacao.h"
+#include "agendador.h"
+#include "topologia.h"
+#include "fronteira.h"
+#include "coeficientes.h"
+#include "reinicio.h"
+#include "migracao.h"
+
+// Partículas por bloco do motor fundido (o bloco inteiro cabe na cache L1/L2)
+#define TAMANHO_BLOCO_PADRAO 256
+
+// Partículas por tarefa do motor paralelo (grão); com objetivos caros vale usar grãos pequenos
+#define GRAO_PADRAO 64
+
+// Motores de iteração disponíveis
+typedef enum {
+   MOTOR_CLASSICO, // Três passadas por iteração: velocidade, posição, avaliação
+   MOTOR_FUNDIDO,  // Uma passada por bloco de partículas com todas as etapas
+   MOTOR_PARALELO  // Partículas divididas em grãos entre as threads de um grupo
+} TipoMotor;
+
+// Quando o gBest encontrado numa iteração passa a valer para as outras partículas
+typedef enum {
+   GBEST_SINCRONO,  // Só na iteração seguinte (semântica do motor clássico)
+   GBEST_ASSINCRONO // Logo após o bloco que o encontrou
+} ModoGBest;
+
+// Critérios de parada além do número de iterações (cada um desligado com o valor indicado)
+typedef struct {
+   double alvo;                 // Para quando o gBest for <= alvo (NAN = desligado)
+   int estagnacao;              // Para após K iterações sem melhorar o gBest (0 = desligado)
+   double raioMinimo;           // Para quando a maior distância ao gBest ficar abaixo (0 = desligado)
+   double velocidadeMinima;     // Para quando a maior norma de velocidade ficar abaixo (0 = desligado)
+   double tempoMaximo;          // Orçamento de tempo de parede em segundos (0 = desligado)
+   long long avaliacoesMaximas; // Orçamento de avaliações da função objetivo (0 = desligado)
+} CriteriosParada;
+
+// Critério que encerrou a execução
+typedef enum {
+   PARADA_NENHUMA,
+   PARADA_ITERACOES,
+   PARADA_ALVO,
+   PARADA_ESTAGNACAO,
+   PARADA_RAIO,
+   PARADA_VELOCIDADE,
+   PARADA_TEMPO,
+   PARADA_AVALIACOES
+} CriterioParada;
+
+// Resumo de uma execução
+typedef struct {
+   double melhor;           // Melhor aptidão (gBest)
+   int iteracoes;           // Iterações executadas
+   long long avaliacoes;    // Avaliações da função objetivo, incluindo as da inicialização
+   CriterioParada criterio; // Critério que encerrou a execução
+} ResultadoPSO;
+
+// Progresso de uma execução entre duas iterações: com o enxame, é tudo o que a continuação precisa
+typedef struct {
+   int iteracao;          // Iterações já feitas
+   int semMelhora;        // Iterações seguidas sem melhorar o gBest
+   double ultimoMelhor;   // gBest da última melhora
+} ProgressoPSO;
+
+// Ponto de salvamento consultado pelo motor entre iterações
+typedef struct PontoSalvamento {
+   double intervalo;      // Segundos entre salvamentos
+   double proximo;        // Instante do próximo salvamento
+   void (*salvar)(struct PontoSalvamento *ponto, const Swarm *enxame, const ProgressoPSO *progresso);
+   void *contexto;        // Dono do ponto (o arquivo de retomada)
+   const ProgressoPSO *retomar; // Progresso de onde a execução continua (NULL = do início)
+} PontoSalvamento;
+
+// O relógio só é lido a cada tantas iterações para decidir se é hora de salvar
+#define ITERACOES_ENTRE_SALVAMENTOS 16
+
+// Ponto de migração consultado pelo motor a cada intervalo iterações (modelo de ilhas): migrar
+// manda os melhores do enxame para as outras ilhas e põe os que chegaram no lugar dos piores
+typedef struct PontoMigracao {
+   int intervalo;         // Iterações entre migrações
+   void (*migrar)(struct PontoMigracao *ponto, Swarm *enxame, int iteracao);
+   void *contexto;        // Dono do ponto (o modelo de ilhas)
+} PontoMigracao;
+
+// Parâmetros de uma execução do PSO
+typedef struct {
+   int iteracoes;       // Número máximo de iterações
+   int dimensoes;       // Dimensão do espaço de busca
+   double w, c1, c2;    // Inércia e coeficientes de aceleração (os da agenda fixa)
+   AgendaCoeficientes agenda; // Variação de w, c1 e c2 ao longo das iterações
+   double posMin;       // Limite inferior do espaço de busca
+   double posMax;       // Limite superior do espaço de busca
+   double velMax;       // Velocidade máxima na inicialização (e em todo passo com limitarVelocidade)
+   PoliticaFronteira fronteira; // O que acontece com a coordenada que sai do domínio
+   int limitarVelocidade; // 1 = |v| <= velMax em cada coordenada a cada passo
+   TipoMotor motor;     // Motor de iteração
+   ModoGBest modoGBest; // Semântica do gBest no motor fundido
+   int tamanhoBloco;    // Partículas por bloco no motor fundido
+   int grao;            // Partículas por tarefa no motor paralelo
+   GrupoTrabalho *grupo; // Threads do motor paralelo (NULL = roda na thread chamadora)
+   Objetivo objetivo;   // Função objetivo resolvida para a dimensão
+   Telemetria *telemetria; // Histórico de convergência da execução (NULL = desligado)
+   Instrumentacao *instrumentacao; // Tempo por fase do trabalhador (NULL = desligado)
+   CriteriosParada parada; // Critérios de parada antecipada
+   PontoSalvamento *salvamento; // Salvamento periódico do estado (NULL = desligado)
+   TipoTopologia topologia; // Vizinhança da componente social (as locais usam o motor clássico)
+   int vizinhosAleatorios; // k da topologia aleatória
+   Topologia *vizinhanca; // Tabela reaproveitada entre execuções (NULL = alocada na execução)
+   PoliticaReinicio reinicio; // Reinícios dentro da arena quando o enxame estagna
+   ArquivoElite *elite; // Melhores soluções entre reinícios, reaproveitado (NULL = alocado na execução)
+   PoliticaMigracao ilhas; // Modelo de ilhas da execução (quem divide o enxame é o executarIlhas)
+   PontoMigracao *migracao; // Troca de partículas com as outras ilhas (NULL = enxame isolado)
+} ParametrosPSO;
+
+
+// Parâmetros do trabalho: 2D em [-512, 512], w = 0.5, c1 = c2 = 1.5, velocidade inicial de 15%
+ParametrosPSO parametrosPadrao(void);
+
+
+// Sorteia as posições e velocidades iniciais sem avaliá-las (pBest = posição, aptidões = DBL_MAX)
+void sortearEnxame(Swarm *enxame, int numParticulas, int dimensoes, double posMin, double posMax, double velMax);
+
+
+// Inicialização do enxame (uma única arena por enxame)
+void inicializarEnxame(Swarm *enxame, int numParticulas, int dimensoes, double posMin, double posMax, double velMax);
+
+
+// Avalia a aptidão da partícula i
+double avaliarAptidao(const Swarm *enxame, int i);
+
+
+// Atualiza a velocidade de todas as partículas
+void atualizarVelocidade(Swarm *enxame, double w, double c1, double c2);
+
+
+// Limites de movimento dos parâmetros (domínio, política de fronteira e velocidade máxima)
+Fronteira fronteiraDosParametros(const ParametrosPSO *parametros);
+
+
+// Atualiza a posição de todas as partículas dentro dos limites da fronteira
+void atualizarPosicao(Swarm *enxame, const Fronteira *fronteira);
+
+
+// Atualiza as melhores posições e aptidões (individual e global)
+void atualizarMelhoresPosicoes(Swarm *enxame);
+
+
+// Executa o PSO com o motor clássico e os demais parâmetros padrão
+double executarPSO(Swarm *enxame, int iteracoes, double w, double c1, double c2, double posMin, double posMax);
+
+
+// Executa o PSO com o motor fundido: velocidade, posição, avaliação e pBest numa passada por bloco
+double executarPSOFundido(Swarm *enxame, const ParametrosPSO *parametros);
+
+
+// Executa o PSO com o motor paralelo: cada grão de partículas é movido, avaliado e tem o pBest
+// atualizado numa tarefa do grupo; o gBest sai da junção, em ordem, dos mínimos de cada grão.
+// Como r1 e r2 são sorteados antes, na ordem do motor clássico, o resultado não depende do número
+// de threads. Com grão múltiplo de 8 ele é o mesmo do clássico; outros grãos passam mais partículas
+// pela cauda escalar do kernel e podem mudar o último bit das aptidões.
+double executarPSOParalelo(Swarm *enxame, const ParametrosPSO *parametros);
+
+
+// Executa o PSO com o motor escolhido nos parâmetros (o enxame já inicializado)
+// até o limite de iterações ou um critério de parada; resultado pode ser NULL.
+// Com topologia local a iteração é a do motor clássico com o melhor da vizinhança no lugar do gBest.
+// Com reinícios o gBest devolvido é o melhor do arquivo de elite, não só o do último reinício.
+double executarPSOConfigurado(Swarm *enxame, const ParametrosPSO *parametros, ResultadoPSO *resultado);
+
+
+// Motor pelo nome (classico, fundido, paralelo); retorna 0 se o nome não existir
+int motorPorNome(const char *nome, TipoMotor *motor);
+const char *nomesMotores(void);
+
+
+// Nome do critério de parada (como aparece nos resultados)
+const char *nomeCriterio(CriterioParada criterio);
+
+#endif
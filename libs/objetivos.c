@@ -0,0 +1,181 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <math.h>
+#include <string.h>
+#include "objetivos.h"
+#include "eggholder.h"
+
+#define PI 3.14159265358979323846
+
+// ========== Funções por ponto (inline nos kernels) ===========
+
+// Eggholder generalizada: soma da Eggholder 2D sobre pares consecutivos de coordenadas
+static inline double eggholderPonto(const double *x, int n) {
+    double soma = 0.0;
+    for (int i = 0; i + 1 < n; i++) {
+        soma += eggholderRapido(x[i], x[i + 1]);
+    }
+    return soma;
+}
+
+static inline double rastriginPonto(const double *x, int n) {
+    double soma = 10.0 * n;
+    for (int i = 0; i < n; i++) {
+        soma += x[i] * x[i] - 10.0 * cos(2 * PI * x[i]);
+    }
+    return soma;
+}
+
+static inline double rosenbrockPonto(const double *x, int n) {
+    double soma = 0.0;
+    for (int i = 0; i + 1 < n; i++) {
+        double a = x[i + 1] - x[i] * x[i];
+        double b = 1.0 - x[i];
+        soma += 100.0 * a * a + b * b;
+    }
+    return soma;
+}
+
+static inline double ackleyPonto(const double *x, int n) {
+    double quadrados = 0.0, cossenos = 0.0;
+    for (int i = 0; i < n; i++) {
+        quadrados += x[i] * x[i];
+        cossenos += cos(2 * PI * x[i]);
+    }
+    return -20.0 * exp(-0.2 * sqrt(quadrados / n)) - exp(cossenos / n) + 20.0 + 2.71828182845904523536;
+}
+
+static inline double schwefelPonto(const double *x, int n) {
+    double soma = 418.9828872724338 * n;
+    for (int i = 0; i < n; i++) {
+        soma -= x[i] * senoRapido(sqrt(fabs(x[i])));
+    }
+    return soma;
+}
+
+// ========== Geração dos kernels ===========
+
+// Kernel com a dimensão fixa: a cópia para x[DIM] e o laço da função são desenrolados pelo compilador
+#define DEFINIR_KERNEL(nome, DIM) \
+    static void nome##Kernel##DIM(const double *posicao, int stride, int dimensoes, int n, double *saida) { \
+        (void)dimensoes; \
+        for (int i = 0; i < n; i++) { \
+            double x[DIM]; \
+            for (int d = 0; d < DIM; d++) { \
+                x[d] = posicao[(long)d * stride + i]; \
+            } \
+            saida[i] = nome##Ponto(x, DIM); \
+        } \
+    }
+
+// Kernel genérico para qualquer dimensão
+#define DEFINIR_KERNEL_GENERICO(nome) \
+    static void nome##KernelN(const double *posicao, int stride, int dimensoes, int n, double *saida) { \
+        double x[dimensoes]; \
+        for (int i = 0; i < n; i++) { \
+            for (int d = 0; d < dimensoes; d++) { \
+                x[d] = posicao[(long)d * stride + i]; \
+            } \
+            saida[i] = nome##Ponto(x, dimensoes); \
+        } \
+    }
+
+// Para acrescentar uma função: escreva nomePonto(x, n) acima, use DEFINIR_OBJETIVO e inclua na tabela
+#define DEFINIR_OBJETIVO(nome) \
+    DEFINIR_KERNEL(nome, 2) \
+    DEFINIR_KERNEL(nome, 10) \
+    DEFINIR_KERNEL(nome, 30) \
+    DEFINIR_KERNEL_GENERICO(nome)
+
+// a Eggholder 2D usa o kernel SIMD em lote (abaixo), então só gera as outras dimensões
+DEFINIR_KERNEL(eggholder, 10)
+DEFINIR_KERNEL(eggholder, 30)
+DEFINIR_KERNEL_GENERICO(eggholder)
+DEFINIR_OBJETIVO(rastrigin)
+DEFINIR_OBJETIVO(rosenbrock)
+DEFINIR_OBJETIVO(ackley)
+DEFINIR_OBJETIVO(schwefel)
+
+static void eggholderKernelLote(const double *posicao, int stride, int dimensoes, int n, double *saida) {
+    (void)dimensoes;
+    eggholderLote(posicao, posicao + stride, saida, n);
+}
+
+// ========== Tabela de funções ===========
+
+typedef struct {
+    const char *nome;
+    double posMin, posMax, otimo;
+    KernelObjetivo kernel2, kernel10, kernel30, kernelN;
+} EntradaObjetivo;
+
+#define ENTRADA(nome, minimo, maximo, otimo) \
+    {#nome, minimo, maximo, otimo, nome##Kernel2, nome##Kernel10, nome##Kernel30, nome##KernelN}
+
+static const EntradaObjetivo TABELA[] = {
+    {"eggholder", -512, 512, -959.6407, eggholderKernelLote, eggholderKernel10, eggholderKernel30, eggholderKernelN},
+    ENTRADA(rastrigin, -5.12, 5.12, 0.0),
+    ENTRADA(rosenbrock, -5.0, 10.0, 0.0),
+    ENTRADA(ackley, -32.768, 32.768, 0.0),
+    ENTRADA(schwefel, -500, 500, 0.0),
+};
+#define NUM_OBJETIVOS ((int)(sizeof(TABELA) / sizeof(TABELA[0])))
+
+int objetivoPorNome(const char *nome, int dimensoes, Objetivo *objetivo) {
+    for (int i = 0; i < NUM_OBJETIVOS; i++) {
+        const EntradaObjetivo *entrada = &TABELA[i];
+        if (strcmp(entrada->nome, nome) != 0) {
+            continue;
+        }
+        objetivo->nome = entrada->nome;
+        objetivo->posMin = entrada->posMin;
+        objetivo->posMax = entrada->posMax;
+        objetivo->otimo = entrada->otimo;
+        objetivo->cache = NULL;
+        objetivo->substituto = NULL;
+        // o ótimo tabelado da Eggholder só vale em 2D
+        if (i == 0 && dimensoes != 2) {
+            objetivo->otimo = NAN;
+        }
+        switch (dimensoes) {
+            case 2: objetivo->kernel = entrada->kernel2; break;
+            case 10: objetivo->kernel = entrada->kernel10; break;
+            case 30: objetivo->kernel = entrada->kernel30; break;
+            default: objetivo->kernel = entrada->kernelN; break;
+        }
+        return 1;
+    }
+    return 0;
+}
+
+int avaliarComCache(const Objetivo *objetivo, const double *posicao, int stride, int dimensoes, int n, double *saida) {
+    int i = 0, acertos = 0;
+
+    while (i < n) {
+        int inicio = i;
+        while (i < n && !consultarCache(objetivo->cache, &posicao[i], stride, &saida[i])) {
+            i++;
+        }
+        // as faltas seguidas são avaliadas no lugar, sem copiar as coordenadas
+        if (i > inicio) {
+            objetivo->kernel(&posicao[inicio], stride, dimensoes, i - inicio, &saida[inicio]);
+            for (int k = inicio; k < i; k++) {
+                guardarNoCache(objetivo->cache, &posicao[k], stride, saida[k]);
+            }
+        }
+        acertos += i < n;
+        i++;
+    }
+    contarConsultas(objetivo->cache, n, acertos);
+    return n - acertos;
+}
+
+double avaliarPonto(const Objetivo *objetivo, const double *ponto, int dimensoes) {
+    double resultado;
+    // com n = 1 o passo entre coordenadas é 1: o ponto contíguo já está no formato do kernel
+    objetivo->kernel(ponto, 1, dimensoes, 1, &resultado);
+    return resultado;
+}
+
+const char *nomesObjetivos(void) {
+    return "eggholder, rastrigin, rosenbrock, ackley, schwefel";
+}
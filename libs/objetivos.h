@@ -0,0 +1,51 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef OBJETIVOS_H
+#define OBJETIVOS_H
+#include "cache.h"
+
+// Kernel em lote: avalia as n partículas de um bloco dimensão-major
+// (coordenada d da partícula i em posicao[d * stride + i]) e grava em saida[0..n)
+typedef void (*KernelObjetivo)(const double *posicao, int stride, int dimensoes, int n, double *saida);
+
+// Função objetivo já resolvida para uma dimensão
+typedef struct {
+   const char *nome;      // Nome da função
+   double posMin;         // Limite inferior usual do domínio
+   double posMax;         // Limite superior usual do domínio
+   double otimo;          // Valor do mínimo global conhecido (NAN se desconhecido)
+   KernelObjetivo kernel; // Kernel especializado para a dimensão, ou o genérico
+   CacheAptidao *cache;   // Aptidões já calculadas (NULL = toda avaliação chama o kernel)
+   struct ModeloSubstituto *substituto; // Triagem dos candidatos pelo modelo (NULL = todos avaliados; só motores de uma thread)
+} Objetivo;
+
+
+// Resolve a função pelo nome (eggholder, rastrigin, rosenbrock, ackley, schwefel) para a dimensão dada.
+// Dimensões 2, 10 e 30 usam kernels com a dimensão fixa em tempo de compilação.
+// Retorna 0 se o nome não existir.
+int objetivoPorNome(const char *nome, int dimensoes, Objetivo *objetivo);
+
+
+// Avalia as n partículas pelo cache: os trechos de partículas que faltam nele vão juntos para o kernel.
+// Retorna as faltas (as avaliações de fato).
+int avaliarComCache(const Objetivo *objetivo, const double *posicao, int stride, int dimensoes, int n, double *saida);
+
+
+// Avalia as n partículas de um bloco dimensão-major, pelo cache se o objetivo tiver um;
+// retorna quantas chamaram o kernel (os acertos do cache não contam como avaliação)
+static inline int avaliarObjetivo(const Objetivo *objetivo, const double *posicao, int stride, int dimensoes, int n, double *saida) {
+    if (objetivo->cache == NULL) {
+        objetivo->kernel(posicao, stride, dimensoes, n, saida);
+        return n;
+    }
+    return avaliarComCache(objetivo, posicao, stride, dimensoes, n, saida);
+}
+
+
+// Avalia um único ponto (vetor de coordenadas contíguas), sem passar pelo cache
+double avaliarPonto(const Objetivo *objetivo, const double *ponto, int dimensoes);
+
+
+// Lista os nomes das funções disponíveis separados por vírgula
+const char *nomesObjetivos(void);
+
+#endif
@@ -0,0 +1,318 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <float.h>
+#include "plano.h"
+#include "aleatorio.h"
+
+// Maior linha aceita no arquivo do plano
+#define TAMANHO_LINHA 4096
+
+static void definirLista(ListaPlano *lista, const double *valores, int quantidade) {
+    free(lista->valores);
+    lista->valores = (double *)malloc((size_t)(quantidade > 0 ? quantidade : 1) * sizeof(double));
+    if (lista->valores == NULL) {
+        printf("Erro ao alocar o plano\n");
+        exit(1);
+    }
+    memcpy(lista->valores, valores, (size_t)quantidade * sizeof(double));
+    lista->quantidade = quantidade;
+}
+
+void planoPadrao(PlanoExperimento *plano, double w, double c1, double c2, double posMin, double posMax, double velMax) {
+    const double populacoes[] = {50, 100};
+    const double iteracoes[] = {20, 50, 100};
+    const double limites[] = {posMin, posMax};
+
+    memset(plano, 0, sizeof(*plano));
+    definirLista(&plano->populacoes, populacoes, 2);
+    definirLista(&plano->iteracoes, iteracoes, 3);
+    definirLista(&plano->w, &w, 1);
+    definirLista(&plano->c1, &c1, 1);
+    definirLista(&plano->c2, &c2, 1);
+    definirLista(&plano->limites, limites, 2);
+    definirLista(&plano->velMax, &velMax, 1);
+    plano->sementes = NULL;
+    plano->numSementes = 0;
+    plano->replicas = 10;
+}
+
+// Separa os valores da linha (vírgulas ou espaços); limites aceitam "min:max"
+static int lerValores(char *texto, double **valores, int *capacidade, const char *caminho, int numLinha) {
+    int quantidade = 0;
+    char *cursor = texto;
+
+    while (*cursor != '\0') {
+        while (*cursor == ',' || *cursor == ':' || isspace((unsigned char)*cursor)) {
+            cursor++;
+        }
+        if (*cursor == '\0') {
+            break;
+        }
+        char *fim;
+        double valor = strtod(cursor, &fim);
+        if (fim == cursor) {
+            printf("Valor invalido em %s, linha %d: %s\n", caminho, numLinha, cursor);
+            exit(1);
+        }
+        if (quantidade == *capacidade) {
+            *capacidade = *capacidade > 0 ? 2 * *capacidade : 16;
+            *valores = (double *)realloc(*valores, (size_t)*capacidade * sizeof(double));
+            if (*valores == NULL) {
+                printf("Erro ao alocar o plano\n");
+                exit(1);
+            }
+        }
+        (*valores)[quantidade++] = valor;
+        cursor = fim;
+    }
+    return quantidade;
+}
+
+// As sementes são lidas como inteiros de 64 bits (um double perderia bits)
+static void lerSementes(PlanoExperimento *plano, char *texto) {
+    char *cursor = texto;
+
+    free(plano->sementes);
+    plano->sementes = NULL;
+    plano->numSementes = 0;
+    while (*cursor != '\0') {
+        while (*cursor == ',' || isspace((unsigned char)*cursor)) {
+            cursor++;
+        }
+        if (*cursor == '\0') {
+            break;
+        }
+        char *fim;
+        unsigned long long semente = strtoull(cursor, &fim, 10);
+        if (fim == cursor) {
+            printf("Semente invalida no plano: %s\n", cursor);
+            exit(1);
+        }
+        plano->sementes = (unsigned long long *)realloc(plano->sementes, (size_t)(plano->numSementes + 1) * sizeof(unsigned long long));
+        if (plano->sementes == NULL) {
+            printf("Erro ao alocar o plano\n");
+            exit(1);
+        }
+        plano->sementes[plano->numSementes++] = semente;
+        cursor = fim;
+    }
+}
+
+void carregarPlano(PlanoExperimento *plano, const char *caminho) {
+    FILE *arquivo = fopen(caminho, "r");
+    char linha[TAMANHO_LINHA];
+    double *valores = NULL;
+    int capacidade = 0, numLinha = 0;
+
+    if (arquivo == NULL) {
+        printf("Erro ao abrir o plano %s\n", caminho);
+        exit(1);
+    }
+    while (fgets(linha, sizeof(linha), arquivo) != NULL) {
+        numLinha++;
+        char *comentario = strchr(linha, '#');
+        if (comentario != NULL) {
+            *comentario = '\0';
+        }
+        char *igual = strchr(linha, '=');
+        if (igual == NULL) {
+            // só aceita linhas em branco sem "="
+            for (char *c = linha; *c != '\0'; c++) {
+                if (!isspace((unsigned char)*c)) {
+                    printf("Linha invalida em %s, linha %d\n", caminho, numLinha);
+                    exit(1);
+                }
+            }
+            continue;
+        }
+        *igual = '\0';
+
+        char chave[64];
+        if (sscanf(linha, "%63s", chave) != 1) {
+            printf("Chave ausente em %s, linha %d\n", caminho, numLinha);
+            exit(1);
+        }
+        if (strcmp(chave, "sementes") == 0) {
+            lerSementes(plano, igual + 1);
+            continue;
+        }
+
+        int quantidade = lerValores(igual + 1, &valores, &capacidade, caminho, numLinha);
+        ListaPlano *lista = NULL;
+        if (strcmp(chave, "populacoes") == 0) {
+            lista = &plano->populacoes;
+        } else if (strcmp(chave, "iteracoes") == 0) {
+            lista = &plano->iteracoes;
+        } else if (strcmp(chave, "w") == 0) {
+            lista = &plano->w;
+        } else if (strcmp(chave, "c1") == 0) {
+            lista = &plano->c1;
+        } else if (strcmp(chave, "c2") == 0) {
+            lista = &plano->c2;
+        } else if (strcmp(chave, "limites") == 0) {
+            lista = &plano->limites;
+        } else if (strcmp(chave, "vmax") == 0) {
+            lista = &plano->velMax;
+        } else if (strcmp(chave, "replicas") == 0) {
+            if (quantidade != 1 || valores[0] < 1) {
+                printf("replicas deve ser um unico valor >= 1 (%s, linha %d)\n", caminho, numLinha);
+                exit(1);
+            }
+            plano->replicas = (int)valores[0];
+            continue;
+        } else {
+            printf("Chave desconhecida em %s, linha %d: %s\n", caminho, numLinha, chave);
+            exit(1);
+        }
+
+        if (quantidade == 0 || (lista == &plano->limites && quantidade % 2 != 0)) {
+            printf("Valores invalidos para %s em %s, linha %d\n", chave, caminho, numLinha);
+            exit(1);
+        }
+        definirLista(lista, valores, quantidade);
+    }
+    free(valores);
+    fclose(arquivo);
+
+    for (int i = 0; i < plano->populacoes.quantidade; i++) {
+        if (plano->populacoes.valores[i] < 1) {
+            printf("Populacao invalida no plano: %g\n", plano->populacoes.valores[i]);
+            exit(1);
+        }
+    }
+    for (int i = 0; i < plano->iteracoes.quantidade; i++) {
+        if (plano->iteracoes.valores[i] < 0) {
+            printf("Numero de iteracoes invalido no plano: %g\n", plano->iteracoes.valores[i]);
+            exit(1);
+        }
+    }
+    for (int i = 0; i < plano->limites.quantidade; i += 2) {
+        if (plano->limites.valores[i] >= plano->limites.valores[i + 1]) {
+            printf("Limites invalidos no plano: %g:%g\n", plano->limites.valores[i], plano->limites.valores[i + 1]);
+            exit(1);
+        }
+    }
+}
+
+void expandirPlano(const PlanoExperimento *plano, unsigned long long sementePadrao, PlanoExpandido *expandido) {
+    int numLimites = plano->limites.quantidade / 2;
+    int numSementes = plano->numSementes > 0 ? plano->numSementes : 1;
+    long long numCelulas = (long long)plano->iteracoes.quantidade * plano->populacoes.quantidade * plano->w.quantidade
+                         * plano->c1.quantidade * plano->c2.quantidade * numLimites * plano->velMax.quantidade;
+    long long numTarefas = numCelulas * numSementes * plano->replicas;
+
+    if (numTarefas > 0x7fffffff) {
+        printf("Plano grande demais: %lld execucoes\n", numTarefas);
+        exit(1);
+    }
+    expandido->numCelulas = (int)numCelulas;
+    expandido->numTarefas = (int)numTarefas;
+    expandido->maiorIteracao = 0;
+    expandido->celulas = (CelulaPlano *)calloc((size_t)(numCelulas > 0 ? numCelulas : 1), sizeof(CelulaPlano));
+    expandido->tarefas = (TarefaPlano *)calloc((size_t)(numTarefas > 0 ? numTarefas : 1), sizeof(TarefaPlano));
+    if (expandido->celulas == NULL || expandido->tarefas == NULL) {
+        printf("Erro ao alocar o plano\n");
+        exit(1);
+    }
+
+    // iterações no eixo mais externo, como na varredura original; vmax no mais interno
+    int c = 0;
+    for (int it = 0; it < plano->iteracoes.quantidade; it++)
+    for (int p = 0; p < plano->populacoes.quantidade; p++)
+    for (int iw = 0; iw < plano->w.quantidade; iw++)
+    for (int i1 = 0; i1 < plano->c1.quantidade; i1++)
+    for (int i2 = 0; i2 < plano->c2.quantidade; i2++)
+    for (int l = 0; l < numLimites; l++)
+    for (int v = 0; v < plano->velMax.quantidade; v++) {
+        CelulaPlano *celula = &expandido->celulas[c++];
+        celula->iteracoes = (int)plano->iteracoes.valores[it];
+        celula->populacao = (int)plano->populacoes.valores[p];
+        celula->w = plano->w.valores[iw];
+        celula->c1 = plano->c1.valores[i1];
+        celula->c2 = plano->c2.valores[i2];
+        celula->posMin = plano->limites.valores[2 * l];
+        celula->posMax = plano->limites.valores[2 * l + 1];
+        celula->velMax = plano->velMax.valores[v];
+        zerarEstatistica(&celula->estatistica);
+        if (celula->iteracoes > expandido->maiorIteracao) {
+            expandido->maiorIteracao = celula->iteracoes;
+        }
+    }
+
+    // cada semente base gera um fluxo por (célula, réplica); sem sementes no plano o índice é o da lista plana
+    int t = 0;
+    for (c = 0; c < expandido->numCelulas; c++) {
+        for (int s = 0; s < numSementes; s++) {
+            unsigned long long base = plano->numSementes > 0 ? plano->sementes[s] : sementePadrao;
+            for (int r = 0; r < plano->replicas; r++) {
+                TarefaPlano *tarefa = &expandido->tarefas[t++];
+                tarefa->celula = c;
+                tarefa->replica = s * plano->replicas + r;
+                tarefa->semente = sementeDaExecucao(base, (unsigned long long)c * plano->replicas + r);
+            }
+        }
+    }
+}
+
+void liberarPlano(PlanoExperimento *plano) {
+    free(plano->populacoes.valores);
+    free(plano->iteracoes.valores);
+    free(plano->w.valores);
+    free(plano->c1.valores);
+    free(plano->c2.valores);
+    free(plano->limites.valores);
+    free(plano->velMax.valores);
+    free(plano->sementes);
+    memset(plano, 0, sizeof(*plano));
+}
+
+void liberarPlanoExpandido(PlanoExpandido *expandido) {
+    free(expandido->celulas);
+    free(expandido->tarefas);
+    expandido->celulas = NULL;
+    expandido->tarefas = NULL;
+}
+
+void zerarEstatistica(Estatistica *estatistica) {
+    estatistica->n = 0;
+    estatistica->media = 0.0;
+    estatistica->m2 = 0.0;
+    estatistica->melhor = DBL_MAX;
+    estatistica->pior = -DBL_MAX;
+}
+
+void acumularEstatistica(Estatistica *estatistica, double valor) {
+    double delta = valor - estatistica->media;
+
+    estatistica->n++;
+    estatistica->media += delta / estatistica->n;
+    estatistica->m2 += delta * (valor - estatistica->media);
+    estatistica->melhor = valor < estatistica->melhor ? valor : estatistica->melhor;
+    estatistica->pior = valor > estatistica->pior ? valor : estatistica->pior;
+}
+
+void combinarEstatistica(Estatistica *destino, const Estatistica *origem) {
+    if (origem->n == 0) {
+        return;
+    }
+    if (destino->n == 0) {
+        *destino = *origem;
+        return;
+    }
+    long long n = destino->n + origem->n;
+    double delta = origem->media - destino->media;
+
+    destino->media += delta * origem->n / n;
+    destino->m2 += origem->m2 + delta * delta * ((double)destino->n * origem->n / n);
+    destino->n = n;
+    destino->melhor = origem->melhor < destino->melhor ? origem->melhor : destino->melhor;
+    destino->pior = origem->pior > destino->pior ? origem->pior : destino->pior;
+}
+
+double desvioEstatistica(const Estatistica *estatistica) {
+    return estatistica->n > 0 ? sqrt(estatistica->m2 / estatistica->n) : 0.0;
+}
@@ -0,0 +1,95 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef PLANO_H
+#define PLANO_H
+
+// Lista de valores de um eixo da grade
+typedef struct {
+   double *valores;
+   int quantidade;
+} ListaPlano;
+
+// Grade de parâmetros de um experimento: cada combinação dos eixos é uma célula,
+// executada replicas vezes para cada semente
+typedef struct {
+   ListaPlano populacoes;           // Número de partículas
+   ListaPlano iteracoes;            // Iterações do PSO
+   ListaPlano w, c1, c2;            // Inércia e coeficientes de aceleração
+   ListaPlano limites;              // Pares (posMin, posMax) do domínio
+   ListaPlano velMax;               // Limite da velocidade inicial
+   unsigned long long *sementes;    // Sementes base (nenhuma = semente da linha de comando)
+   int numSementes;
+   int replicas;                    // Execuções independentes por célula e semente
+} PlanoExperimento;
+
+// Média e desvio padrão acumulados em fluxo (Welford), sem guardar os resultados
+typedef struct {
+   long long n;
+   double media;
+   double m2;                       // Soma dos quadrados dos desvios à média
+   double melhor;
+   double pior;
+} Estatistica;
+
+// Uma combinação de parâmetros da grade
+typedef struct {
+   int populacao;
+   int iteracoes;
+   double w, c1, c2;
+   double posMin, posMax;
+   double velMax;
+   Estatistica estatistica;         // Resultados das execuções da célula
+} CelulaPlano;
+
+// Uma execução da lista plana
+typedef struct {
+   int celula;                      // Índice da célula
+   int replica;                     // Réplica dentro da célula (0..replicas*sementes)
+   unsigned long long semente;      // Semente do fluxo aleatório da execução
+} TarefaPlano;
+
+// Grade expandida: células e a lista plana de execuções (célula-major)
+typedef struct {
+   CelulaPlano *celulas;
+   int numCelulas;
+   TarefaPlano *tarefas;
+   int numTarefas;
+   int maiorIteracao;               // Maior número de iterações entre as células
+} PlanoExpandido;
+
+
+// Plano padrão da metodologia: populações 50 e 100, 20, 50 e 100 iterações, 10 réplicas;
+// os demais eixos têm um único valor
+void planoPadrao(PlanoExperimento *plano, double w, double c1, double c2, double posMin, double posMax, double velMax);
+
+
+// Lê o plano de um arquivo "chave = v1, v2, ..." (linhas com # são comentários);
+// as chaves ausentes mantêm o valor que o plano já tinha. Encerra o programa se houver erro.
+void carregarPlano(PlanoExperimento *plano, const char *caminho);
+
+
+// Expande a grade; sem sementes no plano usa sementePadrao
+void expandirPlano(const PlanoExperimento *plano, unsigned long long sementePadrao, PlanoExpandido *expandido);
+
+
+// Libera o plano e a grade expandida
+void liberarPlano(PlanoExperimento *plano);
+void liberarPlanoExpandido(PlanoExpandido *expandido);
+
+
+// Estatística vazia (sem resultados)
+void zerarEstatistica(Estatistica *estatistica);
+
+
+// Acumula um resultado na estatística
+void acumularEstatistica(Estatistica *estatistica, double valor);
+
+
+// Junta na de destino a estatística de outro conjunto de resultados (Chan et al.),
+// como se os resultados de origem tivessem sido acumulados nela
+void combinarEstatistica(Estatistica *destino, const Estatistica *origem);
+
+
+// Desvio padrão populacional da estatística
+double desvioEstatistica(const Estatistica *estatistica);
+
+#endif
@@ -0,0 +1,13 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include "plataforma.h"
+
+#ifdef _WIN32
+#include <windows.h>
+
+void prepararConsole(void) {
+    SetConsoleOutputCP(65001);
+}
+#else
+void prepararConsole(void) {
+}
+#endif
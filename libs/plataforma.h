@@ -0,0 +1,9 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef PLATAFORMA_H
+#define PLATAFORMA_H
+
+// Único ponto do programa que fala com o console do sistema: no Windows troca a página de
+// código da saída para UTF-8 (os acentos dos relatórios); nos demais sistemas não faz nada
+void prepararConsole(void);
+
+#endif
@@ -0,0 +1,132 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "reinicio.h"
+
+void prepararElite(ArquivoElite *elite, int capacidade, int dimensoes) {
+    size_t necessario = (size_t)capacidade * dimensoes;
+    if (elite->posicoes == NULL || elite->capacidadeAlocada < necessario || elite->capacidade < capacidade) {
+        free(elite->posicoes);
+        free(elite->aptidoes);
+        elite->posicoes = (double *)malloc(necessario * sizeof(double));
+        elite->aptidoes = (double *)malloc((size_t)capacidade * sizeof(double));
+        if (elite->posicoes == NULL || elite->aptidoes == NULL) {
+            printf("Erro ao alocar o arquivo de elite\n");
+            exit(1);
+        }
+        elite->capacidadeAlocada = necessario;
+    }
+    elite->capacidade = capacidade;
+    elite->dimensoes = dimensoes;
+    elite->tamanho = 0;
+}
+
+void arquivarMelhor(ArquivoElite *elite, const Swarm *enxame) {
+    double aptidao = enxame->globalBestFitness;
+    size_t bytes = (size_t)elite->dimensoes * sizeof(double);
+    int posicao = elite->tamanho;
+
+    if (aptidao == DBL_MAX || (elite->tamanho == elite->capacidade && aptidao >= elite->aptidoes[elite->tamanho - 1])) {
+        return;
+    }
+    for (int k = 0; k < elite->tamanho; k++) {
+        if (elite->aptidoes[k] == aptidao && memcmp(&elite->posicoes[(size_t)k * elite->dimensoes], enxame->globalBestPosition, bytes) == 0) {
+            return;
+        }
+    }
+    // inserção em ordem: desloca os piores uma casa (o último cai fora se o arquivo estiver cheio)
+    while (posicao > 0 && elite->aptidoes[posicao - 1] > aptidao) {
+        posicao--;
+    }
+    int fim = elite->tamanho < elite->capacidade ? elite->tamanho : elite->capacidade - 1;
+    for (int k = fim; k > posicao; k--) {
+        elite->aptidoes[k] = elite->aptidoes[k - 1];
+        memcpy(&elite->posicoes[(size_t)k * elite->dimensoes], &elite->posicoes[(size_t)(k - 1) * elite->dimensoes], bytes);
+    }
+    elite->aptidoes[posicao] = aptidao;
+    memcpy(&elite->posicoes[(size_t)posicao * elite->dimensoes], enxame->globalBestPosition, bytes);
+    if (elite->tamanho < elite->capacidade) {
+        elite->tamanho++;
+    }
+}
+
+// k-ésimo maior valor de v[0..n) (1 = o maior); reordena v
+static double kEsimoMaior(double *v, int n, int k) {
+    int alvo = n - k, inicio = 0, fim = n - 1;
+
+    while (inicio < fim) {
+        double pivo = v[(inicio + fim) / 2];
+        int i = inicio, j = fim;
+        while (i <= j) {
+            while (v[i] < pivo) {
+                i++;
+            }
+            while (v[j] > pivo) {
+                j--;
+            }
+            if (i <= j) {
+                double t = v[i];
+                v[i] = v[j];
+                v[j] = t;
+                i++;
+                j--;
+            }
+        }
+        if (alvo <= j) {
+            fim = j;
+        } else if (alvo >= i) {
+            inicio = i;
+        } else {
+            break;
+        }
+    }
+    return v[alvo];
+}
+
+int reiniciarParticulas(Swarm *enxame, double fracao, double posMin, double posMax, double velMax) {
+    int n = enxame->numParticles;
+    int k = (int)ceil(fracao * n);
+    k = k < 1 ? 1 : (k > n ? n : k);
+    double limiar = -DBL_MAX;
+    int empatadas = n;
+
+    // r2 já foi usado pela velocidade e é sorteado de novo na próxima iteração: serve de rascunho
+    // para achar o limiar dos k piores pBest sem alocar nada
+    if (k < n) {
+        int acima = 0;
+        memcpy(enxame->r2, enxame->bestFitness, (size_t)n * sizeof(double));
+        limiar = kEsimoMaior(enxame->r2, n, k);
+        for (int i = 0; i < n; i++) {
+            acima += enxame->bestFitness[i] > limiar;
+        }
+        empatadas = k - acima;
+    }
+
+    for (int i = 0; i < n; i++) {
+        double melhor = enxame->bestFitness[i];
+        if (k < n && !(melhor > limiar || (melhor == limiar && empatadas-- > 0))) {
+            continue;
+        }
+        for (int d = 0; d < enxame->dimensions; d++) {
+            double posicao = posMin + (posMax - posMin) * uniformeAleatorio(&enxame->gerador);
+            COORD(enxame, position, d, i) = posicao;
+            COORD(enxame, velocity, d, i) = -velMax + 2 * velMax * uniformeAleatorio(&enxame->gerador);
+            COORD(enxame, bestPosition, d, i) = posicao;
+        }
+        enxame->fitness[i] = DBL_MAX;
+        enxame->bestFitness[i] = DBL_MAX;
+    }
+    if (k == n) {
+        enxame->globalBestFitness = DBL_MAX;
+    }
+    return k;
+}
+
+void liberarElite(ArquivoElite *elite) {
+    free(elite->posicoes);
+    free(elite->aptidoes);
+    memset(elite, 0, sizeof(*elite));
+}
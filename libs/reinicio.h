@@ -0,0 +1,46 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef REINICIO_H
+#define REINICIO_H
+#include <stddef.h>
+#include "enxame.h"
+
+// Soluções guardadas no arquivo de elite de uma execução
+#define ELITE_PADRAO 8
+
+// Quando e quanto do enxame reiniciar (desligado com estagnacao = 0 e diametro = 0)
+typedef struct {
+   int estagnacao;     // Reinicia após K iterações sem melhorar o gBest desde o último reinício
+   double diametro;    // Reinicia quando o raio do enxame fica abaixo dessa fração da largura do domínio
+   double fracao;      // Fração das partículas sorteadas de novo (as de pior pBest); 1 = enxame inteiro
+} PoliticaReinicio;
+
+// Melhores soluções vistas entre os reinícios de uma execução, em ordem crescente de aptidão
+typedef struct {
+   double *posicoes;          // [capacidade][dimensoes]
+   double *aptidoes;          // [capacidade]
+   int tamanho;
+   int capacidade;
+   int dimensoes;
+   size_t capacidadeAlocada;  // Doubles alocados em posicoes
+} ArquivoElite;
+
+
+// Esvazia o arquivo para uma execução (realoca só se não couber); o arquivo deve começar zerado
+void prepararElite(ArquivoElite *elite, int capacidade, int dimensoes);
+
+
+// Guarda o gBest do enxame se ele estiver entre os melhores e ainda não estiver no arquivo
+void arquivarMelhor(ArquivoElite *elite, const Swarm *enxame);
+
+
+// Sorteia de novo posição e velocidade de uma fração das partículas dentro da própria arena.
+// Com fração < 1 saem as de pior pBest e o gBest é mantido (injeção de diversidade); com o
+// enxame inteiro o gBest também é esquecido e o enxame deve ser avaliado antes de continuar.
+// Devolve quantas partículas foram sorteadas.
+int reiniciarParticulas(Swarm *enxame, double fracao, double posMin, double posMax, double velMax);
+
+
+// Libera os vetores do arquivo
+void liberarElite(ArquivoElite *elite);
+
+#endif
@@ -0,0 +1,207 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include "relatorio.h"
+
+// Formato binário (little-endian, tipos nativos):
+//   cabeçalho: "PSOR", uint32 versão, uint32 dimensões, char objetivo[16]
+//   cada bloco: uint32 n, seguido das colunas com n valores cada:
+//     indice int64, celula int32, rodada int32, semente uint64, populacao int32, iteracoes int32,
+//     w, c1, c2, melhor double, uma coluna double por dimensão da melhor posição,
+//     iteracoes_executadas int32, avaliacoes int64, criterio char[12],
+//     tempo double (zero quando o tempo está desligado)
+#define VERSAO_BINARIA 3
+
+// Bytes do nome do critério no formato binário
+#define TAMANHO_CRITERIO 12
+
+// Uma gravação que falha (disco cheio, cota) encerra o programa com erro: seguir adiante
+// terminaria com sucesso e um arquivo de resultados truncado
+static void falhaDeGravacao(const EscritorResultados *escritor) {
+    printf("Erro ao gravar o arquivo %s\n", escritor->caminho);
+    exit(1);
+}
+
+static void esvaziarBuffer(EscritorResultados *escritor) {
+    if (escritor->usado > 0) {
+        if (fwrite(escritor->buffer, 1, escritor->usado, escritor->arquivo) != escritor->usado) {
+            falhaDeGravacao(escritor);
+        }
+        escritor->usado = 0;
+    }
+}
+
+static void escreverBytes(EscritorResultados *escritor, const void *dados, size_t tamanho) {
+    if (escritor->usado + tamanho > TAMANHO_BUFFER_RESULTADOS) {
+        esvaziarBuffer(escritor);
+    }
+    memcpy(escritor->buffer + escritor->usado, dados, tamanho);
+    escritor->usado += tamanho;
+}
+
+// Formata texto direto no buffer, sem fprintf por campo. Se o texto não couber no espaço livre,
+// o buffer vai para o arquivo e o texto é formatado de novo no buffer vazio.
+static void escreverTexto(EscritorResultados *escritor, const char *formato, ...) {
+    va_list argumentos, copia;
+    va_start(argumentos, formato);
+    va_copy(copia, argumentos);
+    size_t livre = TAMANHO_BUFFER_RESULTADOS - escritor->usado;
+    int escrito = vsnprintf(escritor->buffer + escritor->usado, livre, formato, argumentos);
+    if (escrito >= 0 && (size_t)escrito >= livre) {
+        esvaziarBuffer(escritor);
+        escrito = vsnprintf(escritor->buffer, TAMANHO_BUFFER_RESULTADOS, formato, copia);
+        if (escrito >= TAMANHO_BUFFER_RESULTADOS) {
+            printf("Erro ao escrever os resultados: campo de %d bytes maior que o buffer\n", escrito);
+            exit(1);
+        }
+    }
+    va_end(copia);
+    va_end(argumentos);
+    if (escrito > 0) {
+        escritor->usado += (size_t)escrito;
+    }
+}
+
+void abrirEscritor(EscritorResultados *escritor, const char *caminho, FormatoSaida formato, int silencioso, int incluirTempo, int dimensoes, const char *objetivo) {
+    memset(escritor, 0, sizeof(*escritor));
+    escritor->formato = formato;
+    escritor->silencioso = silencioso;
+    escritor->incluirTempo = incluirTempo;
+    escritor->dimensoes = dimensoes;
+    escritor->objetivo = objetivo;
+    escritor->caminho = caminho;
+    escritor->arquivo = fopen(caminho, formato == SAIDA_BINARIA ? "wb" : "w");
+    escritor->buffer = (char *)malloc(TAMANHO_BUFFER_RESULTADOS);
+    if (escritor->arquivo == NULL || escritor->buffer == NULL) {
+        printf("Erro ao abrir o arquivo %s\n", caminho);
+        exit(1);
+    }
+    pthread_mutex_init(&escritor->trava, NULL);
+
+    if (formato == SAIDA_BINARIA) {
+        uint32_t versao = VERSAO_BINARIA, numDimensoes = (uint32_t)dimensoes;
+        char nome[16] = {0};
+        strncpy(nome, objetivo, sizeof(nome) - 1);
+        escritor->bloco = (RegistroResultado *)malloc(REGISTROS_POR_BLOCO * sizeof(RegistroResultado));
+        escritor->posicoesBloco = (double *)malloc((size_t)REGISTROS_POR_BLOCO * dimensoes * sizeof(double));
+        if (escritor->bloco == NULL || escritor->posicoesBloco == NULL) {
+            printf("Erro ao alocar o escritor de resultados\n");
+            exit(1);
+        }
+        escreverBytes(escritor, "PSOR", 4);
+        escreverBytes(escritor, &versao, sizeof(versao));
+        escreverBytes(escritor, &numDimensoes, sizeof(numDimensoes));
+        escreverBytes(escritor, nome, sizeof(nome));
+    } else {
+        escreverTexto(escritor, "rodada,execucao,celula,semente,objetivo,dimensoes,populacao,iteracoes,w,c1,c2,melhor");
+        for (int d = 0; d < dimensoes; d++) {
+            escreverTexto(escritor, ",x%d", d);
+        }
+        escreverTexto(escritor, ",iteracoes_executadas,avaliacoes,criterio");
+        escreverTexto(escritor, escritor->incluirTempo ? ",tempo_s\n" : "\n");
+    }
+    printf("\n INFO: Arquivo %s Aberto! Bom uso.\n", caminho);
+}
+
+// Transpõe o bloco de registros para colunas e o grava
+static void gravarBlocoColunar(EscritorResultados *escritor) {
+    int n = escritor->registrosNoBloco;
+    uint32_t quantidade = (uint32_t)n;
+    if (n == 0) {
+        return;
+    }
+
+    escreverBytes(escritor, &quantidade, sizeof(quantidade));
+#define COLUNA(tipo, expressao) \
+    for (int i = 0; i < n; i++) { \
+        const RegistroResultado *r = &escritor->bloco[i]; \
+        tipo valor = (tipo)(expressao); \
+        (void)r; \
+        escreverBytes(escritor, &valor, sizeof(valor)); \
+    }
+    COLUNA(int64_t, r->indice)
+    COLUNA(int32_t, r->celula)
+    COLUNA(int32_t, r->rodada)
+    COLUNA(uint64_t, r->semente)
+    COLUNA(int32_t, r->populacao)
+    COLUNA(int32_t, r->iteracoes)
+    COLUNA(double, r->w)
+    COLUNA(double, r->c1)
+    COLUNA(double, r->c2)
+    COLUNA(double, r->melhor)
+    for (int d = 0; d < escritor->dimensoes; d++) {
+        COLUNA(double, escritor->posicoesBloco[(size_t)i * escritor->dimensoes + d])
+    }
+    COLUNA(int32_t, r->iteracoesExecutadas)
+    COLUNA(int64_t, r->avaliacoes)
+    for (int i = 0; i < n; i++) {
+        char criterio[TAMANHO_CRITERIO] = {0};
+        strncpy(criterio, escritor->bloco[i].criterio, sizeof(criterio) - 1);
+        escreverBytes(escritor, criterio, sizeof(criterio));
+    }
+    COLUNA(double, escritor->incluirTempo ? r->tempo : 0.0)
+#undef COLUNA
+    escritor->registrosNoBloco = 0;
+}
+
+void registrarResultado(EscritorResultados *escritor, const RegistroResultado *registro) {
+    pthread_mutex_lock(&escritor->trava);
+
+    if (escritor->formato == SAIDA_BINARIA) {
+        int i = escritor->registrosNoBloco++;
+        escritor->bloco[i] = *registro;
+        memcpy(&escritor->posicoesBloco[(size_t)i * escritor->dimensoes], registro->melhorPosicao, escritor->dimensoes * sizeof(double));
+        if (escritor->registrosNoBloco == REGISTROS_POR_BLOCO) {
+            gravarBlocoColunar(escritor);
+        }
+    } else {
+        escreverTexto(escritor, "%d,%lld,%d,%llu,%s,%d,%d,%d,%.6g,%.6g,%.6g,%.10f",
+                      registro->rodada, registro->indice, registro->celula, registro->semente, escritor->objetivo, escritor->dimensoes,
+                      registro->populacao, registro->iteracoes, registro->w, registro->c1, registro->c2, registro->melhor);
+        for (int d = 0; d < escritor->dimensoes; d++) {
+            escreverTexto(escritor, ",%.10f", registro->melhorPosicao[d]);
+        }
+        escreverTexto(escritor, ",%d,%lld,%s", registro->iteracoesExecutadas, registro->avaliacoes, registro->criterio);
+        if (escritor->incluirTempo) {
+            escreverTexto(escritor, ",%.6f", registro->tempo);
+        }
+        escreverTexto(escritor, "\n");
+    }
+
+    if (!escritor->silencioso) {
+        printf("Rodada: %d, População: %d, Iterações: %d, Melhor: %0.6f, Semente: %llu\n",
+               registro->rodada, registro->populacao, registro->iteracoes, registro->melhor, registro->semente);
+    }
+    escritor->totalRegistros++;
+    pthread_mutex_unlock(&escritor->trava);
+}
+
+void descarregarEscritor(EscritorResultados *escritor) {
+    pthread_mutex_lock(&escritor->trava);
+    if (escritor->formato == SAIDA_BINARIA) {
+        gravarBlocoColunar(escritor);
+    }
+    esvaziarBuffer(escritor);
+    if (fflush(escritor->arquivo) != 0) {
+        falhaDeGravacao(escritor);
+    }
+    pthread_mutex_unlock(&escritor->trava);
+}
+
+void fecharEscritor(EscritorResultados *escritor) {
+    if (escritor->formato == SAIDA_BINARIA) {
+        gravarBlocoColunar(escritor);
+    }
+    esvaziarBuffer(escritor);
+    // o stdio ainda guarda o fim do arquivo: o erro do disco cheio pode aparecer só aqui
+    if (fclose(escritor->arquivo) != 0) {
+        falhaDeGravacao(escritor);
+    }
+    pthread_mutex_destroy(&escritor->trava);
+    free(escritor->buffer);
+    free(escritor->bloco);
+    free(escritor->posicoesBloco);
+    escritor->arquivo = NULL;
+}
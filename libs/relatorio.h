@@ -0,0 +1,69 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef RELATORIO_H
+#define RELATORIO_H
+#include <stdio.h>
+#include <pthread.h>
+
+// Tamanho do buffer de escrita e registros por bloco colunar
+#define TAMANHO_BUFFER_RESULTADOS (1 << 20)
+#define REGISTROS_POR_BLOCO 4096
+
+// Formatos de saída dos resultados
+typedef enum {
+   SAIDA_CSV,     // Uma linha por execução, com cabeçalho
+   SAIDA_BINARIA  // Blocos colunares de até REGISTROS_POR_BLOCO execuções
+} FormatoSaida;
+
+// Resultado de uma execução, como é gravado
+typedef struct {
+   long long indice;            // Posição da execução na varredura
+   int celula;                  // Célula do plano de experimento
+   int rodada;                  // Rodada (ou réplica) da execução
+   unsigned long long semente;  // Semente do fluxo aleatório
+   int populacao;               // Número de partículas
+   int iteracoes;               // Iterações pedidas
+   double w, c1, c2;            // Parâmetros do PSO
+   double melhor;               // Melhor aptidão
+   const double *melhorPosicao; // Melhor posição [dimensoes]
+   int iteracoesExecutadas;     // Iterações feitas até o critério de parada
+   long long avaliacoes;        // Avaliações da função objetivo
+   const char *criterio;        // Nome do critério que encerrou a execução
+   double tempo;                // Tempo de parede da execução em segundos
+} RegistroResultado;
+
+// Escritor de resultados com buffer grande, seguro para várias threads
+typedef struct {
+   FILE *arquivo;
+   FormatoSaida formato;
+   int silencioso;              // 1 = não ecoa cada resultado no console
+   int incluirTempo;            // 0 = omite o tempo (saída idêntica entre execuções com a mesma semente)
+   int dimensoes;
+   const char *objetivo;
+   const char *caminho;         // Arquivo de saída (para a mensagem de erro)
+   char *buffer;                // Bytes ainda não gravados
+   size_t usado;
+   RegistroResultado *bloco;    // Registros do bloco colunar em montagem
+   double *posicoesBloco;       // Posições do bloco [REGISTROS_POR_BLOCO][dimensoes]
+   int registrosNoBloco;
+   long long totalRegistros;
+   pthread_mutex_t trava;
+} EscritorResultados;
+
+
+// Abre o arquivo de saída e escreve o cabeçalho; encerra o programa se não conseguir
+void abrirEscritor(EscritorResultados *escritor, const char *caminho, FormatoSaida formato, int silencioso, int incluirTempo, int dimensoes, const char *objetivo);
+
+
+// Acrescenta um resultado (as posições são copiadas; a chamada pode vir de qualquer thread)
+void registrarResultado(EscritorResultados *escritor, const RegistroResultado *registro);
+
+
+// Grava no arquivo o que estiver pendente (inclusive um bloco colunar incompleto) sem fechá-lo
+void descarregarEscritor(EscritorResultados *escritor);
+
+
+// Grava o que estiver pendente e fecha o arquivo. Se uma gravação falhar (aqui, em descarregarEscritor
+// ou em registrarResultado), encerra o programa com erro.
+void fecharEscritor(EscritorResultados *escritor);
+
+#endif
@@ -0,0 +1,433 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "retomada.h"
+#include "tempo.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+// Arredonda bytes para a linha de cache
+static size_t arredondar64(size_t bytes) {
+    return (bytes + 63) / 64 * 64;
+}
+
+// ========== Impressão da varredura ===========
+
+// FNV-1a de 64 bits acumulado
+static uint64_t misturarBytes(uint64_t hash, const void *dados, size_t bytes) {
+    const unsigned char *p = (const unsigned char *)dados;
+    for (size_t i = 0; i < bytes; i++) {
+        hash = (hash ^ p[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+uint64_t impressaoDaVarredura(const PlanoExpandido *plano, const ParametrosPSO *parametros, TipoGerador tipoGerador) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    int motor = parametros->motor, modo = parametros->modoGBest, gerador = tipoGerador, topologia = parametros->topologia;
+    int fronteira = parametros->fronteira, agenda = parametros->agenda.tipo;
+
+    hash = misturarBytes(hash, &plano->numTarefas, sizeof(int));
+    hash = misturarBytes(hash, &parametros->dimensoes, sizeof(int));
+    hash = misturarBytes(hash, &motor, sizeof(int));
+    hash = misturarBytes(hash, &modo, sizeof(int));
+    hash = misturarBytes(hash, &gerador, sizeof(int));
+    hash = misturarBytes(hash, &parametros->tamanhoBloco, sizeof(int));
+    hash = misturarBytes(hash, &parametros->grao, sizeof(int));
+    hash = misturarBytes(hash, &topologia, sizeof(int));
+    hash = misturarBytes(hash, &parametros->vizinhosAleatorios, sizeof(int));
+    hash = misturarBytes(hash, &fronteira, sizeof(int));
+    hash = misturarBytes(hash, &parametros->limitarVelocidade, sizeof(int));
+    hash = misturarBytes(hash, &agenda, sizeof(int));
+    hash = misturarBytes(hash, &parametros->agenda.wInicial, 7 * sizeof(double));
+    hash = misturarBytes(hash, &parametros->reinicio.estagnacao, sizeof(int));
+    hash = misturarBytes(hash, &parametros->reinicio.diametro, sizeof(double));
+    hash = misturarBytes(hash, &parametros->reinicio.fracao, sizeof(double));
+    // sem ilhas a impressão fica a de antes, e os arquivos já salvos continuam valendo
+    if (parametros->ilhas.numIlhas > 1) {
+        int migracao = parametros->ilhas.topologia;
+        hash = misturarBytes(hash, &parametros->ilhas.numIlhas, sizeof(int));
+        hash = misturarBytes(hash, &parametros->ilhas.intervalo, sizeof(int));
+        hash = misturarBytes(hash, &parametros->ilhas.migrantes, sizeof(int));
+        hash = misturarBytes(hash, &migracao, sizeof(int));
+    }
+    hash = misturarBytes(hash, parametros->objetivo.nome, strlen(parametros->objetivo.nome));
+    hash = misturarBytes(hash, &parametros->parada.alvo, sizeof(double));
+    hash = misturarBytes(hash, &parametros->parada.estagnacao, sizeof(int));
+    hash = misturarBytes(hash, &parametros->parada.raioMinimo, sizeof(double));
+    hash = misturarBytes(hash, &parametros->parada.velocidadeMinima, sizeof(double));
+    hash = misturarBytes(hash, &parametros->parada.avaliacoesMaximas, sizeof(long long));
+    for (int c = 0; c < plano->numCelulas; c++) {
+        const CelulaPlano *celula = &plano->celulas[c];
+        double valores[6] = {celula->w, celula->c1, celula->c2, celula->posMin, celula->posMax, celula->velMax};
+        hash = misturarBytes(hash, &celula->populacao, sizeof(int));
+        hash = misturarBytes(hash, &celula->iteracoes, sizeof(int));
+        hash = misturarBytes(hash, valores, sizeof(valores));
+    }
+    for (int i = 0; i < plano->numTarefas; i++) {
+        hash = misturarBytes(hash, &plano->tarefas[i].celula, sizeof(int));
+        hash = misturarBytes(hash, &plano->tarefas[i].semente, sizeof(unsigned long long));
+    }
+    return hash;
+}
+
+// ========== Mapeamento ===========
+
+// Grava o conteúdo inicial em caminho.tmp e o renomeia por cima do arquivo: até a troca o
+// arquivo anterior fica intacto, e um processo morto no meio não perde o que já estava salvo
+static void gravarArquivo(const char *caminho, const char *dados, size_t tamanho) {
+    char temporario[1024];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", caminho);
+    FILE *arquivo = fopen(temporario, "wb");
+    if (arquivo == NULL || fwrite(dados, 1, tamanho, arquivo) != tamanho || fflush(arquivo) != 0) {
+        printf("Erro ao criar o arquivo de retomada %s\n", temporario);
+        exit(1);
+    }
+#ifdef _WIN32
+    fclose(arquivo);
+    if (!MoveFileExA(temporario, caminho, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+#else
+    fsync(fileno(arquivo));
+    fclose(arquivo);
+    if (rename(temporario, caminho) != 0) {
+#endif
+        printf("Erro ao substituir o arquivo de retomada %s\n", caminho);
+        exit(1);
+    }
+}
+
+// Mapeia inteiro, para leitura e escrita, o arquivo já gravado com o tamanho dado
+static void mapearArquivo(Retomada *retomada, const char *caminho, size_t tamanho) {
+#ifdef _WIN32
+    HANDLE arquivo = CreateFileA(caminho, GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    HANDLE mapeamento = arquivo == INVALID_HANDLE_VALUE ? NULL :
+        CreateFileMappingA(arquivo, NULL, PAGE_READWRITE, (DWORD)((uint64_t)tamanho >> 32), (DWORD)(tamanho & 0xffffffffu), NULL);
+    void *mapa = mapeamento == NULL ? NULL : MapViewOfFile(mapeamento, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (mapa == NULL) {
+        printf("Erro ao mapear o arquivo de retomada %s\n", caminho);
+        exit(1);
+    }
+    retomada->arquivo = (intptr_t)arquivo;
+    retomada->mapeamento = (intptr_t)mapeamento;
+#else
+    int arquivo = open(caminho, O_RDWR);
+    if (arquivo < 0) {
+        printf("Erro ao abrir o arquivo de retomada %s\n", caminho);
+        exit(1);
+    }
+    void *mapa = mmap(NULL, tamanho, PROT_READ | PROT_WRITE, MAP_SHARED, arquivo, 0);
+    if (mapa == MAP_FAILED) {
+        printf("Erro ao mapear o arquivo de retomada %s\n", caminho);
+        exit(1);
+    }
+    retomada->arquivo = arquivo;
+    retomada->mapeamento = 0;
+#endif
+    retomada->mapa = mapa;
+    retomada->tamanho = tamanho;
+}
+
+// Pede ao sistema que grave o trecho no disco sem esperar
+static void descarregarTrecho(const Retomada *retomada, const void *inicio, size_t bytes) {
+#ifdef _WIN32
+    (void)retomada;
+    FlushViewOfFile(inicio, bytes);
+#else
+    uintptr_t pagina = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t comeco = (uintptr_t)inicio & ~(pagina - 1);
+    (void)retomada;
+    msync((void *)comeco, (uintptr_t)inicio + bytes - comeco, MS_ASYNC);
+#endif
+}
+
+// Lê o arquivo inteiro para a memória; NULL se ele não existir
+static char *lerArquivoInteiro(const char *caminho, size_t *tamanho) {
+    FILE *arquivo = fopen(caminho, "rb");
+    if (arquivo == NULL) {
+        return NULL;
+    }
+    fseek(arquivo, 0, SEEK_END);
+    long bytes = ftell(arquivo);
+    fseek(arquivo, 0, SEEK_SET);
+    char *dados = bytes > 0 ? (char *)malloc((size_t)bytes) : NULL;
+    if (dados == NULL || fread(dados, 1, (size_t)bytes, arquivo) != (size_t)bytes) {
+        free(dados);
+        fclose(arquivo);
+        return NULL;
+    }
+    fclose(arquivo);
+    *tamanho = (size_t)bytes;
+    return dados;
+}
+
+// ========== Layout ===========
+
+static size_t bytesCabecalhoVaga(void) {
+    return arredondar64(sizeof(CabecalhoVaga));
+}
+
+// Cópia c (0 ou 1) da vaga v
+static CabecalhoVaga *copiaDaVaga(const char *vagas, uint64_t bytesVaga, int v, int c) {
+    return (CabecalhoVaga *)(vagas + ((size_t)v * 2 + c) * bytesVaga);
+}
+
+// Distribui as regiões a partir do início do mapa (ou de uma cópia lida do disco)
+static void distribuir(char *base, const CabecalhoRetomada *cabecalho, RegistroRetomada **registros, double **posicoes, char **vagas) {
+    size_t deslocamento = arredondar64(sizeof(CabecalhoRetomada));
+    *registros = (RegistroRetomada *)(base + deslocamento);
+    deslocamento += arredondar64((size_t)cabecalho->total * sizeof(RegistroRetomada));
+    *posicoes = (double *)(base + deslocamento);
+    deslocamento += arredondar64((size_t)cabecalho->total * cabecalho->dimensoes * sizeof(double));
+    *vagas = base + deslocamento;
+}
+
+static size_t tamanhoDoArquivo(const CabecalhoRetomada *cabecalho) {
+    return arredondar64(sizeof(CabecalhoRetomada)) +
+           arredondar64((size_t)cabecalho->total * sizeof(RegistroRetomada)) +
+           arredondar64((size_t)cabecalho->total * cabecalho->dimensoes * sizeof(double)) +
+           (size_t)cabecalho->numVagas * 2 * cabecalho->bytesVaga;
+}
+
+int lerSementeRetomada(const char *caminho, unsigned long long *semente) {
+    CabecalhoRetomada cabecalho;
+    FILE *arquivo = fopen(caminho, "rb");
+    if (arquivo == NULL) {
+        return 0;
+    }
+    size_t lido = fread(&cabecalho, sizeof(cabecalho), 1, arquivo);
+    fclose(arquivo);
+    if (lido != 1 || memcmp(cabecalho.magica, MAGICA_RETOMADA, 8) != 0 || cabecalho.versao != VERSAO_RETOMADA) {
+        return 0;
+    }
+    *semente = cabecalho.semente;
+    return 1;
+}
+
+// Confere que o arquivo anterior (já na memória) é desta varredura, antes de mexer no disco
+static void conferirAnterior(const char *anterior, size_t tamanhoAnterior, const CabecalhoRetomada *novo) {
+    const CabecalhoRetomada *velho = (const CabecalhoRetomada *)anterior;
+
+    if (tamanhoAnterior < sizeof(CabecalhoRetomada) || memcmp(velho->magica, MAGICA_RETOMADA, 8) != 0 ||
+        velho->versao != VERSAO_RETOMADA || velho->impressao != novo->impressao || velho->total != novo->total ||
+        velho->dimensoes != novo->dimensoes || velho->bytesVaga != novo->bytesVaga ||
+        tamanhoDoArquivo(velho) > tamanhoAnterior) {
+        printf("O arquivo de retomada e de outra varredura (plano, semente ou parametros diferentes)\n");
+        exit(1);
+    }
+}
+
+// Herda do arquivo anterior (já conferido) os resultados concluídos e as execuções em andamento
+static void herdar(Retomada *retomada, char *anterior) {
+    const CabecalhoRetomada *velho = (const CabecalhoRetomada *)anterior;
+    RegistroRetomada *registros;
+    double *posicoes;
+    char *vagas;
+
+    distribuir(anterior, velho, &registros, &posicoes, &vagas);
+
+    for (int i = 0; i < velho->total; i++) {
+        if (registros[i].concluida) {
+            memcpy(&retomada->posicoes[(size_t)i * retomada->dimensoes], &posicoes[(size_t)i * retomada->dimensoes], retomada->dimensoes * sizeof(double));
+            retomada->registros[i] = registros[i];
+            retomada->retomadas++;
+        }
+    }
+
+    // de cada vaga vale a cópia completa (sequência par) mais recente, se a execução não terminou
+    retomada->salvas = (char *)malloc((size_t)velho->numVagas * velho->bytesVaga + 1);
+    if (retomada->salvas == NULL) {
+        printf("Erro ao alocar a retomada\n");
+        exit(1);
+    }
+    for (int v = 0; v < velho->numVagas; v++) {
+        const CabecalhoVaga *escolhida = NULL;
+        for (int c = 0; c < 2; c++) {
+            const CabecalhoVaga *copia = copiaDaVaga(vagas, velho->bytesVaga, v, c);
+            if (copia->sequencia > 0 && copia->sequencia % 2 == 0 && (escolhida == NULL || copia->sequencia > escolhida->sequencia)) {
+                escolhida = copia;
+            }
+        }
+        if (escolhida != NULL && escolhida->execucao >= 0 && escolhida->execucao < velho->total &&
+            !registros[escolhida->execucao].concluida) {
+            memcpy(retomada->salvas + (size_t)retomada->numSalvas * velho->bytesVaga, escolhida, velho->bytesVaga);
+            retomada->numSalvas++;
+        }
+    }
+}
+
+void abrirRetomada(Retomada *retomada, const char *caminho, int retomar, const PlanoExpandido *plano,
+                   const ParametrosPSO *parametros, TipoGerador tipoGerador, unsigned long long semente, int numTrabalhadores) {
+    CabecalhoRetomada cabecalho;
+    size_t tamanhoAnterior = 0;
+    char *anterior = NULL;
+    int maiorPopulacao = 1;
+
+    memset(retomada, 0, sizeof(*retomada));
+    // o arquivo anterior vai inteiro para a memória: ele só é substituído depois de conferido
+    if (retomar) {
+        anterior = lerArquivoInteiro(caminho, &tamanhoAnterior);
+        if (anterior == NULL) {
+            printf("Arquivo de retomada %s nao encontrado\n", caminho);
+            exit(1);
+        }
+    }
+
+    for (int c = 0; c < plano->numCelulas; c++) {
+        maiorPopulacao = plano->celulas[c].populacao > maiorPopulacao ? plano->celulas[c].populacao : maiorPopulacao;
+    }
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.magica, MAGICA_RETOMADA, 8);
+    cabecalho.versao = VERSAO_RETOMADA;
+    cabecalho.dimensoes = (uint32_t)parametros->dimensoes;
+    cabecalho.semente = semente;
+    cabecalho.impressao = impressaoDaVarredura(plano, parametros, tipoGerador);
+    cabecalho.total = plano->numTarefas;
+    cabecalho.numVagas = numTrabalhadores;
+    cabecalho.maiorPopulacao = maiorPopulacao;
+    retomada->doublesVaga = doublesDoEnxame(maiorPopulacao, parametros->dimensoes);
+    cabecalho.bytesVaga = arredondar64(bytesCabecalhoVaga() + retomada->doublesVaga * sizeof(double));
+
+    if (anterior != NULL) {
+        conferirAnterior(anterior, tamanhoAnterior, &cabecalho);
+    }
+
+    // o conteúdo novo é montado na memória e só então troca o arquivo de uma vez
+    size_t tamanho = tamanhoDoArquivo(&cabecalho);
+    char *inicial = (char *)calloc(tamanho, 1);
+    if (inicial == NULL) {
+        printf("Erro ao alocar a retomada\n");
+        exit(1);
+    }
+    *(CabecalhoRetomada *)inicial = cabecalho;
+    retomada->dimensoes = parametros->dimensoes;
+    distribuir(inicial, &cabecalho, &retomada->registros, &retomada->posicoes, &retomada->vagas);
+    for (int v = 0; v < numTrabalhadores; v++) {
+        copiaDaVaga(retomada->vagas, cabecalho.bytesVaga, v, 0)->execucao = -1;
+        copiaDaVaga(retomada->vagas, cabecalho.bytesVaga, v, 1)->execucao = -1;
+    }
+    if (anterior != NULL) {
+        herdar(retomada, anterior);
+        free(anterior);
+    }
+    gravarArquivo(caminho, inicial, tamanho);
+    free(inicial);
+
+    mapearArquivo(retomada, caminho, tamanho);
+    retomada->cabecalho = (CabecalhoRetomada *)retomada->mapa;
+    distribuir((char *)retomada->mapa, &cabecalho, &retomada->registros, &retomada->posicoes, &retomada->vagas);
+}
+
+const RegistroRetomada *execucaoConcluida(const Retomada *retomada, int i, const double **posicao) {
+    if (!retomada->registros[i].concluida) {
+        return NULL;
+    }
+    *posicao = &retomada->posicoes[(size_t)i * retomada->dimensoes];
+    return &retomada->registros[i];
+}
+
+void registrarConcluida(Retomada *retomada, int i, const RegistroRetomada *registro, const double *posicao) {
+    RegistroRetomada *destino = &retomada->registros[i];
+
+    memcpy(&retomada->posicoes[(size_t)i * retomada->dimensoes], posicao, retomada->dimensoes * sizeof(double));
+    destino->iteracoes = registro->iteracoes;
+    destino->criterio = registro->criterio;
+    destino->avaliacoes = registro->avaliacoes;
+    destino->resultado = registro->resultado;
+    destino->tempo = registro->tempo;
+    __atomic_store_n(&destino->concluida, 1, __ATOMIC_RELEASE);
+    descarregarTrecho(retomada, destino, sizeof(*destino));
+}
+
+// ========== Salvamento por trabalhador ===========
+
+// Chamado pelo motor: copia o enxame e o progresso na cópia mais antiga da vaga
+static void salvarNaVaga(PontoSalvamento *ponto, const Swarm *enxame, const ProgressoPSO *progresso) {
+    SalvamentoTrabalhador *salvamento = (SalvamentoTrabalhador *)ponto->contexto;
+    Retomada *retomada = salvamento->retomada;
+    uint64_t bytesVaga = retomada->cabecalho->bytesVaga;
+    CabecalhoVaga *copia = copiaDaVaga(retomada->vagas, bytesVaga, salvamento->vaga, (int)(salvamento->sequencia / 2 % 2));
+    size_t doubles = doublesDoEnxame(enxame->numParticles, enxame->dimensions);
+
+    // sequência ímpar enquanto a cópia está pela metade: um processo morto no meio deixa a outra valendo
+    __atomic_store_n(&copia->sequencia, salvamento->sequencia + 1, __ATOMIC_RELEASE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    copia->execucao = salvamento->execucao;
+    copia->numParticulas = enxame->numParticles;
+    copia->progresso = *progresso;
+    copia->gerador = enxame->gerador;
+    copia->globalBestFitness = enxame->globalBestFitness;
+    copia->avaliacoes = enxame->avaliacoes;
+    copia->tempo = tempoDaExecucao(salvamento);
+    memcpy((char *)copia + bytesCabecalhoVaga(), enxame->position, doubles * sizeof(double));
+    salvamento->sequencia += 2;
+    __atomic_store_n(&copia->sequencia, salvamento->sequencia, __ATOMIC_RELEASE);
+    descarregarTrecho(retomada, copia, bytesCabecalhoVaga() + doubles * sizeof(double));
+}
+
+void iniciarSalvamento(SalvamentoTrabalhador *salvamento, Retomada *retomada, int vaga, double intervalo) {
+    memset(salvamento, 0, sizeof(*salvamento));
+    salvamento->retomada = retomada;
+    salvamento->vaga = vaga;
+    salvamento->execucao = -1;
+    salvamento->ponto.intervalo = intervalo > 0 ? intervalo : INTERVALO_RETOMADA_PADRAO;
+    salvamento->ponto.salvar = salvarNaVaga;
+    salvamento->ponto.contexto = salvamento;
+}
+
+int comecarExecucao(SalvamentoTrabalhador *salvamento, int i, Swarm *enxame) {
+    Retomada *retomada = salvamento->retomada;
+    uint64_t bytesVaga = retomada->cabecalho->bytesVaga;
+
+    salvamento->execucao = i;
+    salvamento->inicio = tempoAtual();
+    salvamento->tempoAnterior = 0;
+    salvamento->ponto.proximo = salvamento->inicio + salvamento->ponto.intervalo;
+    salvamento->ponto.retomar = NULL;
+
+    for (int s = 0; s < retomada->numSalvas; s++) {
+        const CabecalhoVaga *salva = (const CabecalhoVaga *)(retomada->salvas + (size_t)s * bytesVaga);
+        if (salva->execucao != i) {
+            continue;
+        }
+        prepararEnxame(enxame, salva->numParticulas, retomada->dimensoes);
+        memcpy(enxame->position, (const char *)salva + bytesCabecalhoVaga(),
+               doublesDoEnxame(salva->numParticulas, retomada->dimensoes) * sizeof(double));
+        enxame->gerador = salva->gerador;
+        enxame->globalBestFitness = salva->globalBestFitness;
+        enxame->avaliacoes = salva->avaliacoes;
+        salvamento->retomado = salva->progresso;
+        salvamento->ponto.retomar = &salvamento->retomado;
+        salvamento->tempoAnterior = salva->tempo;
+        return 1;
+    }
+    return 0;
+}
+
+double tempoDaExecucao(const SalvamentoTrabalhador *salvamento) {
+    return salvamento->tempoAnterior + (tempoAtual() - salvamento->inicio);
+}
+
+void fecharRetomada(Retomada *retomada) {
+    if (retomada->mapa == NULL) {
+        return;
+    }
+#ifdef _WIN32
+    FlushViewOfFile(retomada->mapa, 0);
+    UnmapViewOfFile(retomada->mapa);
+    CloseHandle((HANDLE)retomada->mapeamento);
+    CloseHandle((HANDLE)retomada->arquivo);
+#else
+    msync(retomada->mapa, retomada->tamanho, MS_SYNC);
+    munmap(retomada->mapa, retomada->tamanho);
+    close((int)retomada->arquivo);
+#endif
+    free(retomada->salvas);
+    retomada->mapa = NULL;
+}
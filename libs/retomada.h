@@ -0,0 +1,124 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef RETOMADA_H
+#define RETOMADA_H
+#include <stddef.h>
+#include <stdint.h>
+#include "motor.h"
+#include "plano.h"
+
+#define MAGICA_RETOMADA "PSORET01"
+#define VERSAO_RETOMADA 1
+
+// Intervalo padrão entre salvamentos de uma execução em andamento, em segundos
+#define INTERVALO_RETOMADA_PADRAO 5.0
+
+// Início do arquivo de retomada
+typedef struct {
+   char magica[8];
+   uint32_t versao;
+   uint32_t dimensoes;
+   uint64_t semente;        // Semente da varredura (a expansão do plano depende dela)
+   uint64_t impressao;      // Hash do plano e dos parâmetros: só retoma a mesma varredura
+   int32_t total;           // Execuções da varredura
+   int32_t numVagas;        // Vagas de execução em andamento (uma por trabalhador)
+   int32_t maiorPopulacao;  // Partículas do maior enxame (dimensiona as vagas)
+   int32_t reservado;
+   uint64_t bytesVaga;      // Bytes de cada cópia de uma vaga
+} CabecalhoRetomada;
+
+// Resultado de uma execução concluída
+typedef struct {
+   int32_t concluida;       // Escrito por último: 1 = o registro e a posição estão completos
+   int32_t iteracoes;
+   int32_t criterio;
+   int32_t reservado;
+   int64_t avaliacoes;
+   double resultado;
+   double tempo;
+} RegistroRetomada;
+
+// Cópia do estado de uma execução em andamento; cada vaga tem duas e a escrita alterna entre elas
+typedef struct {
+   uint64_t sequencia;      // Ímpar = escrita em andamento; vale a cópia par de maior sequência
+   int32_t execucao;        // Execução salva (-1 = vazia)
+   int32_t numParticulas;
+   ProgressoPSO progresso;
+   GeradorAleatorio gerador;
+   double globalBestFitness;
+   int64_t avaliacoes;
+   double tempo;            // Segundos já gastos na execução
+   // seguem doublesDoEnxame(numParticulas, dimensoes) doubles da arena do enxame
+} CabecalhoVaga;
+
+// Arquivo de retomada mapeado em memória: os resultados concluídos e, por trabalhador,
+// o estado da execução em andamento. Escrever é um memcpy no mapa; o sistema grava as páginas.
+typedef struct {
+   void *mapa;                  // Arquivo inteiro mapeado
+   size_t tamanho;
+   intptr_t arquivo;            // Descritor (ou HANDLE no Windows)
+   intptr_t mapeamento;         // HANDLE do mapeamento (só no Windows)
+   CabecalhoRetomada *cabecalho;
+   RegistroRetomada *registros; // [total]
+   double *posicoes;            // Melhor posição de cada execução concluída [total][dimensoes]
+   char *vagas;                 // [numVagas][2][bytesVaga]
+   int dimensoes;
+   size_t doublesVaga;          // Doubles do maior enxame
+   // Execuções em andamento lidas do arquivo anterior (só na retomada)
+   char *salvas;                // Cópias válidas [numSalvas][bytesVaga]
+   int numSalvas;
+   int retomadas;               // Execuções concluídas herdadas do arquivo anterior
+} Retomada;
+
+// Ponto de salvamento de um trabalhador (o motor recebe &ponto)
+typedef struct {
+   PontoSalvamento ponto;
+   Retomada *retomada;
+   int vaga;                    // Vaga do trabalhador
+   int execucao;                // Execução em andamento
+   uint64_t sequencia;          // Sequência da última cópia escrita
+   double inicio;               // Início da execução nesta sessão
+   double tempoAnterior;        // Segundos gastos antes da retomada
+   ProgressoPSO retomado;       // Progresso restaurado (apontado por ponto.retomar)
+} SalvamentoTrabalhador;
+
+
+// Hash do plano expandido e de tudo nos parâmetros que muda a trajetória de alguma execução:
+// duas varreduras com a mesma impressão produzem os mesmos resultados
+uint64_t impressaoDaVarredura(const PlanoExpandido *plano, const ParametrosPSO *parametros, TipoGerador tipoGerador);
+
+
+// Lê a semente gravada num arquivo de retomada; retorna 0 se ele não existir ou for inválido
+int lerSementeRetomada(const char *caminho, unsigned long long *semente);
+
+
+// Cria (ou recria) o arquivo mapeado para a varredura. Com retomar = 1 lê antes o arquivo
+// existente, confere se é a mesma varredura e herda as execuções concluídas e as em andamento.
+void abrirRetomada(Retomada *retomada, const char *caminho, int retomar, const PlanoExpandido *plano,
+                   const ParametrosPSO *parametros, TipoGerador tipoGerador, unsigned long long semente, int numTrabalhadores);
+
+
+// Registro da execução i se ela já estiver concluída no arquivo; NULL caso contrário
+const RegistroRetomada *execucaoConcluida(const Retomada *retomada, int i, const double **posicao);
+
+
+// Grava o resultado da execução i (posição primeiro, a marca de concluída por último)
+void registrarConcluida(Retomada *retomada, int i, const RegistroRetomada *registro, const double *posicao);
+
+
+// Prepara o ponto de salvamento da vaga de um trabalhador
+void iniciarSalvamento(SalvamentoTrabalhador *salvamento, Retomada *retomada, int vaga, double intervalo);
+
+
+// Começa a execução i na vaga: se ela estava em andamento no arquivo anterior, restaura o enxame
+// (arena, gerador, gBest) e o progresso e retorna 1; senão retorna 0 e o enxame deve ser inicializado
+int comecarExecucao(SalvamentoTrabalhador *salvamento, int i, Swarm *enxame);
+
+
+// Segundos gastos na execução em andamento, somando os de antes da retomada
+double tempoDaExecucao(const SalvamentoTrabalhador *salvamento);
+
+
+// Descarrega o mapa no disco e fecha o arquivo
+void fecharRetomada(Retomada *retomada);
+
+#endif
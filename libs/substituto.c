@@ -0,0 +1,346 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "substituto.h"
+
+// Maior k aceito na previsão
+#define MAX_VIZINHOS_SUBSTITUTO 64
+
+// Os k vizinhos mais próximos achados até agora, em ordem de distância
+typedef struct {
+    int indices[MAX_VIZINHOS_SUBSTITUTO];
+    double distancias[MAX_VIZINHOS_SUBSTITUTO];
+    int tamanho;
+    int k;
+} BuscaVizinhos;
+
+void criarSubstituto(ModeloSubstituto *modelo, int dimensoes, int capacidade, int vizinhos, double margem) {
+    memset(modelo, 0, sizeof(*modelo));
+    modelo->dimensoes = dimensoes;
+    modelo->capacidade = capacidade > 0 ? capacidade : PONTOS_SUBSTITUTO_PADRAO;
+    modelo->vizinhos = vizinhos > 0 ? vizinhos : VIZINHOS_SUBSTITUTO_PADRAO;
+    modelo->vizinhos = modelo->vizinhos < MAX_VIZINHOS_SUBSTITUTO ? modelo->vizinhos : MAX_VIZINHOS_SUBSTITUTO;
+    modelo->margem = margem;
+    modelo->pontos = (double *)malloc((size_t)modelo->capacidade * dimensoes * sizeof(double));
+    modelo->valores = (double *)malloc((size_t)modelo->capacidade * sizeof(double));
+    modelo->ordem = (int *)malloc((size_t)modelo->capacidade * sizeof(int));
+    modelo->eixo = (int *)malloc((size_t)modelo->capacidade * sizeof(int));
+    modelo->corte = (double *)malloc((size_t)modelo->capacidade * sizeof(double));
+    modelo->fora = (unsigned char *)calloc(modelo->capacidade, 1);
+    modelo->pendentes = (int *)malloc((size_t)modelo->capacidade * sizeof(int));
+    modelo->consulta = (double *)malloc((size_t)dimensoes * sizeof(double));
+    if (modelo->pontos == NULL || modelo->valores == NULL || modelo->ordem == NULL || modelo->eixo == NULL ||
+        modelo->corte == NULL || modelo->fora == NULL || modelo->pendentes == NULL || modelo->consulta == NULL) {
+        printf("Erro ao alocar o modelo substituto\n");
+        exit(1);
+    }
+}
+
+void esvaziarSubstituto(ModeloSubstituto *modelo) {
+    modelo->tamanho = 0;
+    modelo->proximo = 0;
+    modelo->indexados = 0;
+    modelo->numPendentes = 0;
+    modelo->amostras = 0;
+    modelo->descartesDaExecucao = 0;
+}
+
+// ========== Índice espacial ===========
+
+static inline double coordenada(const ModeloSubstituto *modelo, int ponto, int d) {
+    return modelo->pontos[(size_t)ponto * modelo->dimensoes + d];
+}
+
+// Reordena ordem[inicio..fim] para que ordem[alvo] tenha a mediana no eixo (seleção de Hoare)
+static void selecionarMediana(ModeloSubstituto *modelo, int inicio, int fim, int alvo, int eixo) {
+    int *ordem = modelo->ordem;
+
+    while (inicio < fim) {
+        double pivo = coordenada(modelo, ordem[(inicio + fim) / 2], eixo);
+        int i = inicio, j = fim;
+        while (i <= j) {
+            while (coordenada(modelo, ordem[i], eixo) < pivo) {
+                i++;
+            }
+            while (coordenada(modelo, ordem[j], eixo) > pivo) {
+                j--;
+            }
+            if (i <= j) {
+                int t = ordem[i];
+                ordem[i] = ordem[j];
+                ordem[j] = t;
+                i++;
+                j--;
+            }
+        }
+        if (alvo <= j) {
+            fim = j;
+        } else if (alvo >= i) {
+            inicio = i;
+        } else {
+            break;
+        }
+    }
+}
+
+// Monta o nó de [inicio, fim): corta no eixo de maior amplitude, pela mediana
+static void construirArvore(ModeloSubstituto *modelo, int inicio, int fim) {
+    int meio = (inicio + fim) / 2;
+    int eixo = 0;
+    double amplitude = -1;
+
+    if (fim - inicio <= 0) {
+        return;
+    }
+    for (int d = 0; d < modelo->dimensoes; d++) {
+        double menor = DBL_MAX, maior = -DBL_MAX;
+        for (int i = inicio; i < fim; i++) {
+            double x = coordenada(modelo, modelo->ordem[i], d);
+            menor = x < menor ? x : menor;
+            maior = x > maior ? x : maior;
+        }
+        if (maior - menor > amplitude) {
+            amplitude = maior - menor;
+            eixo = d;
+        }
+    }
+    selecionarMediana(modelo, inicio, fim - 1, meio, eixo);
+    modelo->eixo[meio] = eixo;
+    modelo->corte[meio] = coordenada(modelo, modelo->ordem[meio], eixo);
+    construirArvore(modelo, inicio, meio);
+    construirArvore(modelo, meio + 1, fim);
+}
+
+// Refaz a árvore com todos os pontos guardados
+static void reconstruirIndice(ModeloSubstituto *modelo) {
+    for (int i = 0; i < modelo->tamanho; i++) {
+        modelo->ordem[i] = i;
+        modelo->fora[i] = 0;
+    }
+    modelo->indexados = modelo->tamanho;
+    modelo->numPendentes = 0;
+    construirArvore(modelo, 0, modelo->indexados);
+}
+
+// Guarda o ponto avaliado (coordenada d em posicao[d * stride]) no lugar do mais antigo
+static void guardarPonto(ModeloSubstituto *modelo, const double *posicao, int stride, double valor) {
+    int indice = modelo->proximo;
+
+    for (int d = 0; d < modelo->dimensoes; d++) {
+        modelo->pontos[(size_t)indice * modelo->dimensoes + d] = posicao[(size_t)d * stride];
+    }
+    modelo->valores[indice] = valor;
+    modelo->proximo = (modelo->proximo + 1) % modelo->capacidade;
+    modelo->tamanho += modelo->tamanho < modelo->capacidade;
+    // o ponto que estava aqui saiu da árvore: a busca passa a vê-lo só pelos pendentes
+    if (indice < modelo->indexados) {
+        modelo->fora[indice] = 1;
+    }
+    modelo->pendentes[modelo->numPendentes++] = indice;
+
+    // varrer os pendentes custa o mesmo que reconstruir quando eles passam de 1/8 da árvore;
+    // a fila dos pendentes tem a capacidade do modelo e nunca passa dela
+    int limite = modelo->indexados / 8;
+    limite = limite > AMOSTRAS_MINIMAS_SUBSTITUTO ? limite : AMOSTRAS_MINIMAS_SUBSTITUTO;
+    if (modelo->numPendentes >= (limite < modelo->capacidade ? limite : modelo->capacidade)) {
+        reconstruirIndice(modelo);
+    }
+}
+
+// ========== Previsão ===========
+
+static void considerarVizinho(BuscaVizinhos *busca, int indice, double distancia) {
+    if (busca->tamanho == busca->k && distancia >= busca->distancias[busca->k - 1]) {
+        return;
+    }
+    int posicao = busca->tamanho < busca->k ? busca->tamanho++ : busca->k - 1;
+    while (posicao > 0 && busca->distancias[posicao - 1] > distancia) {
+        busca->distancias[posicao] = busca->distancias[posicao - 1];
+        busca->indices[posicao] = busca->indices[posicao - 1];
+        posicao--;
+    }
+    busca->distancias[posicao] = distancia;
+    busca->indices[posicao] = indice;
+}
+
+static double distanciaQuadrada(const ModeloSubstituto *modelo, int ponto) {
+    const double *coordenadas = &modelo->pontos[(size_t)ponto * modelo->dimensoes];
+    double soma = 0;
+    for (int d = 0; d < modelo->dimensoes; d++) {
+        double diferenca = modelo->consulta[d] - coordenadas[d];
+        soma += diferenca * diferenca;
+    }
+    return soma;
+}
+
+static void buscarArvore(const ModeloSubstituto *modelo, BuscaVizinhos *busca, int inicio, int fim) {
+    if (fim - inicio <= 0) {
+        return;
+    }
+    int meio = (inicio + fim) / 2;
+    int ponto = modelo->ordem[meio];
+    if (!modelo->fora[ponto]) {
+        considerarVizinho(busca, ponto, distanciaQuadrada(modelo, ponto));
+    }
+    // o corte guardado continua valendo para os pontos que ainda estão na árvore
+    double diferenca = modelo->consulta[modelo->eixo[meio]] - modelo->corte[meio];
+    if (diferenca < 0) {
+        buscarArvore(modelo, busca, inicio, meio);
+    } else {
+        buscarArvore(modelo, busca, meio + 1, fim);
+    }
+    if (busca->tamanho < busca->k || diferenca * diferenca < busca->distancias[busca->tamanho - 1]) {
+        if (diferenca < 0) {
+            buscarArvore(modelo, busca, meio + 1, fim);
+        } else {
+            buscarArvore(modelo, busca, inicio, meio);
+        }
+    }
+}
+
+// Média das aptidões dos k vizinhos da consulta ponderada pelo inverso do quadrado da distância;
+// a incerteza é o desvio ponderado das aptidões dos vizinhos em torno da previsão
+static double preverConsulta(const ModeloSubstituto *modelo, double *incerteza) {
+    BuscaVizinhos busca;
+    double soma = 0, pesos = 0, dispersao = 0;
+
+    busca.tamanho = 0;
+    busca.k = modelo->vizinhos;
+    buscarArvore(modelo, &busca, 0, modelo->indexados);
+    for (int p = 0; p < modelo->numPendentes; p++) {
+        considerarVizinho(&busca, modelo->pendentes[p], distanciaQuadrada(modelo, modelo->pendentes[p]));
+    }
+    if (busca.distancias[0] == 0) {
+        *incerteza = 0;
+        return modelo->valores[busca.indices[0]];
+    }
+    for (int j = 0; j < busca.tamanho; j++) {
+        double peso = 1.0 / busca.distancias[j];
+        soma += peso * modelo->valores[busca.indices[j]];
+        pesos += peso;
+    }
+    double previsao = soma / pesos;
+    for (int j = 0; j < busca.tamanho; j++) {
+        double diferenca = modelo->valores[busca.indices[j]] - previsao;
+        dispersao += diferenca * diferenca / busca.distancias[j];
+    }
+    *incerteza = sqrt(dispersao / pesos);
+    return previsao;
+}
+
+// ========== Triagem ===========
+
+int avaliarComSubstituto(ModeloSubstituto *modelo, const Objetivo *objetivo, const double *posicao, int stride, int n,
+                         const double *limiares, double *saida) {
+    int dimensoes = modelo->dimensoes;
+    int pronto = modelo->tamanho >= AMOSTRAS_MINIMAS_SUBSTITUTO && modelo->amostras >= AMOSTRAS_MINIMAS_SUBSTITUTO;
+    int descartados = 0, reais = 0;
+
+    if (modelo->particulasAlocadas < n) {
+        free(modelo->previstos);
+        free(modelo->decisao);
+        modelo->previstos = (double *)malloc((size_t)n * sizeof(double));
+        modelo->decisao = (unsigned char *)malloc((size_t)n);
+        if (modelo->previstos == NULL || modelo->decisao == NULL) {
+            printf("Erro ao alocar a triagem do modelo substituto\n");
+            exit(1);
+        }
+        modelo->particulasAlocadas = n;
+    }
+
+    // toda partícula recebe a previsão (para medir o erro); só descarta a que fica pior que o próprio
+    // pBest mesmo descontando margem vezes a incerteza local. As novas e as reiniciadas (pBest DBL_MAX)
+    // sempre vão ao objetivo.
+    for (int i = 0; i < n; i++) {
+        modelo->decisao[i] = 0;
+        modelo->previstos[i] = NAN;
+        if (modelo->tamanho < modelo->vizinhos) {
+            continue;
+        }
+        for (int d = 0; d < dimensoes; d++) {
+            modelo->consulta[d] = posicao[(size_t)d * stride + i];
+        }
+        double incerteza;
+        modelo->previstos[i] = preverConsulta(modelo, &incerteza);
+        if (pronto && limiares[i] != DBL_MAX && modelo->previstos[i] - modelo->margem * incerteza > limiares[i]) {
+            modelo->decisao[i] = ++modelo->descartesDaExecucao % AUDITORIA_SUBSTITUTO == 0 ? 2 : 1;
+        }
+    }
+
+    // os trechos de partículas a avaliar vão juntos para o objetivo, no lugar
+    for (int i = 0; i < n;) {
+        if (modelo->decisao[i] == 1) {
+            i++;
+            continue;
+        }
+        int inicio = i;
+        while (i < n && modelo->decisao[i] != 1) {
+            i++;
+        }
+        reais += avaliarObjetivo(objetivo, &posicao[inicio], stride, dimensoes, i - inicio, &saida[inicio]);
+    }
+
+    // o modelo só aprende depois do bloco: as previsões do bloco não dependem da ordem das partículas nele
+    for (int i = 0; i < n; i++) {
+        if (modelo->decisao[i] == 1) {
+            saida[i] = modelo->previstos[i];
+            descartados++;
+            continue;
+        }
+        if (!isnan(modelo->previstos[i])) {
+            double erro = fabs(modelo->previstos[i] - saida[i]);
+            modelo->amostras++;
+            modelo->estatistica.amostrasErro++;
+            modelo->estatistica.somaErroAbsoluto += erro;
+            modelo->estatistica.somaErroQuadrado += erro * erro;
+        }
+        if (modelo->decisao[i] == 2) {
+            modelo->estatistica.auditados++;
+            modelo->estatistica.descartesErrados += saida[i] < limiares[i];
+        }
+        guardarPonto(modelo, &posicao[i], stride, saida[i]);
+    }
+    modelo->estatistica.candidatos += n;
+    modelo->estatistica.descartados += descartados;
+    return reais;
+}
+
+void somarEstatisticaSubstituto(EstatisticaSubstituto *total, const ModeloSubstituto *modelo) {
+    total->candidatos += modelo->estatistica.candidatos;
+    total->descartados += modelo->estatistica.descartados;
+    total->auditados += modelo->estatistica.auditados;
+    total->descartesErrados += modelo->estatistica.descartesErrados;
+    total->amostrasErro += modelo->estatistica.amostrasErro;
+    total->somaErroAbsoluto += modelo->estatistica.somaErroAbsoluto;
+    total->somaErroQuadrado += modelo->estatistica.somaErroQuadrado;
+}
+
+void relatarEstatisticaSubstituto(const EstatisticaSubstituto *estatistica) {
+    long long reais = estatistica->candidatos - estatistica->descartados;
+    double fracao = estatistica->candidatos > 0 ? 100.0 * estatistica->descartados / estatistica->candidatos : 0.0;
+    double amostras = estatistica->amostrasErro > 0 ? (double)estatistica->amostrasErro : 1.0;
+
+    printf("\n\t\t =====| MODELO SUBSTITUTO |=====\n\n");
+    printf("Candidatos: %lld, descartados: %lld (%.2f%%), avaliacoes reais: %lld (%.2fx menos)\n",
+           estatistica->candidatos, estatistica->descartados, fracao, reais, reais > 0 ? (double)estatistica->candidatos / reais : 0.0);
+    printf("Auditoria: %lld descartes avaliados, %lld melhorariam o pBest\n", estatistica->auditados, estatistica->descartesErrados);
+    printf("Erro das previsoes: medio %.6g, quadratico medio %.6g (%lld amostras)\n",
+           estatistica->somaErroAbsoluto / amostras, sqrt(estatistica->somaErroQuadrado / amostras), estatistica->amostrasErro);
+}
+
+void liberarSubstituto(ModeloSubstituto *modelo) {
+    free(modelo->pontos);
+    free(modelo->valores);
+    free(modelo->ordem);
+    free(modelo->eixo);
+    free(modelo->corte);
+    free(modelo->fora);
+    free(modelo->pendentes);
+    free(modelo->consulta);
+    free(modelo->previstos);
+    free(modelo->decisao);
+    memset(modelo, 0, sizeof(*modelo));
+}
@@ -0,0 +1,85 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef SUBSTITUTO_H
+#define SUBSTITUTO_H
+#include "objetivos.h"
+
+// Pontos avaliados guardados pelo modelo (os mais antigos saem primeiro) e vizinhos da previsão
+#define PONTOS_SUBSTITUTO_PADRAO 4096
+#define VIZINHOS_SUBSTITUTO_PADRAO 8
+
+// Pontos e previsões conferidas antes de o modelo começar a descartar candidatos
+#define AMOSTRAS_MINIMAS_SUBSTITUTO 32
+
+// Um em tantos candidatos descartados é avaliado mesmo assim, para medir os descartes errados
+#define AUDITORIA_SUBSTITUTO 16
+
+// Triagem e erro do modelo substituto
+typedef struct {
+   long long candidatos;        // Avaliações pedidas com o modelo ligado
+   long long descartados;       // Candidatos não avaliados (a previsão ficou no lugar)
+   long long auditados;         // Descartes que foram avaliados mesmo assim
+   long long descartesErrados;  // Auditados que melhorariam o pBest
+   long long amostrasErro;      // Previsões comparadas com a avaliação real
+   double somaErroAbsoluto;
+   double somaErroQuadrado;
+} EstatisticaSubstituto;
+
+// Regressor k-NN (média ponderada pelo inverso da distância, com o desvio ponderado dos vizinhos
+// como incerteza local) sobre os últimos pontos avaliados de
+// uma execução, com uma árvore k-d como índice espacial. A árvore é refeita de tempos em tempos; os
+// pontos guardados depois disso são varridos à parte até a próxima reconstrução.
+typedef struct ModeloSubstituto {
+   int dimensoes;
+   int capacidade;              // Pontos guardados
+   int vizinhos;                // k da previsão
+   double margem;               // Descarta quando previsão - margem * desvio dos vizinhos > pBest
+   double *pontos;              // [capacidade][dimensoes]
+   double *valores;             // Aptidão real de cada ponto [capacidade]
+   int tamanho;                 // Pontos válidos
+   int proximo;                 // Próxima posição a sobrescrever (fila circular)
+   // índice espacial
+   int *ordem;                  // Árvore k-d implícita: o nó de [ini, fim) é ordem[(ini + fim) / 2]
+   int *eixo;                   // Eixo do corte de cada nó [capacidade]
+   double *corte;               // Coordenada do corte de cada nó (a do ponto na reconstrução)
+   unsigned char *fora;         // 1 = ponto sobrescrito depois da reconstrução (está nos pendentes)
+   int indexados;               // Pontos na árvore
+   int *pendentes;              // Pontos guardados desde a reconstrução
+   int numPendentes;
+   // previsão
+   int amostras;                // Previsões conferidas na execução
+   long long descartesDaExecucao; // Conta os descartes para escolher os auditados
+   double *consulta;            // Candidato com as coordenadas contíguas [dimensoes]
+   double *previstos;           // Rascunho da triagem [particulas]
+   unsigned char *decisao;      // 0 = avaliar, 1 = descartar, 2 = auditar [particulas]
+   int particulasAlocadas;
+   EstatisticaSubstituto estatistica;
+} ModeloSubstituto;
+
+
+// Aloca o modelo para a dimensão (capacidade e vizinhos <= 0 usam os padrões)
+void criarSubstituto(ModeloSubstituto *modelo, int dimensoes, int capacidade, int vizinhos, double margem);
+
+
+// Esquece os pontos da execução anterior (a estatística continua somando)
+void esvaziarSubstituto(ModeloSubstituto *modelo);
+
+
+// Avalia as n partículas do bloco dimensão-major: as que o modelo prevê piores que o pBest
+// (limiares[i]) mesmo descontando a incerteza ficam com a previsão em saida; as outras vão ao objetivo e ao modelo.
+// Devolve quantas foram avaliadas de fato (sem os descartes nem os acertos do cache do objetivo).
+int avaliarComSubstituto(ModeloSubstituto *modelo, const Objetivo *objetivo, const double *posicao, int stride, int n,
+                         const double *limiares, double *saida);
+
+
+// Soma a estatística do modelo ao total
+void somarEstatisticaSubstituto(EstatisticaSubstituto *total, const ModeloSubstituto *modelo);
+
+
+// Imprime a fração descartada, os descartes errados da auditoria e o erro das previsões
+void relatarEstatisticaSubstituto(const EstatisticaSubstituto *estatistica);
+
+
+// Libera o modelo
+void liberarSubstituto(ModeloSubstituto *modelo);
+
+#endif
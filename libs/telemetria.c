@@ -0,0 +1,132 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "telemetria.h"
+
+// Caracteres reservados por valor formatado
+#define CARACTERES_POR_VALOR 24
+
+void criarTelemetria(Telemetria *telemetria, NivelTelemetria nivel, int capacidade, int dimensoes) {
+    size_t doubles = 3 * (size_t)capacidade + (size_t)dimensoes;
+
+    telemetria->nivel = nivel;
+    telemetria->capacidade = capacidade;
+    telemetria->registrados = 0;
+    telemetria->tamanhoTexto = 3 * ((size_t)capacidade * CARACTERES_POR_VALOR + 64);
+    telemetria->melhor = (double *)malloc(doubles * sizeof(double) + telemetria->tamanhoTexto);
+    if (telemetria->melhor == NULL) {
+        printf("Erro ao alocar a telemetria\n");
+        exit(1);
+    }
+    telemetria->media = telemetria->melhor + capacidade;
+    telemetria->diversidade = telemetria->media + capacidade;
+    telemetria->centroide = telemetria->diversidade + capacidade;
+    telemetria->texto = (char *)(telemetria->centroide + dimensoes);
+}
+
+void reiniciarTelemetria(Telemetria *telemetria) {
+    telemetria->registrados = 0;
+}
+
+void registrarIteracao(Telemetria *telemetria, const Swarm *enxame) {
+    int posicao = telemetria->registrados % telemetria->capacidade;
+    int n = enxame->numParticles;
+
+    telemetria->melhor[posicao] = enxame->globalBestFitness;
+    if (telemetria->nivel == TELEMETRIA_COMPLETA) {
+        double soma = 0.0, distancias = 0.0;
+        for (int i = 0; i < n; i++) {
+            soma += enxame->fitness[i];
+        }
+        for (int d = 0; d < enxame->dimensions; d++) {
+            const double *x = &COORD(enxame, position, d, 0);
+            double centro = 0.0;
+            for (int i = 0; i < n; i++) {
+                centro += x[i];
+            }
+            telemetria->centroide[d] = centro / n;
+        }
+        for (int i = 0; i < n; i++) {
+            double quadrado = 0.0;
+            for (int d = 0; d < enxame->dimensions; d++) {
+                double diferenca = COORD(enxame, position, d, i) - telemetria->centroide[d];
+                quadrado += diferenca * diferenca;
+            }
+            distancias += sqrt(quadrado);
+        }
+        telemetria->media[posicao] = soma / n;
+        telemetria->diversidade[posicao] = distancias / n;
+    }
+    telemetria->registrados++;
+}
+
+void liberarTelemetria(Telemetria *telemetria) {
+    free(telemetria->melhor);
+    telemetria->melhor = NULL;
+}
+
+void abrirArquivoTelemetria(ArquivoTelemetria *arquivo, const char *caminho) {
+    arquivo->arquivo = fopen(caminho, "w");
+    if (arquivo->arquivo == NULL) {
+        printf("Erro ao abrir o arquivo %s\n", caminho);
+        exit(1);
+    }
+    pthread_mutex_init(&arquivo->trava, NULL);
+    fprintf(arquivo->arquivo, "execucao,metrica,primeira_iteracao,valores\n");
+}
+
+// Formata uma métrica do anel, da iteração mais antiga para a mais nova
+static size_t formatarMetrica(char *destino, size_t espaco, const Telemetria *telemetria, const double *anel, const char *nome, long long execucao) {
+    int guardados = telemetria->registrados < telemetria->capacidade ? telemetria->registrados : telemetria->capacidade;
+    int primeira = telemetria->registrados - guardados;
+    size_t usado = (size_t)snprintf(destino, espaco, "%lld,%s,%d", execucao, nome, primeira + 1);
+
+    for (int k = 0; k < guardados && usado < espaco; k++) {
+        usado += (size_t)snprintf(destino + usado, espaco - usado, ",%.10g", anel[(primeira + k) % telemetria->capacidade]);
+    }
+    if (usado < espaco) {
+        usado += (size_t)snprintf(destino + usado, espaco - usado, "\n");
+    }
+    return usado < espaco ? usado : espaco;
+}
+
+void descarregarTelemetria(ArquivoTelemetria *arquivo, Telemetria *telemetria, long long execucao) {
+    size_t espaco = telemetria->tamanhoTexto, usado = 0;
+
+    // formata fora da trava; a trava cobre só um fwrite por execução
+    usado += formatarMetrica(telemetria->texto + usado, espaco - usado, telemetria, telemetria->melhor, "melhor", execucao);
+    if (telemetria->nivel == TELEMETRIA_COMPLETA) {
+        usado += formatarMetrica(telemetria->texto + usado, espaco - usado, telemetria, telemetria->media, "media", execucao);
+        usado += formatarMetrica(telemetria->texto + usado, espaco - usado, telemetria, telemetria->diversidade, "diversidade", execucao);
+    }
+
+    pthread_mutex_lock(&arquivo->trava);
+    fwrite(telemetria->texto, 1, usado, arquivo->arquivo);
+    pthread_mutex_unlock(&arquivo->trava);
+}
+
+void fecharArquivoTelemetria(ArquivoTelemetria *arquivo) {
+    fclose(arquivo->arquivo);
+    pthread_mutex_destroy(&arquivo->trava);
+}
+
+int telemetriaPorNome(const char *nome, NivelTelemetria *nivel) {
+    if (strcmp(nome, "desligada") == 0) {
+        *nivel = TELEMETRIA_DESLIGADA;
+        return 1;
+    }
+    if (strcmp(nome, "melhor") == 0) {
+        *nivel = TELEMETRIA_MELHOR;
+        return 1;
+    }
+    if (strcmp(nome, "completa") == 0) {
+        *nivel = TELEMETRIA_COMPLETA;
+        return 1;
+    }
+    return 0;
+}
+
+const char *nomesTelemetria(void) {
+    return "desligada, melhor, completa";
+}
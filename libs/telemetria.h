@@ -0,0 +1,82 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef TELEMETRIA_H
+#define TELEMETRIA_H
+#include <stdio.h>
+#include <pthread.h>
+#include "enxame.h"
+
+// Compile com -DPSO_TELEMETRIA=0 para remover a telemetria do laço do PSO
+#ifndef PSO_TELEMETRIA
+#define PSO_TELEMETRIA 1
+#endif
+
+// O que é registrado a cada iteração
+typedef enum {
+   TELEMETRIA_DESLIGADA, // Nada
+   TELEMETRIA_MELHOR,    // Só o gBest
+   TELEMETRIA_COMPLETA   // gBest, aptidão média e diversidade (distância média ao centróide)
+} NivelTelemetria;
+
+// Histórico de convergência de uma execução, em anéis pré-alocados (sem alocação no laço)
+typedef struct Telemetria {
+   NivelTelemetria nivel;
+   int capacidade;        // Iterações guardadas; as mais antigas são sobrescritas
+   int registrados;       // Iterações registradas na execução atual
+   double *melhor;        // gBest por iteração [capacidade]
+   double *media;         // Aptidão média por iteração [capacidade]
+   double *diversidade;   // Diversidade por iteração [capacidade]
+   double *centroide;     // Rascunho do centróide [dimensões]
+   char *texto;           // Rascunho para formatar a execução antes de gravar
+   size_t tamanhoTexto;
+} Telemetria;
+
+// Arquivo colunar compartilhado: uma linha por execução e métrica
+// (execucao,metrica,primeira_iteracao,v0,v1,...), gravada de uma vez no fim da execução
+typedef struct {
+   FILE *arquivo;
+   pthread_mutex_t trava;
+} ArquivoTelemetria;
+
+
+// Aloca os anéis (uma única alocação) para até capacidade iterações em dimensoes dimensões
+void criarTelemetria(Telemetria *telemetria, NivelTelemetria nivel, int capacidade, int dimensoes);
+
+
+// Esquece o histórico para começar uma nova execução
+void reiniciarTelemetria(Telemetria *telemetria);
+
+
+// Registra o estado do enxame ao fim de uma iteração
+void registrarIteracao(Telemetria *telemetria, const Swarm *enxame);
+
+
+// Libera os anéis
+void liberarTelemetria(Telemetria *telemetria);
+
+
+// Abre o arquivo de convergência e escreve o cabeçalho
+void abrirArquivoTelemetria(ArquivoTelemetria *arquivo, const char *caminho);
+
+
+// Grava o histórico de uma execução (a chamada pode vir de qualquer thread)
+void descarregarTelemetria(ArquivoTelemetria *arquivo, Telemetria *telemetria, long long execucao);
+
+
+// Fecha o arquivo de convergência
+void fecharArquivoTelemetria(ArquivoTelemetria *arquivo);
+
+
+// Nível a partir do nome ("desligada", "melhor" ou "completa"); retorna 0 se o nome não existir
+int telemetriaPorNome(const char *nome, NivelTelemetria *nivel);
+const char *nomesTelemetria(void);
+
+
+// Ponto de registro usado pelos motores: some do binário com PSO_TELEMETRIA=0
+#if PSO_TELEMETRIA
+#define TELEMETRIA_REGISTRAR(telemetria, enxame) \
+    do { if ((telemetria) != NULL) registrarIteracao((telemetria), (enxame)); } while (0)
+#else
+#define TELEMETRIA_REGISTRAR(telemetria, enxame) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,21 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef TEMPO_H
+#define TEMPO_H
+#include <time.h>
+
+// Relógio monotônico de parede em segundos (clock() mede CPU do processo inteiro, não serve com threads)
+static inline double tempoAtual(void) {
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    return (double)agora.tv_sec + (double)agora.tv_nsec * 1e-9;
+}
+
+// Suspende a thread por alguns segundos (latência simulada de um avaliador externo)
+static inline void dormir(double segundos) {
+    struct timespec espera;
+    espera.tv_sec = (time_t)segundos;
+    espera.tv_nsec = (long)((segundos - (double)espera.tv_sec) * 1e9);
+    nanosleep(&espera, NULL);
+}
+
+#endif
@@ -0,0 +1,147 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "topologia.h"
+
+// Realoca um vetor só se a capacidade atual não couber
+static void *garantirCapacidade(void *vetor, size_t *capacidade, size_t necessario, size_t tamanho) {
+    if (vetor != NULL && *capacidade >= necessario) {
+        return vetor;
+    }
+    free(vetor);
+    vetor = malloc(necessario * tamanho);
+    if (vetor == NULL) {
+        printf("Erro ao alocar a topologia\n");
+        exit(1);
+    }
+    *capacidade = necessario;
+    return vetor;
+}
+
+// Sorteia k vizinhos de cada partícula (podem repetir, como no SPSO 2011); a coluna 0 é ela mesma
+static void sortearVizinhos(Topologia *topologia, Swarm *enxame) {
+    int n = topologia->numParticulas;
+    for (int i = 0; i < n; i++) {
+        int *linha = &topologia->vizinhos[(size_t)i * topologia->numVizinhos];
+        linha[0] = i;
+        for (int k = 1; k < topologia->numVizinhos; k++) {
+            linha[k] = (int)(uniformeAleatorio(&enxame->gerador) * n);
+        }
+    }
+}
+
+void montarTopologia(Topologia *topologia, TipoTopologia tipo, int vizinhosAleatorios, Swarm *enxame) {
+    int n = enxame->numParticles;
+
+    topologia->tipo = tipo;
+    topologia->numParticulas = n;
+    topologia->stride = enxame->stride;
+    topologia->vizinhosAleatorios = vizinhosAleatorios > 0 ? vizinhosAleatorios : VIZINHOS_ALEATORIOS_PADRAO;
+    switch (tipo) {
+        case TOPOLOGIA_ANEL: topologia->numVizinhos = 3; break;
+        case TOPOLOGIA_VON_NEUMANN: topologia->numVizinhos = 5; break;
+        case TOPOLOGIA_ALEATORIA: topologia->numVizinhos = topologia->vizinhosAleatorios + 1; break;
+        default: topologia->numVizinhos = 1; break;
+    }
+
+    topologia->vizinhos = (int *)garantirCapacidade(topologia->vizinhos, &topologia->capacidadeVizinhos,
+                                                    (size_t)n * topologia->numVizinhos, sizeof(int));
+    topologia->lider = (int *)garantirCapacidade(topologia->lider, &topologia->capacidadeLider, (size_t)n, sizeof(int));
+    topologia->melhorLocal = (double *)garantirCapacidade(topologia->melhorLocal, &topologia->capacidadeLocal,
+                                                          (size_t)enxame->dimensions * enxame->stride, sizeof(double));
+
+    // grade de Von Neumann com colunas = teto(raiz(n)); os índices dão a volta no enxame
+    int colunas = (int)ceil(sqrt((double)n));
+    for (int i = 0; i < n; i++) {
+        int *linha = &topologia->vizinhos[(size_t)i * topologia->numVizinhos];
+        linha[0] = i;
+        if (tipo == TOPOLOGIA_ANEL) {
+            linha[1] = (i + n - 1) % n;
+            linha[2] = (i + 1) % n;
+        } else if (tipo == TOPOLOGIA_VON_NEUMANN) {
+            linha[1] = (i + n - 1) % n;
+            linha[2] = (i + 1) % n;
+            linha[3] = (i + n - colunas % n) % n;
+            linha[4] = (i + colunas) % n;
+        }
+    }
+    if (tipo == TOPOLOGIA_ALEATORIA) {
+        sortearVizinhos(topologia, enxame);
+    }
+}
+
+void atualizarLideres(Topologia *topologia, const Swarm *enxame) {
+    const double *aptidao = enxame->bestFitness;
+    int m = topologia->numVizinhos;
+
+    for (int i = 0; i < topologia->numParticulas; i++) {
+        const int *linha = &topologia->vizinhos[(size_t)i * m];
+        int lider = linha[0];
+        for (int k = 1; k < m; k++) {
+            lider = aptidao[linha[k]] < aptidao[lider] ? linha[k] : lider;
+        }
+        topologia->lider[i] = lider;
+    }
+    // uma coleta por dimensão deixa melhorLocal contíguo para o laço da velocidade
+    for (int d = 0; d < enxame->dimensions; d++) {
+        const double *melhor = &COORD(enxame, bestPosition, d, 0);
+        double *local = &topologia->melhorLocal[(size_t)d * topologia->stride];
+        for (int i = 0; i < topologia->numParticulas; i++) {
+            local[i] = melhor[topologia->lider[i]];
+        }
+    }
+}
+
+void religarTopologia(Topologia *topologia, Swarm *enxame) {
+    if (topologia->tipo == TOPOLOGIA_ALEATORIA) {
+        sortearVizinhos(topologia, enxame);
+    }
+}
+
+void atualizarVelocidadeLocal(Swarm *enxame, const Topologia *topologia, double w, double c1, double c2) {
+    for (int d = 0; d < enxame->dimensions; d++) {
+        double *velocidade = &COORD(enxame, velocity, d, 0);
+        const double *posicao = &COORD(enxame, position, d, 0);
+        const double *melhor = &COORD(enxame, bestPosition, d, 0);
+        const double *local = &topologia->melhorLocal[(size_t)d * topologia->stride];
+        double *r1 = &COORD(enxame, r1, d, 0);
+        double *r2 = &COORD(enxame, r2, d, 0);
+
+        // mesma ordem de sorteio de atualizarVelocidade
+        gerarUniformes(&enxame->gerador, r1, enxame->numParticles);
+        gerarUniformes(&enxame->gerador, r2, enxame->numParticles);
+        for (int i = 0; i < enxame->numParticles; i++) {
+            velocidade[i] = w * velocidade[i] +
+                            c1 * r1[i] * (melhor[i] - posicao[i]) +
+                            c2 * r2[i] * (local[i] - posicao[i]);
+        }
+    }
+}
+
+void liberarTopologia(Topologia *topologia) {
+    free(topologia->vizinhos);
+    free(topologia->lider);
+    free(topologia->melhorLocal);
+    memset(topologia, 0, sizeof(*topologia));
+}
+
+const char *nomeTopologia(TipoTopologia tipo) {
+    static const char *NOMES[] = {"global", "anel", "vonneumann", "aleatoria"};
+    return NOMES[tipo];
+}
+
+int topologiaPorNome(const char *nome, TipoTopologia *tipo) {
+    for (int k = TOPOLOGIA_GLOBAL; k <= TOPOLOGIA_ALEATORIA; k++) {
+        if (strcmp(nome, nomeTopologia((TipoTopologia)k)) == 0) {
+            *tipo = (TipoTopologia)k;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+const char *nomesTopologias(void) {
+    return "global, anel, vonneumann, aleatoria";
+}
@@ -0,0 +1,64 @@
+// Feito por: Lucas Garcia E Luis Augusto
+#ifndef TOPOLOGIA_H
+#define TOPOLOGIA_H
+#include <stddef.h>
+#include "enxame.h"
+
+// Vizinhos sorteados por partícula na topologia aleatória, além dela mesma
+#define VIZINHOS_ALEATORIOS_PADRAO 3
+
+// De quem cada partícula aprende a componente social
+typedef enum {
+   TOPOLOGIA_GLOBAL,      // Estrela: o gBest do enxame todo (motor clássico sem tabela)
+   TOPOLOGIA_ANEL,        // i - 1, i, i + 1 (circular)
+   TOPOLOGIA_VON_NEUMANN, // i, i +- 1 e i +- colunas numa grade circular
+   TOPOLOGIA_ALEATORIA    // i e k partículas sorteadas, religadas quando o gBest não melhora
+} TipoTopologia;
+
+// Vizinhanças de um enxame em tabela contígua: a linha i lista os vizinhos da partícula i.
+// A cada iteração o líder (melhor pBest) de cada vizinhança é resolvido uma vez e a posição
+// dele é copiada para melhorLocal, dimensão-major como o enxame: o laço da velocidade fica
+// contíguo e vetoriza como no gBest.
+typedef struct {
+   TipoTopologia tipo;
+   int numVizinhos;          // Tamanho de cada linha (inclui a própria partícula)
+   int numParticulas;
+   int stride;               // O mesmo stride do enxame
+   int *vizinhos;            // [numParticulas][numVizinhos]
+   int *lider;               // Partícula com o melhor pBest da vizinhança de cada uma [numParticulas]
+   double *melhorLocal;      // Posição do líder de cada partícula [dimensoes][stride]
+   size_t capacidadeVizinhos; // Inteiros alocados em vizinhos
+   size_t capacidadeLider;   // Inteiros alocados em lider
+   size_t capacidadeLocal;   // Doubles alocados em melhorLocal
+   int vizinhosAleatorios;   // k da topologia aleatória
+} Topologia;
+
+
+// Monta a tabela para o enxame (reaproveita os vetores quando couberem). A topologia aleatória
+// sorteia os vizinhos com o gerador do enxame. A topologia deve começar zerada.
+void montarTopologia(Topologia *topologia, TipoTopologia tipo, int vizinhosAleatorios, Swarm *enxame);
+
+
+// Resolve o líder de cada vizinhança pelos pBest atuais e copia as posições para melhorLocal
+void atualizarLideres(Topologia *topologia, const Swarm *enxame);
+
+
+// Religa a topologia aleatória (as demais são fixas); chamada quando o gBest não melhora
+void religarTopologia(Topologia *topologia, Swarm *enxame);
+
+
+// Atualiza a velocidade com o melhor da vizinhança no lugar do gBest
+void atualizarVelocidadeLocal(Swarm *enxame, const Topologia *topologia, double w, double c1, double c2);
+
+
+// Libera os vetores da topologia
+void liberarTopologia(Topologia *topologia);
+
+
+// Nome e conversão a partir do nome (global, anel, vonneumann, aleatoria);
+// a conversão retorna 0 se o nome não existir
+const char *nomeTopologia(TipoTopologia tipo);
+int topologiaPorNome(const char *nome, TipoTopologia *tipo);
+const char *nomesTopologias(void);
+
+#endif
@@ -30,242 +30,1158 @@ double senoPersonalizado(double x) {
 
 // Função objetivo (Eggholder)
 double eggholder(double x, double y) {
+    return eggholderRapido(x, y);
+}
+
+// Eggholder original, com o seno de Taylor e a raiz de Newton (referência de precisão)
+double eggholderPersonalizado(double x, double y) {
     return -(y + 47) * senoPersonalizado(raizQuadradaPersonalizada(valorAbsolutoPersonalizado((x / 2) + y + 47))) - 
            x * senoPersonalizado(raizQuadradaPersonalizada(valorAbsolutoPersonalizado(x - (y + 47))));
 }
 
-// Inicializa o enxame
-void inicializarEnxame(Swarm *enxame, int numParticulas, int dimensoes, double posMin, double posMax, double velMax) {
-    enxame->particles = (Particle *)malloc(numParticulas * sizeof(Particle));
-    enxame->globalBestPosition = (double *)malloc(dimensoes * sizeof(double));
-    enxame->globalBestFitness = DBL_MAX;
-    enxame->numParticles = numParticulas;
-    enxame->dimensions = dimensoes;
+// Compara cada implementação do kernel com a libm e com a Eggholder original
+int verificarPrecisaoEggholder() {
+    const int lado = 257;
+    const double tolerancia = 1e-9;
+    int total = lado * lado, falhas = 0;
+    double *x = (double *)malloc(total * sizeof(double));
+    double *y = (double *)malloc(total * sizeof(double));
+    double *saida = (double *)malloc(total * sizeof(double));
+    ImplementacaoEggholder lista[4];
+    int numImplementacoes = listarImplementacoesEggholder(lista, 4);
 
-    for (int i = 0; i < numParticulas; i++) {
-        Particle *p = &enxame->particles[i];
-        p->position = (double *)malloc(dimensoes * sizeof(double));
-        p->velocity = (double *)malloc(dimensoes * sizeof(double));
-        p->bestPosition = (double *)malloc(dimensoes * sizeof(double));
-        p->fitness = DBL_MAX;
-        p->bestFitness = DBL_MAX;
+    // grade sobre [-512, 512]^2, incluindo as bordas e o ótimo global
+    for (int i = 0; i < lado; i++) {
+        for (int j = 0; j < lado; j++) {
+            x[i * lado + j] = -512 + 1024.0 * i / (lado - 1);
+            y[i * lado + j] = -512 + 1024.0 * j / (lado - 1);
+        }
+    }
+    x[0] = 512;
+    y[0] = 404.2319;
 
-        for (int d = 0; d < dimensoes; d++) {
-            p->position[d] = posMin + (posMax - posMin) * ((double)rand() / RAND_MAX);
-            p->velocity[d] = -velMax + 2 * velMax * ((double)rand() / RAND_MAX);
-            p->bestPosition[d] = p->position[d];
+    printf("Kernel selecionado: %s\n", implementacaoEggholder());
+    for (int k = 0; k < numImplementacoes; k++) {
+        if (!lista[k].disponivel) {
+            printf("%-8s indisponivel nesta CPU\n", lista[k].nome);
+            continue;
+        }
+        double erroLibm = 0.0, erroOriginal = 0.0;
+        lista[k].kernel(x, y, saida, total);
+        for (int i = 0; i < total; i++) {
+            double libm = -(y[i] + 47) * sin(sqrt(fabs(x[i] / 2 + y[i] + 47))) - x[i] * sin(sqrt(fabs(x[i] - (y[i] + 47))));
+            double original = eggholderPersonalizado(x[i], y[i]);
+            erroLibm = fmax(erroLibm, fabs(saida[i] - libm));
+            erroOriginal = fmax(erroOriginal, fabs(saida[i] - original));
+        }
+        printf("%-8s erro max vs libm: %.3e, vs original: %.3e\n", lista[k].nome, erroLibm, erroOriginal);
+        if (erroLibm > tolerancia) {
+            falhas++;
         }
     }
+
+    free(x);
+    free(y);
+    free(saida);
+    return falhas;
+}
+
+// Uma execução curta da Rastrigin 10D com a semente fixa; retorna as avaliações contadas pelo motor
+long long execucaoDeVerificacao(const ParametrosPSO *parametros, ResultadoPSO *resultado){
+    Swarm enxame;
+    memset(&enxame, 0, sizeof(enxame));
+    semearGerador(&enxame.gerador, GERADOR_XOSHIRO256, 12345);
+    enxame.objetivo = parametros->objetivo;
+    inicializarEnxame(&enxame, 50, parametros->dimensoes, parametros->posMin, parametros->posMax, parametros->velMax);
+    executarPSOConfigurado(&enxame, parametros, resultado);
+    liberarEnxame(&enxame);
+    return resultado->avaliacoes;
+}
+
+// Confere que só as avaliações de fato são contadas: os descartes do modelo substituto e os
+// acertos do cache não entram em avaliacoes nem gastam o orçamento de --avaliacoes-max
+int verificarContagemAvaliacoes() {
+    ParametrosPSO parametros = parametrosPadrao();
+    ResultadoPSO resultado;
+    ModeloSubstituto modelo;
+    CacheAptidao cache;
+    int falhas = 0;
+
+    parametros.dimensoes = 10;
+    parametros.iteracoes = 100;
+    objetivoPorNome("rastrigin", parametros.dimensoes, &parametros.objetivo);
+    parametros.posMin = parametros.objetivo.posMin;
+    parametros.posMax = parametros.objetivo.posMax;
+    parametros.velMax = 0.075 * (parametros.posMax - parametros.posMin);
+
+    long long todas = execucaoDeVerificacao(&parametros, &resultado);
+    printf("sem substituto: %lld avaliacoes em %d iteracoes\n", todas, resultado.iteracoes);
+    // a inicialização também avalia o enxame
+    falhas += todas != 50LL * (parametros.iteracoes + 1);
+
+    criarSubstituto(&modelo, parametros.dimensoes, 0, 0, 2.0);
+    parametros.objetivo.substituto = &modelo;
+    long long triadas = execucaoDeVerificacao(&parametros, &resultado);
+    printf("com substituto: %lld avaliacoes, %lld descartadas\n", triadas, modelo.estatistica.descartados);
+    falhas += modelo.estatistica.descartados == 0 || triadas != todas - modelo.estatistica.descartados;
+
+    // com o mesmo orçamento os descartes compram iterações
+    parametros.parada.avaliacoesMaximas = 2000;
+    parametros.objetivo.substituto = NULL;
+    execucaoDeVerificacao(&parametros, &resultado);
+    int iteracoesSem = resultado.iteracoes;
+    esvaziarSubstituto(&modelo);
+    parametros.objetivo.substituto = &modelo;
+    execucaoDeVerificacao(&parametros, &resultado);
+    printf("orcamento de 2000: %d iteracoes sem substituto, %d com\n", iteracoesSem, resultado.iteracoes);
+    falhas += resultado.iteracoes <= iteracoesSem || resultado.avaliacoes > parametros.parada.avaliacoesMaximas;
+    parametros.objetivo.substituto = NULL;
+    parametros.parada.avaliacoesMaximas = 0;
+    liberarSubstituto(&modelo);
+
+    // chave quantizada grossa: as partículas que convergem caem nas mesmas células
+    criarCache(&cache, parametros.dimensoes, 0.5, 1.0);
+    parametros.objetivo.cache = &cache;
+    long long comCache = execucaoDeVerificacao(&parametros, &resultado);
+    printf("com cache: %lld avaliacoes, %lld acertos\n", comCache, cache.estatistica.acertos);
+    falhas += cache.estatistica.acertos == 0 || comCache != todas - cache.estatistica.acertos;
+    liberarCache(&cache);
+
+    printf(falhas == 0 ? "Contagem de avaliacoes: ok\n" : "Contagem de avaliacoes: %d falhas\n", falhas);
+    return falhas;
 }
 
-// Avalia a aptidão
-double avaliarAptidao(double *posicao) {
-    return eggholder(posicao[0], posicao[1]);
+// ========== FIM DAS FUNÇÕES do trabalho ===========
+
+// Grava o resultado de uma execução no escritor
+void gerarRelatorio(EscritorResultados *escritor, const CelulaPlano *celula, const Execucao *execucao, int indice){
+    RegistroResultado registro;
+
+    registro.indice = indice;
+    registro.celula = execucao->celula;
+    registro.rodada = execucao->rodada;
+    registro.semente = execucao->semente;
+    registro.populacao = celula->populacao;
+    registro.iteracoes = celula->iteracoes;
+    registro.w = celula->w;
+    registro.c1 = celula->c1;
+    registro.c2 = celula->c2;
+    registro.melhor = execucao->resultado;
+    registro.melhorPosicao = execucao->melhorPosicao;
+    registro.iteracoesExecutadas = execucao->iteracoesExecutadas;
+    registro.avaliacoes = execucao->avaliacoes;
+    registro.criterio = nomeCriterio(execucao->criterio);
+    registro.tempo = execucao->tempo;
+    registrarResultado(escritor, &registro);
 }
 
-// Atualiza velocidade
-void atualizarVelocidade(Particle *particula, double *globalBestPosition, int dimensoes, double w, double c1, double c2) {
-    for (int d = 0; d < dimensoes; d++) {
-        double r1 = (double)rand() / RAND_MAX;
-        double r2 = (double)rand() / RAND_MAX;
-        particula->velocity[d] = w * particula->velocity[d] +
-                                 c1 * r1 * (particula->bestPosition[d] - particula->position[d]) +
-                                 c2 * r2 * (globalBestPosition[d] - particula->position[d]);
+// Imprime a média e o desvio padrão de cada célula e grava o resumo
+void gerarRelatorioMediaeDesvioPadrao(const PlanoExpandido *plano, const char *caminhoResumo){
+    FILE *resumo = fopen(caminhoResumo, "w");
+    if (resumo == NULL) {
+        printf("Erro ao abrir o arquivo %s\n", caminhoResumo);
+        exit(1);
+    }
+    fprintf(resumo, "celula,populacao,iteracoes,w,c1,c2,pos_min,pos_max,vmax,execucoes,media,desvio_padrao,melhor,pior\n");
+
+    printf("\n\t\t =====| MEDIA E DESVIO PADRAO |=====\n\n");
+    for (int c = 0; c < plano->numCelulas; c++){
+        const CelulaPlano *celula = &plano->celulas[c];
+        const Estatistica *estatistica = &celula->estatistica;
+        double desvioPadrao = desvioEstatistica(estatistica);
+
+        printf("Populacao: %d, Iteracoes: %d, w: %g, c1: %g, c2: %g, Media: %0.6f, DesvioPadrão: %0.6f, Melhor: %0.6f\n",
+               celula->populacao, celula->iteracoes, celula->w, celula->c1, celula->c2, estatistica->media, desvioPadrao, estatistica->melhor);
+        fprintf(resumo, "%d,%d,%d,%.6g,%.6g,%.6g,%.6g,%.6g,%.6g,%lld,%.10f,%.10f,%.10f,%.10f\n",
+                c, celula->populacao, celula->iteracoes, celula->w, celula->c1, celula->c2, celula->posMin, celula->posMax, celula->velMax,
+                estatistica->n, estatistica->media, desvioPadrao, estatistica->melhor, estatistica->pior);
+    }
+    if (ferror(resumo) || fclose(resumo) != 0) {
+        printf("Erro ao gravar o arquivo %s\n", caminhoResumo);
+        exit(1);
     }
 }
 
-// Atualiza posição
-void atualizarPosicao(Particle *particula, double posMin, double posMax, int dimensoes) {
-    for (int d = 0; d < dimensoes; d++) {
-        particula->position[d] += particula->velocity[d];
-        if (particula->position[d] < posMin) {
-            particula->position[d] = posMin;
-            particula->velocity[d] = 0;
-        } else if (particula->position[d] > posMax) {
-            particula->position[d] = posMax;
-            particula->velocity[d] = 0;
+// Executa uma rodada da varredura no enxame (arena) do trabalhador
+void executar(Execucao *execucao, int indice, int trabalhador, Varredura *varredura){
+    const CelulaPlano *celula = &varredura->plano->celulas[execucao->celula];
+    Swarm *enxame = &varredura->enxames[trabalhador];
+    Telemetria *telemetria = varredura->telemetrias != NULL ? &varredura->telemetrias[trabalhador] : NULL;
+    AvaliadorAssincrono *avaliador = varredura->avaliadores != NULL ? &varredura->avaliadores[trabalhador] : NULL;
+    SalvamentoTrabalhador *salvamento = varredura->salvamentos != NULL ? &varredura->salvamentos[trabalhador] : NULL;
+    ModeloIlhas *ilhas = varredura->ilhas != NULL ? &varredura->ilhas[trabalhador] : NULL;
+    ParametrosPSO parametros = varredura->config->parametros;
+    parametros.iteracoes = celula->iteracoes;
+    parametros.w = celula->w;
+    parametros.c1 = celula->c1;
+    parametros.c2 = celula->c2;
+    parametros.posMin = celula->posMin;
+    parametros.posMax = celula->posMax;
+    parametros.velMax = celula->velMax;
+
+    if (telemetria != NULL) {
+        parametros.telemetria = telemetria;
+        reiniciarTelemetria(telemetria);
+    }
+    parametros.instrumentacao = varredura->instrumentacoes != NULL ? &varredura->instrumentacoes[trabalhador] : NULL;
+    parametros.grupo = varredura->grupos != NULL ? &varredura->grupos[trabalhador] : NULL;
+    parametros.vizinhanca = varredura->vizinhancas != NULL ? &varredura->vizinhancas[trabalhador] : NULL;
+    parametros.elite = varredura->elites != NULL ? &varredura->elites[trabalhador] : NULL;
+    // o cache e o modelo substituto valem só dentro da execução: uma rodada não herda as aptidões
+    // aproximadas nem as previsões de outra
+    if (varredura->caches != NULL) {
+        esvaziarCache(&varredura->caches[trabalhador]);
+        parametros.objetivo.cache = &varredura->caches[trabalhador];
+    }
+    if (varredura->substitutos != NULL) {
+        esvaziarSubstituto(&varredura->substitutos[trabalhador]);
+        parametros.objetivo.substituto = &varredura->substitutos[trabalhador];
+    }
+    semearGerador(&enxame->gerador, varredura->config->tipoGerador, execucao->semente);
+    enxame->objetivo = parametros.objetivo;
+    ResultadoPSO resultado;
+    double inicio = tempoAtual();
+    if (ilhas != NULL) {
+        // as ilhas dividem a população em subenxames com arenas próprias; só as concluídas vão para a retomada
+        execucao->resultado = executarIlhas(ilhas, &parametros, celula->populacao, varredura->config->tipoGerador, execucao->semente,
+                                            &resultado, execucao->melhorPosicao);
+    } else if (avaliador != NULL) {
+        // no motor assíncrono até as posições iniciais passam pela fila dos avaliadores
+        sortearEnxame(enxame, celula->populacao, parametros.dimensoes, parametros.posMin, parametros.posMax, parametros.velMax);
+        execucao->resultado = executarPSOAssincrono(enxame, &parametros, avaliador, &resultado);
+    } else {
+        // com retomada a execução continua de onde o arquivo anterior parou, se estava em andamento
+        if (salvamento == NULL || !comecarExecucao(salvamento, indice, enxame)) {
+            inicializarEnxame(enxame, celula->populacao, parametros.dimensoes, parametros.posMin, parametros.posMax, parametros.velMax);
         }
+        // a tabela da topologia aleatória e o arquivo de elite não vão para o arquivo de retomada:
+        // nesses casos só as execuções concluídas são salvas
+        int continuavel = parametros.topologia != TOPOLOGIA_ALEATORIA && parametros.elite == NULL;
+        parametros.salvamento = salvamento != NULL && continuavel ? &salvamento->ponto : NULL;
+        execucao->resultado = executarPSOConfigurado(enxame, &parametros, &resultado);
+    }
+    execucao->tempo = salvamento != NULL && avaliador == NULL && ilhas == NULL ? tempoDaExecucao(salvamento) : tempoAtual() - inicio;
+    execucao->iteracoesExecutadas = resultado.iteracoes;
+    execucao->avaliacoes = resultado.avaliacoes;
+    execucao->criterio = resultado.criterio;
+    if (ilhas == NULL) {
+        memcpy(execucao->melhorPosicao, enxame->globalBestPosition, parametros.dimensoes * sizeof(double));
     }
 }
 
-// Atualiza melhores posições
-void atualizarMelhoresPosicoes(Swarm *enxame) {
-    for (int i = 0; i < enxame->numParticles; i++) {
-        Particle *p = &enxame->particles[i];
-        p->fitness = avaliarAptidao(p->position);
-        if (p->fitness < p->bestFitness) {
-            p->bestFitness = p->fitness;
-            for (int d = 0; d < enxame->dimensions; d++) {
-                p->bestPosition[d] = p->position[d];
-            }
+// Grava a execução concluída no arquivo de retomada
+void salvarConcluida(Varredura *varredura, const Execucao *execucao, int indice){
+    RegistroRetomada registro;
+    registro.iteracoes = execucao->iteracoesExecutadas;
+    registro.criterio = execucao->criterio;
+    registro.avaliacoes = execucao->avaliacoes;
+    registro.resultado = execucao->resultado;
+    registro.tempo = execucao->tempo;
+    registrarConcluida(&varredura->retomada, indice, &registro, execucao->melhorPosicao);
+}
+
+// Marca as execuções [primeira, primeira + quantidade) como concluídas e grava, na ordem da
+// varredura, todas as que já estão concluídas em sequência
+void concluirExecucoes(Varredura *varredura, int primeira, int quantidade){
+    pthread_mutex_lock(&varredura->trava);
+    for (int i = primeira; i < primeira + quantidade; i++){
+        varredura->execucoes[i].concluida = 1;
+    }
+    // a estatística de cada célula acumula na mesma ordem, independente do número de threads
+    while (varredura->proxima < varredura->fim && varredura->execucoes[varredura->proxima].concluida){
+        Execucao *pronta = &varredura->execucoes[varredura->proxima];
+        CelulaPlano *celula = &varredura->plano->celulas[pronta->celula];
+        gerarRelatorio(&varredura->escritor, celula, pronta, varredura->proxima);
+        acumularEstatistica(&celula->estatistica, pronta->resultado);
+        varredura->proxima++;
+    }
+    pthread_mutex_unlock(&varredura->trava);
+}
+
+// Tarefa do agendador: cada trabalhador reaproveita o próprio enxame entre execuções
+void executarTarefaDaVarredura(int tarefa, int trabalhador, void *contexto){
+    Varredura *varredura = (Varredura *)contexto;
+    int indice = varredura->primeira + tarefa;
+    Execucao *execucao = &varredura->execucoes[indice];
+
+    // herdada do arquivo de retomada: só entra na gravação em ordem
+    if (execucao->restaurada) {
+        concluirExecucoes(varredura, indice, 1);
+        return;
+    }
+    executar(execucao, indice, trabalhador, varredura);
+    if (varredura->telemetrias != NULL) {
+        descarregarTelemetria(&varredura->arquivoTelemetria, &varredura->telemetrias[trabalhador], indice);
+    }
+    if (varredura->salvamentos != NULL) {
+        salvarConcluida(varredura, execucao, indice);
+    }
+    concluirExecucoes(varredura, indice, 1);
+}
+
+// Tarefa do agendador no motor em lote: várias execuções da mesma célula evoluem juntas
+void executarLoteDaVarredura(int tarefa, int trabalhador, void *contexto){
+    Varredura *varredura = (Varredura *)contexto;
+    int primeira = varredura->inicioLotes[tarefa];
+    int quantidade = varredura->inicioLotes[tarefa + 1] - primeira;
+    Execucao *execucoes = &varredura->execucoes[primeira];
+    const CelulaPlano *celula = &varredura->plano->celulas[execucoes[0].celula];
+    LoteEnxames *lote = &varredura->lotes[trabalhador];
+    unsigned long long sementes[MAX_ENXAMES_POR_LOTE];
+    ResultadoPSO resultados[MAX_ENXAMES_POR_LOTE];
+    double inicio = tempoAtual();
+
+    ParametrosPSO parametros = varredura->config->parametros;
+    parametros.iteracoes = celula->iteracoes;
+    parametros.w = celula->w;
+    parametros.c1 = celula->c1;
+    parametros.c2 = celula->c2;
+    parametros.posMin = celula->posMin;
+    parametros.posMax = celula->posMax;
+    parametros.velMax = celula->velMax;
+    parametros.instrumentacao = varredura->instrumentacoes != NULL ? &varredura->instrumentacoes[trabalhador] : NULL;
+
+    for (int s = 0; s < quantidade; s++){
+        sementes[s] = execucoes[s].semente;
+    }
+    lote->objetivo = parametros.objetivo;
+    inicializarLote(lote, sementes, quantidade, celula->populacao, parametros.dimensoes, parametros.posMin, parametros.posMax, parametros.velMax);
+    executarLote(lote, &parametros, resultados);
+
+    // o tempo do lote é dividido igualmente entre as execuções
+    double tempo = (tempoAtual() - inicio) / quantidade;
+    for (int s = 0; s < quantidade; s++){
+        execucoes[s].resultado = resultados[s].melhor;
+        execucoes[s].iteracoesExecutadas = resultados[s].iteracoes;
+        execucoes[s].avaliacoes = resultados[s].avaliacoes;
+        execucoes[s].criterio = resultados[s].criterio;
+        execucoes[s].tempo = tempo;
+        melhorPosicaoDoLote(lote, s, execucoes[s].melhorPosicao);
+    }
+    concluirExecucoes(varredura, primeira, quantidade);
+}
+
+// Agrupa as execuções consecutivas da mesma célula em [primeira, fim) em lotes de até enxamesPorLote; devolve quantos lotes
+int montarLotes(Varredura *varredura, int primeira, int fim, int enxamesPorLote){
+    int numLotes = 0;
+
+    for (int i = primeira; i < fim; i++){
+        int inicio = numLotes > 0 ? varredura->inicioLotes[numLotes - 1] : primeira;
+        if (numLotes == 0 || i - inicio == enxamesPorLote || varredura->execucoes[i].celula != varredura->execucoes[inicio].celula) {
+            varredura->inicioLotes[numLotes++] = i;
+        }
+    }
+    varredura->inicioLotes[numLotes] = fim;
+    return numLotes;
+}
+
+// Aloca o estado da varredura (enxames, telemetria, retomada e o que cada motor usa) e abre o escritor
+void abrirVarredura(Varredura *varredura, PlanoExpandido *plano, const ConfiguracaoVarredura *config){
+    int total = plano->numTarefas;
+    int dimensoes = config->parametros.dimensoes;
+
+    varredura->config = config;
+    varredura->plano = plano;
+    varredura->primeira = 0;
+    varredura->fim = total;
+    varredura->proxima = 0;
+    varredura->total = total;
+    varredura->execucoes = (Execucao *)calloc(total > 0 ? total : 1, sizeof(Execucao));
+    varredura->posicoes = (double *)calloc((size_t)(total > 0 ? total : 1) * dimensoes, sizeof(double));
+    varredura->enxames = (Swarm *)calloc(config->numTrabalhadores, sizeof(Swarm));
+    if (varredura->execucoes == NULL || varredura->posicoes == NULL || varredura->enxames == NULL) {
+        printf("Erro ao alocar a varredura\n");
+        exit(1);
+    }
+    pthread_mutex_init(&varredura->trava, NULL);
+
+    // um anel de convergência por trabalhador, do tamanho da maior quantidade de iterações
+    varredura->telemetrias = NULL;
+    if (config->nivelTelemetria != TELEMETRIA_DESLIGADA) {
+        int capacidade = plano->maiorIteracao > 0 ? plano->maiorIteracao : 1;
+        varredura->telemetrias = (Telemetria *)calloc(config->numTrabalhadores, sizeof(Telemetria));
+        if (varredura->telemetrias == NULL) {
+            printf("Erro ao alocar a telemetria\n");
+            exit(1);
+        }
+        for (int t = 0; t < config->numTrabalhadores; t++){
+            criarTelemetria(&varredura->telemetrias[t], config->nivelTelemetria, capacidade, dimensoes);
+        }
+        abrirArquivoTelemetria(&varredura->arquivoTelemetria, config->caminhoTelemetria);
+    }
+    // acumuladores de tempo por fase, um por trabalhador
+    varredura->instrumentacoes = NULL;
+    if (config->instrumentar) {
+        varredura->instrumentacoes = (Instrumentacao *)calloc(config->numTrabalhadores, sizeof(Instrumentacao));
+        if (varredura->instrumentacoes == NULL) {
+            printf("Erro ao alocar a instrumentacao\n");
+            exit(1);
+        }
+        for (int t = 0; t < config->numTrabalhadores; t++){
+            criarInstrumentacao(&varredura->instrumentacoes[t], config->contadoresHardware);
+        }
+    }
+    for (int i = 0; i < total; i++){
+        const TarefaPlano *tarefa = &plano->tarefas[i];
+        varredura->execucoes[i].celula = tarefa->celula;
+        varredura->execucoes[i].rodada = tarefa->replica + 1;
+        varredura->execucoes[i].semente = tarefa->semente;
+        varredura->execucoes[i].melhorPosicao = &varredura->posicoes[(size_t)i * dimensoes];
+    }
+
+    // retomada: o arquivo mapeado guarda as execuções concluídas e a em andamento de cada trabalhador
+    varredura->salvamentos = NULL;
+    if (config->caminhoRetomada != NULL) {
+        abrirRetomada(&varredura->retomada, config->caminhoRetomada, config->retomar, plano, &config->parametros,
+                      config->tipoGerador, config->semente, config->numTrabalhadores);
+        varredura->salvamentos = (SalvamentoTrabalhador *)calloc(config->numTrabalhadores, sizeof(SalvamentoTrabalhador));
+        if (varredura->salvamentos == NULL) {
+            printf("Erro ao alocar a retomada\n");
+            exit(1);
         }
-        if (p->fitness < enxame->globalBestFitness) {
-            enxame->globalBestFitness = p->fitness;
-            for (int d = 0; d < enxame->dimensions; d++) {
-                enxame->globalBestPosition[d] = p->position[d];
+        for (int t = 0; t < config->numTrabalhadores; t++){
+            iniciarSalvamento(&varredura->salvamentos[t], &varredura->retomada, t, config->intervaloRetomada);
+        }
+        for (int i = 0; i < total; i++){
+            const double *posicao;
+            const RegistroRetomada *registro = execucaoConcluida(&varredura->retomada, i, &posicao);
+            if (registro != NULL) {
+                Execucao *execucao = &varredura->execucoes[i];
+                execucao->resultado = registro->resultado;
+                execucao->iteracoesExecutadas = registro->iteracoes;
+                execucao->avaliacoes = registro->avaliacoes;
+                execucao->criterio = (CriterioParada)registro->criterio;
+                execucao->tempo = registro->tempo;
+                execucao->restaurada = 1;
+                memcpy(execucao->melhorPosicao, posicao, dimensoes * sizeof(double));
             }
         }
+        if (config->retomar) {
+            printf("Retomando %s: %d de %d execucoes concluidas, %d em andamento\n", config->caminhoRetomada,
+                   varredura->retomada.retomadas, total, varredura->retomada.numSalvas);
+        }
+    }
+
+    // motor paralelo: cada trabalhador da varredura tem o próprio grupo de threads para as partículas
+    varredura->grupos = NULL;
+    if (config->parametros.motor == MOTOR_PARALELO && config->threadsEnxame > 1) {
+        varredura->grupos = (GrupoTrabalho *)calloc(config->numTrabalhadores, sizeof(GrupoTrabalho));
+        if (varredura->grupos == NULL) {
+            printf("Erro ao alocar os grupos de threads\n");
+            exit(1);
+        }
+        for (int t = 0; t < config->numTrabalhadores; t++){
+            iniciarGrupo(&varredura->grupos[t], config->threadsEnxame);
+        }
+    }
+
+    // topologia local: a tabela de vizinhos de cada trabalhador é reaproveitada entre as execuções
+    varredura->vizinhancas = NULL;
+    if (config->parametros.topologia != TOPOLOGIA_GLOBAL) {
+        varredura->vizinhancas = (Topologia *)calloc(config->numTrabalhadores, sizeof(Topologia));
+        if (varredura->vizinhancas == NULL) {
+            printf("Erro ao alocar as topologias\n");
+            exit(1);
+        }
+    }
+
+    // reinícios: o arquivo de elite de cada trabalhador é reaproveitado entre as execuções
+    varredura->elites = NULL;
+    if (config->parametros.reinicio.estagnacao > 0 || config->parametros.reinicio.diametro > 0) {
+        varredura->elites = (ArquivoElite *)calloc(config->numTrabalhadores, sizeof(ArquivoElite));
+        if (varredura->elites == NULL) {
+            printf("Erro ao alocar os arquivos de elite\n");
+            exit(1);
+        }
+    }
+
+    // modelo de ilhas: cada trabalhador da varredura tem as próprias ilhas, com uma thread por ilha
+    varredura->ilhas = NULL;
+    if (config->parametros.ilhas.numIlhas > 1) {
+        varredura->ilhas = (ModeloIlhas *)calloc(config->numTrabalhadores, sizeof(ModeloIlhas));
+        if (varredura->ilhas == NULL) {
+            printf("Erro ao alocar as ilhas\n");
+            exit(1);
+        }
+        for (int t = 0; t < config->numTrabalhadores; t++){
+            criarIlhas(&varredura->ilhas[t], config->parametros.ilhas.numIlhas);
+        }
+    }
+
+    // cache de aptidões: um por trabalhador, compartilhado pelas threads do motor paralelo, pelas
+    // ilhas e pelos avaliadores dele
+    varredura->caches = NULL;
+    if (config->usarCache) {
+        varredura->caches = (CacheAptidao *)calloc(config->numTrabalhadores, sizeof(CacheAptidao));
+        if (varredura->caches == NULL) {
+            printf("Erro ao alocar os caches\n");
+            exit(1);
+        }
+        for (int t = 0; t < config->numTrabalhadores; t++){
+            criarCache(&varredura->caches[t], dimensoes, config->toleranciaCache, config->memoriaCache);
+        }
+    }
+
+    // modelo substituto: um por trabalhador, refeito a cada execução
+    varredura->substitutos = NULL;
+    if (config->usarSubstituto) {
+        varredura->substitutos = (ModeloSubstituto *)calloc(config->numTrabalhadores, sizeof(ModeloSubstituto));
+        if (varredura->substitutos == NULL) {
+            printf("Erro ao alocar os modelos substitutos\n");
+            exit(1);
+        }
+        for (int t = 0; t < config->numTrabalhadores; t++){
+            criarSubstituto(&varredura->substitutos[t], dimensoes, config->pontosSubstituto, config->vizinhosSubstituto, config->margemSubstituto);
+        }
+    }
+
+    // motor assíncrono: cada trabalhador da varredura tem a própria fila e os próprios avaliadores
+    varredura->avaliadores = NULL;
+    if (config->numAvaliadores > 0) {
+        varredura->avaliadores = (AvaliadorAssincrono *)calloc(config->numTrabalhadores, sizeof(AvaliadorAssincrono));
+        if (varredura->avaliadores == NULL) {
+            printf("Erro ao alocar os avaliadores\n");
+            exit(1);
+        }
+        for (int t = 0; t < config->numTrabalhadores; t++){
+            Objetivo objetivo = config->parametros.objetivo;
+            objetivo.cache = varredura->caches != NULL ? &varredura->caches[t] : NULL;
+            iniciarAvaliador(&varredura->avaliadores[t], config->tipoAvaliador, config->numAvaliadores, config->capacidadeFila,
+                             &objetivo, dimensoes, config->latencia);
+        }
     }
-}
 
-// Executa PSO
-double executarPSO(Swarm *enxame, int iteracoes, double w, double c1, double c2, double posMin, double posMax) {
-    for (int iter = 0; iter < iteracoes; iter++) {
-        for (int i = 0; i < enxame->numParticles; i++) {
-            Particle *p = &enxame->particles[i];
-            atualizarVelocidade(p, enxame->globalBestPosition, enxame->dimensions, w, c1, c2);
-            atualizarPosicao(p, posMin, posMax, enxame->dimensions);
+    // motor em lote: um lote (arena) por trabalhador em vez de um enxame
+    varredura->lotes = NULL;
+    varredura->inicioLotes = NULL;
+    if (config->enxamesPorLote > 1) {
+        varredura->inicioLotes = (int *)malloc(((size_t)total + 1) * sizeof(int));
+        varredura->lotes = (LoteEnxames *)calloc(config->numTrabalhadores, sizeof(LoteEnxames));
+        if (varredura->lotes == NULL || varredura->inicioLotes == NULL) {
+            printf("Erro ao alocar os lotes\n");
+            exit(1);
         }
-        atualizarMelhoresPosicoes(enxame);
     }
-    return enxame->globalBestFitness;
+
+    abrirEscritor(&varredura->escritor, config->caminhoSaida, config->formato, config->silencioso, config->incluirTempo, dimensoes, config->parametros.objetivo.nome);
 }
 
-// Calcula média
-double calcularMedia(double *resultados, int tamanho) {
-    double soma = 0.0;
-    for (int i = 0; i < tamanho; i++) {
-        soma += resultados[i];
+// Executa as execuções [primeira, fim) nos trabalhadores e grava na ordem da lista; devolve as avaliações feitas
+long long executarTrecho(Varredura *varredura, int primeira, int fim){
+    const ConfiguracaoVarredura *config = varredura->config;
+    long long avaliacoes = 0;
+
+    varredura->primeira = primeira;
+    varredura->fim = fim;
+    varredura->proxima = primeira;
+    if (varredura->lotes != NULL) {
+        int numLotes = montarLotes(varredura, primeira, fim, config->enxamesPorLote);
+        executarTarefas(numLotes, config->numTrabalhadores, executarLoteDaVarredura, varredura);
+    } else {
+        executarTarefas(fim - primeira, config->numTrabalhadores, executarTarefaDaVarredura, varredura);
+    }
+    for (int i = primeira; i < fim; i++){
+        avaliacoes += varredura->execucoes[i].avaliacoes;
     }
-    return soma / tamanho;
+    return avaliacoes;
 }
 
-// Calcula desvio padrão
-double calcularDesvioPadrao(double *resultados, int tamanho, double media) {
-    double soma = 0.0;
-    for (int i = 0; i < tamanho; i++) {
-        soma += (resultados[i] - media) * (resultados[i] - media);
+// Relata a instrumentação e libera o estado da varredura (o escritor já deve estar fechado)
+void liberarVarredura(Varredura *varredura){
+    const ConfiguracaoVarredura *config = varredura->config;
+
+    if (varredura->instrumentacoes != NULL) {
+        Instrumentacao total;
+        criarInstrumentacao(&total, 0);
+        for (int t = 0; t < config->numTrabalhadores; t++){
+            somarInstrumentacao(&total, &varredura->instrumentacoes[t]);
+        }
+        relatarInstrumentacao(&total, config->caminhoInstrumentacao);
+        for (int t = 0; t < config->numTrabalhadores; t++){
+            liberarInstrumentacao(&varredura->instrumentacoes[t]);
+        }
+        free(varredura->instrumentacoes);
+    }
+
+    for (int t = 0; t < config->numTrabalhadores; t++){
+        liberarEnxame(&varredura->enxames[t]);
+        if (varredura->vizinhancas != NULL) {
+            liberarTopologia(&varredura->vizinhancas[t]);
+        }
+        if (varredura->elites != NULL) {
+            liberarElite(&varredura->elites[t]);
+        }
+        if (varredura->lotes != NULL) {
+            liberarLote(&varredura->lotes[t]);
+        }
+        if (varredura->ilhas != NULL) {
+            liberarIlhas(&varredura->ilhas[t]);
+        }
+    }
+    if (varredura->avaliadores != NULL) {
+        EstatisticaAssincrona total;
+        memset(&total, 0, sizeof(total));
+        for (int t = 0; t < config->numTrabalhadores; t++){
+            encerrarAvaliador(&varredura->avaliadores[t]);
+            somarEstatisticaAssincrona(&total, &varredura->avaliadores[t].estatistica);
+        }
+        relatarEstatisticaAssincrona(&total, config->numAvaliadores, config->numTrabalhadores);
+        free(varredura->avaliadores);
+    }
+    if (varredura->substitutos != NULL) {
+        EstatisticaSubstituto total;
+        memset(&total, 0, sizeof(total));
+        for (int t = 0; t < config->numTrabalhadores; t++){
+            somarEstatisticaSubstituto(&total, &varredura->substitutos[t]);
+            liberarSubstituto(&varredura->substitutos[t]);
+        }
+        relatarEstatisticaSubstituto(&total);
+        free(varredura->substitutos);
+    }
+    if (varredura->caches != NULL) {
+        EstatisticaCache total;
+        memset(&total, 0, sizeof(total));
+        for (int t = 0; t < config->numTrabalhadores; t++){
+            somarEstatisticaCache(&total, &varredura->caches[t]);
+        }
+        relatarEstatisticaCache(&total, &varredura->caches[0], config->numTrabalhadores);
+        for (int t = 0; t < config->numTrabalhadores; t++){
+            liberarCache(&varredura->caches[t]);
+        }
+        free(varredura->caches);
     }
-    return raizQuadradaPersonalizada(soma / tamanho);
+    if (varredura->grupos != NULL) {
+        for (int t = 0; t < config->numTrabalhadores; t++){
+            encerrarGrupo(&varredura->grupos[t]);
+        }
+        free(varredura->grupos);
+    }
+    free(varredura->vizinhancas);
+    free(varredura->elites);
+    free(varredura->ilhas);
+    free(varredura->lotes);
+    free(varredura->inicioLotes);
+    if (varredura->telemetrias != NULL) {
+        fecharArquivoTelemetria(&varredura->arquivoTelemetria);
+        for (int t = 0; t < config->numTrabalhadores; t++){
+            liberarTelemetria(&varredura->telemetrias[t]);
+        }
+        free(varredura->telemetrias);
+    }
+    if (varredura->salvamentos != NULL) {
+        fecharRetomada(&varredura->retomada);
+        free(varredura->salvamentos);
+    }
+    pthread_mutex_destroy(&varredura->trava);
+    free(varredura->enxames);
+    free(varredura->posicoes);
+    free(varredura->execucoes);
 }
 
-// ========== FIM DAS FUNÇÕES do trabalho ===========
+// Executa em paralelo a lista plana de execuções do plano e grava na ordem da lista
+void inicializar(PlanoExpandido *plano, const ConfiguracaoVarredura *config){
+    Varredura varredura;
 
-void gerarRelatorio(FILE *arquivo, int populacao, int interacao, double resultado){
+    abrirVarredura(&varredura, plano, config);
+    printf("\n\t\t =====| EXECUTANDO %d RODADAS (%d CELULAS) EM %d THREADS (SEMENTE %llu, GERADOR %s) |=====\n\n", plano->numTarefas, plano->numCelulas, config->numTrabalhadores, config->semente, nomeGerador(config->tipoGerador));
+    executarTrecho(&varredura, 0, plano->numTarefas);
+    fecharEscritor(&varredura.escritor);
 
-    fWiriteSTRING(arquivo, "População: ");
-    fWiriteINT(arquivo, populacao);
-    printf("População: %d",populacao);
+    gerarRelatorioMediaeDesvioPadrao(plano, config->caminhoResumo);
+    liberarVarredura(&varredura);
+}
 
-    fWiriteSTRING(arquivo, ", Iterações: ");
-    fWiriteINT(arquivo, interacao);
-    printf(", Iterações: %d",interacao);
+// "resultados.csv" do trabalhador 3 vira "resultados.t3.csv": os nós de uma mesma máquina não disputam o arquivo
+void caminhoDoTrabalhador(char *destino, size_t tamanho, const char *caminho, int trabalhador){
+    const char *ponto = strrchr(caminho, '.');
+    const char *barra = strrchr(caminho, '/');
+    const char *contrabarra = strrchr(caminho, '\\');
 
-    fWiriteSTRING(arquivo, ", Melhor: ");
-    fWiriteFLOAT(arquivo, resultado);
-    printf(", Melhor: %0.6f",resultado);
-    fWiriteLN(arquivo);
+    if (contrabarra != NULL && (barra == NULL || contrabarra > barra)) {
+        barra = contrabarra;
+    }
+    if (ponto == NULL || (barra != NULL && ponto < barra)) {
+        snprintf(destino, tamanho, "%s.t%d", caminho, trabalhador);
+    } else {
+        snprintf(destino, tamanho, "%.*s.t%d%s", (int)(ponto - caminho), caminho, trabalhador, ponto);
+    }
 }
 
-void gerarRelatorioMediaeDesvioPadrao(FILE *arquivo, int numRodadas, double resultados[]){
-    double media = calcularMedia(resultados, numRodadas);
-    double desvioPadrao = calcularDesvioPadrao(resultados, numRodadas, media);
+// Primeiro lote do trabalhador: abre a varredura local com as saídas do nó
+void abrirNoDistribuido(int trabalhador, void *contexto){
+    NoDistribuido *no = (NoDistribuido *)contexto;
 
-    fWiriteSTRING(arquivo,"\n\t\t =====| MEDIA E DESVIO PADRAO |=====\n\n");
-    fWiriteSTRING(arquivo, ", Media: ");
-    fWiriteFLOAT(arquivo, media);
-    printf(", Media: %0.6f",media);
+    caminhoDoTrabalhador(no->caminhoSaida, sizeof(no->caminhoSaida), no->config.caminhoSaida, trabalhador);
+    caminhoDoTrabalhador(no->caminhoTelemetria, sizeof(no->caminhoTelemetria), no->config.caminhoTelemetria, trabalhador);
+    caminhoDoTrabalhador(no->caminhoInstrumentacao, sizeof(no->caminhoInstrumentacao), no->config.caminhoInstrumentacao, trabalhador);
+    no->config.caminhoSaida = no->caminhoSaida;
+    no->config.caminhoTelemetria = no->caminhoTelemetria;
+    no->config.caminhoInstrumentacao = no->caminhoInstrumentacao;
+    no->config.silencioso = 1;
+    abrirVarredura(&no->varredura, no->plano, &no->config);
+    printf("Trabalhador %d: %d threads, resultados em %s\n", trabalhador, no->config.numTrabalhadores, no->caminhoSaida);
+}
 
-    fWiriteSTRING(arquivo, ", DesvioPadrão: ");
-    fWiriteFLOAT(arquivo, desvioPadrao);
-    printf(", DesvioPadrão: %0.6f",desvioPadrao);
-    fWiriteLN(arquivo);
+// Cada lote vai para o disco antes de o resultado dele seguir para o coordenador: se o nó cair
+// depois, as linhas dos lotes já contados não se perdem
+long long executarNoDistribuido(int primeira, int fim, void *contexto){
+    NoDistribuido *no = (NoDistribuido *)contexto;
+    long long avaliacoes = executarTrecho(&no->varredura, primeira, fim);
+    descarregarEscritor(&no->varredura.escritor);
+    return avaliacoes;
 }
 
-double executar(FILE *arquivo, int iteracao, int populacao){
-    Swarm enxame;
-    double resultado;
-
-    inicializarEnxame(&enxame, populacao, 2, -512, 512, 77);
-    resultado = executarPSO(&enxame, iteracao, 0.5, 1.5, 1.5, -512, 512);
-    free(enxame.globalBestPosition);
-    for (int i = 0; i < populacao; i++) {
-        free(enxame.particles[i].position);
-        free(enxame.particles[i].velocity);
-        free(enxame.particles[i].bestPosition);
-    }
-    free(enxame.particles);
-    gerarRelatorio(arquivo,populacao,iteracao,resultado);
-    return resultado;
+void fecharNoDistribuido(void *contexto){
+    NoDistribuido *no = (NoDistribuido *)contexto;
+    fecharEscritor(&no->varredura.escritor);
+    liberarVarredura(&no->varredura);
 }
 
-double executarRodadaDePopulacoes(FILE *arquivo,int tamVetPopulacoes,int interacao, int populacoes[]){
-    double resultado;
-    int populacao;
+// Varredura distribuída: o coordenador só reparte os lotes e junta a estatística das células
+// (os resultados de cada execução ficam nos arquivos dos trabalhadores); canal >= 0 = este nó é um
+// trabalhador já conectado
+void distribuirVarredura(PlanoExpandido *plano, const ConfiguracaoVarredura *config, const ConfiguracaoDistribuida *distribuida,
+                         int canal, int trabalhador){
+    NoDistribuido no;
+    TrabalhoDistribuido trabalho;
+    uint64_t impressao = impressaoDaVarredura(plano, &config->parametros, config->tipoGerador);
 
-    // seleciona cada setor do vetor de populacoes 
-    for (int atual = 0; atual < tamVetPopulacoes; atual++){
-        populacao = populacoes[atual];
-        printf("executando \n %d Interacoes com %d particulas \n",interacao,populacao);
-        resultado = executar(arquivo, interacao,populacao);
+    no.plano = plano;
+    no.config = *config;
+    trabalho.abrir = abrirNoDistribuido;
+    trabalho.executar = executarNoDistribuido;
+    trabalho.fechar = fecharNoDistribuido;
+    trabalho.contexto = &no;
+    if (canal >= 0) {
+        servirCoordenador(canal, trabalhador, plano, impressao, &trabalho);
+        return;
     }
-    printf("\n\n");
-    return resultado;
+    EstatisticaDistribuida estatistica;
+    printf("\n\t\t =====| DISTRIBUINDO %d RODADAS (%d CELULAS) (SEMENTE %llu, GERADOR %s) |=====\n\n", plano->numTarefas, plano->numCelulas, config->semente, nomeGerador(config->tipoGerador));
+    coordenarVarredura(distribuida, plano, impressao, config->semente, &trabalho, &estatistica);
+    relatarEstatisticaDistribuida(&estatistica);
+    gerarRelatorioMediaeDesvioPadrao(plano, config->caminhoResumo);
+}
+
+// Nome desconhecido numa opção: mostra os válidos e retorna o código de erro do programa
+int valorInvalido(const char *opcao, const char *valor, const char *nomes){
+    printf("Valor invalido para %s: %s (disponiveis: %s)\n", opcao, valor, nomes);
+    return 1;
 }
 
-double executarRodadaDeInteracoes(FILE *arquivo,int tamVetInteracoes, int interacoes[],  int populacoes[]){
-    double resultado;
-    int interacao;
+// Função principal
+int main(int argc, char *argv[]) {
+    prepararConsole();
+    if (argc > 1 && strcmp(argv[1], "--verificar-precisao") == 0) {
+        return verificarPrecisaoEggholder() == 0 ? 0 : 1;
+    }
+    if (argc > 1 && strcmp(argv[1], "--verificar-contagem") == 0) {
+        return verificarContagemAvaliacoes() == 0 ? 0 : 1;
+    }
+    ConfiguracaoVarredura config;
+    config.semente = (unsigned long long)time(NULL);
+    config.numTrabalhadores = numeroDeNucleos();
+    config.tipoGerador = GERADOR_XOSHIRO256;
+    config.parametros = parametrosPadrao();
+    config.caminhoSaida = NULL;
+    config.formato = SAIDA_CSV;
+    config.silencioso = 0;
+    config.incluirTempo = 1;
+    config.nivelTelemetria = TELEMETRIA_DESLIGADA;
+    config.caminhoTelemetria = LOCALFILE_CONVERGENCIA;
+    ParametrosPSO parametros = parametrosPadrao();
+    const char *nomeObjetivo = "eggholder";
+    const char *alvo = NULL;
+    const char *caminhoPlano = NULL;
+    config.caminhoResumo = LOCALFILE_RESUMO;
+    config.instrumentar = 0;
+    config.enxamesPorLote = 0;
+    config.threadsEnxame = 1;
+    config.numAvaliadores = 0;
+    config.tipoAvaliador = AVALIADOR_THREAD;
+    config.capacidadeFila = 0;
+    config.latencia = 0;
+    config.caminhoRetomada = NULL;
+    config.retomar = 0;
+    config.intervaloRetomada = INTERVALO_RETOMADA_PADRAO;
+    config.contadoresHardware = 0;
+    config.usarCache = 0;
+    config.toleranciaCache = 0;
+    config.memoriaCache = MEMORIA_CACHE_PADRAO;
+    config.usarSubstituto = 0;
+    config.margemSubstituto = 0;
+    config.pontosSubstituto = PONTOS_SUBSTITUTO_PADRAO;
+    config.vizinhosSubstituto = VIZINHOS_SUBSTITUTO_PADRAO;
+    config.caminhoInstrumentacao = LOCALFILE_INSTRUMENTACAO;
+    ConfiguracaoDistribuida distribuida = configuracaoDistribuidaPadrao();
+    int coordenador = 0, trabalhador = 0, threadsExplicitas = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char *opcao = argv[i];
+        const char *valor = i + 1 < argc ? argv[i + 1] : "";
 
-    // seleciona cada setor do vetor de interacoes 
-    for (int atual = 0; atual < tamVetInteracoes; atual++){
-        interacao = interacoes[atual];
-        for (int i = 0; i < interacao; i++){
-            resultado = executarRodadaDePopulacoes(arquivo,2,interacao,populacoes);
+        // opções sem valor
+        if (strcmp(opcao, "--silencioso") == 0) {
+            config.silencioso = 1;
+            continue;
+        } else if (strcmp(opcao, "--sem-tempo") == 0) {
+            config.incluirTempo = 0;
+            continue;
+        } else if (strcmp(opcao, "--instrumentar") == 0) {
+            config.instrumentar = 1;
+            continue;
+        } else if (strcmp(opcao, "--limitar-velocidade") == 0) {
+            parametros.limitarVelocidade = 1;
+            continue;
+        } else if (strcmp(opcao, "--contadores") == 0) {
+            config.instrumentar = 1;
+            config.contadoresHardware = 1;
+            continue;
         }
+
+        if (strcmp(opcao, "--threads") == 0) {
+            config.numTrabalhadores = atoi(valor);
+            threadsExplicitas = 1;
+        } else if (strcmp(opcao, "--coordenador") == 0 || strcmp(opcao, "--trabalhador") == 0) {
+            if (!lerEnderecoDistribuido(&distribuida, valor)) {
+                printf("Endereco invalido: %s (use porta ou endereco:porta)\n", valor);
+                return 1;
+            }
+            coordenador = strcmp(opcao, "--coordenador") == 0;
+            trabalhador = !coordenador;
+        } else if (strcmp(opcao, "--processos") == 0) {
+            distribuida.processosLocais = atoi(valor);
+        } else if (strcmp(opcao, "--lote-distribuido") == 0) {
+            distribuida.tamanhoLote = atoi(valor);
+        } else if (strcmp(opcao, "--prazo-lote") == 0) {
+            distribuida.prazoLote = atof(valor);
+        } else if (strcmp(opcao, "--semente") == 0) {
+            config.semente = strtoull(valor, NULL, 10);
+        } else if (strcmp(opcao, "--gerador") == 0) {
+            if (!geradorPorNome(valor, &config.tipoGerador)) {
+                return valorInvalido(opcao, valor, nomesGeradores());
+            }
+        } else if (strcmp(opcao, "--motor") == 0) {
+            if (!motorPorNome(valor, &parametros.motor)) {
+                return valorInvalido(opcao, valor, nomesMotores());
+            }
+        } else if (strcmp(opcao, "--gbest") == 0) {
+            if (strcmp(valor, "sincrono") != 0 && strcmp(valor, "assincrono") != 0) {
+                return valorInvalido(opcao, valor, "sincrono, assincrono");
+            }
+            parametros.modoGBest = strcmp(valor, "assincrono") == 0 ? GBEST_ASSINCRONO : GBEST_SINCRONO;
+        } else if (strcmp(opcao, "--agenda") == 0) {
+            if (!agendaPorNome(valor, &parametros.agenda.tipo)) {
+                return valorInvalido(opcao, valor, nomesAgendas());
+            }
+        } else if (strcmp(opcao, "--w-inicial") == 0) {
+            parametros.agenda.wInicial = atof(valor);
+        } else if (strcmp(opcao, "--w-final") == 0) {
+            parametros.agenda.wFinal = atof(valor);
+        } else if (strcmp(opcao, "--reinicio-estagnacao") == 0) {
+            parametros.reinicio.estagnacao = atoi(valor);
+        } else if (strcmp(opcao, "--reinicio-diametro") == 0) {
+            parametros.reinicio.diametro = atof(valor);
+        } else if (strcmp(opcao, "--reinicio-fracao") == 0) {
+            parametros.reinicio.fracao = atof(valor);
+        } else if (strcmp(opcao, "--fronteira") == 0) {
+            if (!fronteiraPorNome(valor, &parametros.fronteira)) {
+                return valorInvalido(opcao, valor, nomesFronteiras());
+            }
+        } else if (strcmp(opcao, "--topologia") == 0) {
+            if (!topologiaPorNome(valor, &parametros.topologia)) {
+                return valorInvalido(opcao, valor, nomesTopologias());
+            }
+        } else if (strcmp(opcao, "--vizinhos") == 0) {
+            parametros.vizinhosAleatorios = atoi(valor);
+        } else if (strcmp(opcao, "--ilhas") == 0) {
+            parametros.ilhas.numIlhas = atoi(valor);
+        } else if (strcmp(opcao, "--migracao") == 0) {
+            if (!migracaoPorNome(valor, &parametros.ilhas.topologia)) {
+                return valorInvalido(opcao, valor, nomesMigracoes());
+            }
+        } else if (strcmp(opcao, "--intervalo-migracao") == 0) {
+            parametros.ilhas.intervalo = atoi(valor);
+        } else if (strcmp(opcao, "--migrantes") == 0) {
+            parametros.ilhas.migrantes = atoi(valor);
+        } else if (strcmp(opcao, "--cache") == 0) {
+            config.usarCache = 1;
+            config.toleranciaCache = atof(valor);
+        } else if (strcmp(opcao, "--cache-mb") == 0) {
+            config.memoriaCache = atof(valor);
+        } else if (strcmp(opcao, "--substituto") == 0) {
+            config.usarSubstituto = 1;
+            config.margemSubstituto = atof(valor);
+        } else if (strcmp(opcao, "--substituto-pontos") == 0) {
+            config.pontosSubstituto = atoi(valor);
+        } else if (strcmp(opcao, "--substituto-vizinhos") == 0) {
+            config.vizinhosSubstituto = atoi(valor);
+        } else if (strcmp(opcao, "--lote") == 0) {
+            config.enxamesPorLote = atoi(valor);
+        } else if (strcmp(opcao, "--threads-enxame") == 0) {
+            config.threadsEnxame = atoi(valor);
+        } else if (strcmp(opcao, "--avaliadores") == 0) {
+            config.numAvaliadores = atoi(valor);
+        } else if (strcmp(opcao, "--avaliador") == 0) {
+            if (!avaliadorPorNome(valor, &config.tipoAvaliador)) {
+                return valorInvalido(opcao, valor, nomesAvaliadores());
+            }
+        } else if (strcmp(opcao, "--fila") == 0) {
+            config.capacidadeFila = atoi(valor);
+        } else if (strcmp(opcao, "--latencia") == 0) {
+            config.latencia = atof(valor) / 1000.0;
+        } else if (strcmp(opcao, "--retomada") == 0) {
+            config.caminhoRetomada = valor;
+        } else if (strcmp(opcao, "--retomar") == 0) {
+            config.caminhoRetomada = valor;
+            config.retomar = 1;
+        } else if (strcmp(opcao, "--intervalo-retomada") == 0) {
+            config.intervaloRetomada = atof(valor);
+        } else if (strcmp(opcao, "--grao") == 0) {
+            parametros.grao = atoi(valor);
+        } else if (strcmp(opcao, "--bloco") == 0) {
+            parametros.tamanhoBloco = atoi(valor);
+        } else if (strcmp(opcao, "--objetivo") == 0) {
+            nomeObjetivo = valor;
+        } else if (strcmp(opcao, "--dimensoes") == 0) {
+            parametros.dimensoes = atoi(valor);
+        } else if (strcmp(opcao, "--saida") == 0) {
+            config.caminhoSaida = valor;
+        } else if (strcmp(opcao, "--plano") == 0) {
+            caminhoPlano = valor;
+        } else if (strcmp(opcao, "--resumo") == 0) {
+            config.caminhoResumo = valor;
+        } else if (strcmp(opcao, "--arquivo-instrumentacao") == 0) {
+            config.caminhoInstrumentacao = valor;
+        } else if (strcmp(opcao, "--telemetria") == 0) {
+            if (!telemetriaPorNome(valor, &config.nivelTelemetria)) {
+                return valorInvalido(opcao, valor, nomesTelemetria());
+            }
+        } else if (strcmp(opcao, "--arquivo-telemetria") == 0) {
+            config.caminhoTelemetria = valor;
+        } else if (strcmp(opcao, "--alvo") == 0) {
+            alvo = valor;
+        } else if (strcmp(opcao, "--estagnacao") == 0) {
+            parametros.parada.estagnacao = atoi(valor);
+        } else if (strcmp(opcao, "--raio-min") == 0) {
+            parametros.parada.raioMinimo = atof(valor);
+        } else if (strcmp(opcao, "--vel-min") == 0) {
+            parametros.parada.velocidadeMinima = atof(valor);
+        } else if (strcmp(opcao, "--tempo-max") == 0) {
+            parametros.parada.tempoMaximo = atof(valor);
+        } else if (strcmp(opcao, "--avaliacoes-max") == 0) {
+            parametros.parada.avaliacoesMaximas = atoll(valor);
+        } else if (strcmp(opcao, "--formato") == 0) {
+            if (strcmp(valor, "csv") != 0 && strcmp(valor, "binario") != 0) {
+                return valorInvalido(opcao, valor, "csv, binario");
+            }
+            config.formato = strcmp(valor, "binario") == 0 ? SAIDA_BINARIA : SAIDA_CSV;
+        } else {
+            printf("Opcao desconhecida: %s\n", opcao);
+            return 1;
+        }
+        i++;
+    }
+    if (config.numTrabalhadores < 1) {
+        config.numTrabalhadores = 1;
+    }
+    if (parametros.grao < 1 || parametros.tamanhoBloco < 1 || config.threadsEnxame < 1) {
+        printf("--grao, --bloco e --threads-enxame precisam de um inteiro >= 1 (receberam %d, %d e %d)\n",
+               parametros.grao, parametros.tamanhoBloco, config.threadsEnxame);
+        return 1;
+    }
+    if (config.instrumentar && !PSO_INSTRUMENTACAO) {
+        printf("Instrumentacao desligada na compilacao (compile com -DPSO_INSTRUMENTACAO=1)\n");
+        config.instrumentar = 0;
+    }
+    if (config.enxamesPorLote > MAX_ENXAMES_POR_LOTE) {
+        config.enxamesPorLote = MAX_ENXAMES_POR_LOTE;
+    }
+    if (config.enxamesPorLote > 1 && (config.tipoGerador != GERADOR_XOSHIRO256 || config.nivelTelemetria != TELEMETRIA_DESLIGADA)) {
+        printf("O motor em lote usa xoshiro e nao grava telemetria; executando um enxame por vez\n");
+        config.enxamesPorLote = 0;
+    }
+    if (parametros.vizinhosAleatorios < 1) {
+        printf("A topologia aleatoria precisa de ao menos 1 vizinho por particula (recebeu %d)\n", parametros.vizinhosAleatorios);
+        return 1;
+    }
+    if (parametros.topologia != TOPOLOGIA_GLOBAL && config.numAvaliadores > 0) {
+        printf("O motor assincrono so usa o gBest; topologia global\n");
+        parametros.topologia = TOPOLOGIA_GLOBAL;
+    }
+    if (parametros.topologia != TOPOLOGIA_GLOBAL && (parametros.motor != MOTOR_CLASSICO || config.enxamesPorLote > 1)) {
+        printf("A topologia %s usa o motor classico, um enxame por vez\n", nomeTopologia(parametros.topologia));
+        parametros.motor = MOTOR_CLASSICO;
+        config.enxamesPorLote = 0;
+    }
+    int reinicios = parametros.reinicio.estagnacao > 0 || parametros.reinicio.diametro > 0;
+    if (reinicios && config.numAvaliadores > 0) {
+        printf("O motor assincrono nao reinicia o enxame; reinicios desligados\n");
+        parametros.reinicio.estagnacao = 0;
+        parametros.reinicio.diametro = 0;
+    } else if (reinicios && config.enxamesPorLote > 1) {
+        printf("Os reinicios usam um enxame por vez; motor em lote desligado\n");
+        config.enxamesPorLote = 0;
+    }
+    if (config.enxamesPorLote > 1 && config.numAvaliadores > 0) {
+        printf("O motor assincrono avalia um enxame por vez; motor em lote desligado\n");
+        config.enxamesPorLote = 0;
+    }
+    if (parametros.ilhas.numIlhas < 1 || parametros.ilhas.numIlhas > MAX_ILHAS || parametros.ilhas.migrantes < 1) {
+        printf("O modelo de ilhas aceita de 1 a %d ilhas e ao menos 1 migrante\n", MAX_ILHAS);
+        return 1;
+    }
+    if (parametros.ilhas.numIlhas > 1 && config.numAvaliadores > 0) {
+        printf("O motor assincrono avalia um enxame por vez; ilhas desligadas\n");
+        parametros.ilhas.numIlhas = 1;
+    }
+    if (parametros.ilhas.numIlhas > 1 && (config.enxamesPorLote > 1 || config.threadsEnxame > 1 || config.nivelTelemetria != TELEMETRIA_DESLIGADA)) {
+        printf("As ilhas rodam cada subenxame na sua thread e nao gravam telemetria; motor em lote, threads do enxame e telemetria desligados\n");
+        config.enxamesPorLote = 0;
+        config.threadsEnxame = 1;
+        config.nivelTelemetria = TELEMETRIA_DESLIGADA;
+    }
+    if (config.usarSubstituto && !(isfinite(config.margemSubstituto) && config.margemSubstituto >= 0)) {
+        printf("A margem do modelo substituto deve ser um numero finito >= 0 (recebeu %g)\n", config.margemSubstituto);
+        return 1;
+    }
+    if (config.usarSubstituto && (config.vizinhosSubstituto < 1 || config.pontosSubstituto < AMOSTRAS_MINIMAS_SUBSTITUTO ||
+                                  config.pontosSubstituto < config.vizinhosSubstituto)) {
+        printf("O modelo substituto precisa de ao menos 1 vizinho e de ao menos %d pontos (e nao menos pontos que vizinhos)\n",
+               AMOSTRAS_MINIMAS_SUBSTITUTO);
+        return 1;
+    }
+    if (config.usarCache && !(isfinite(config.toleranciaCache) && config.toleranciaCache >= 0 &&
+                              isfinite(config.memoriaCache) && config.memoriaCache > 0)) {
+        printf("O cache precisa de tolerancia finita >= 0 (0 = chave exata) e de memoria > 0 MB\n");
+        return 1;
+    }
+    // com a chave quantizada quem guarda primeiro uma célula decide a aptidão que os outros recebem:
+    // ilhas e threads do enxame correndo juntas no mesmo cache mudariam o resultado da mesma semente
+    if (config.usarCache && config.toleranciaCache > 0 &&
+        (parametros.ilhas.numIlhas > 1 || (parametros.motor == MOTOR_PARALELO && config.threadsEnxame > 1))) {
+        printf("As ilhas e as threads do enxame disputam o mesmo cache; cache com chave exata\n");
+        config.toleranciaCache = 0;
+    }
+    if (config.usarCache && config.enxamesPorLote > 1) {
+        printf("O cache de aptidoes vale para um enxame por vez; motor em lote desligado\n");
+        config.enxamesPorLote = 0;
+    }
+    if (config.usarSubstituto && (config.numAvaliadores > 0 || parametros.ilhas.numIlhas > 1)) {
+        printf("O modelo substituto tria os candidatos de um enxame na thread dele; modelo substituto desligado\n");
+        config.usarSubstituto = 0;
+    }
+    if (config.usarSubstituto && (parametros.motor == MOTOR_PARALELO || config.enxamesPorLote > 1)) {
+        printf("O modelo substituto aprende na ordem das avaliacoes; motor classico, um enxame por vez\n");
+        parametros.motor = MOTOR_CLASSICO;
+        config.enxamesPorLote = 0;
+    }
+    // só com --processos: coordenador numa porta livre da interface local, com os trabalhadores no próprio nó
+    if (distribuida.processosLocais > 0 && !coordenador && !trabalhador) {
+        coordenador = 1;
+        distribuida.porta = 0;
+    }
+    if (coordenador && distribuida.processosLocais > 0 && !threadsExplicitas) {
+        config.numTrabalhadores = numeroDeNucleos() / distribuida.processosLocais;
+        config.numTrabalhadores = config.numTrabalhadores > 0 ? config.numTrabalhadores : 1;
+    }
+    if ((coordenador || trabalhador) && config.caminhoRetomada != NULL) {
+        printf("Na varredura distribuida um lote perdido e refeito por outro trabalhador; retomada desligada\n");
+        config.caminhoRetomada = NULL;
+        config.retomar = 0;
+    }
+    if (config.caminhoRetomada != NULL && (config.enxamesPorLote > 1 || config.nivelTelemetria != TELEMETRIA_DESLIGADA)) {
+        printf("A retomada salva um enxame por vez e nao grava telemetria; motor em lote e telemetria desligados\n");
+        config.enxamesPorLote = 0;
+        config.nivelTelemetria = TELEMETRIA_DESLIGADA;
+    }
+    if (!(isfinite(config.intervaloRetomada) && config.intervaloRetomada > 0)) {
+        printf("O intervalo da retomada deve ser um numero finito > 0 segundos (recebeu %g)\n", config.intervaloRetomada);
+        return 1;
+    }
+    if (config.caminhoRetomada != NULL && config.usarSubstituto) {
+        printf("Uma execucao retomada comecaria com o modelo substituto vazio; retomada desligada\n");
+        config.caminhoRetomada = NULL;
+        config.retomar = 0;
+    }
+    if (config.caminhoRetomada != NULL && config.usarCache && config.toleranciaCache > 0) {
+        printf("Uma execucao retomada comeca com o cache vazio e mudaria com a chave quantizada; retomada desligada\n");
+        config.caminhoRetomada = NULL;
+        config.retomar = 0;
+    }
+    // a expansão do plano depende da semente: a retomada usa a da varredura salva
+    if (config.retomar && !lerSementeRetomada(config.caminhoRetomada, &config.semente)) {
+        printf("Arquivo de retomada invalido ou inexistente: %s\n", config.caminhoRetomada);
+        return 1;
+    }
+    if (config.caminhoSaida == NULL) {
+        config.caminhoSaida = config.formato == SAIDA_BINARIA ? LOCALFILE_BINARIO : LOCALFILE;
     }
-    return resultado;
-}
 
-void inicializar(int numRodadas, int interacoes[],int populacoes[]){
-    int count = 1;
-    FILE *arquivo = escreverArquivo(LOCALFILE);
-    double resultados[10];
-
-    while (numRodadas >= count){
-        printf("\n\t\t =====| EXECUTANDO RODADA %d |=====\n\n",count);
-        fWiriteSTRING(arquivo,"\n\t\t =====| EXECUTANDO RODADA ");
-        fWiriteINT(arquivo,count);
-        fWiriteSTRING(arquivo," |=====\n\n");
-        resultados[count-1] = executarRodadaDeInteracoes(arquivo,3,interacoes,populacoes);
-        count++;
-    }
-    
-    gerarRelatorioMediaeDesvioPadrao(arquivo,numRodadas,resultados);
-    fclose(arquivo);
-}
+    // o domínio e a velocidade inicial (15% do semiespaço) seguem a função escolhida; a Eggholder mantém os do trabalho
+    if (parametros.dimensoes < 2 || !objetivoPorNome(nomeObjetivo, parametros.dimensoes, &parametros.objetivo)) {
+        printf("Funcao objetivo invalida: %s em %d dimensoes (disponiveis: %s)\n", nomeObjetivo, parametros.dimensoes, nomesObjetivos());
+        return 1;
+    }
+    if (strcmp(nomeObjetivo, "eggholder") != 0) {
+        parametros.posMin = parametros.objetivo.posMin;
+        parametros.posMax = parametros.objetivo.posMax;
+        parametros.velMax = 0.075 * (parametros.posMax - parametros.posMin);
+    }
+    // "otimo" para no ótimo conhecido da função, com a tolerância de TOLERANCIA_OTIMO
+    if (alvo != NULL) {
+        if (strcmp(alvo, "otimo") != 0) {
+            parametros.parada.alvo = atof(alvo);
+        } else if (isnan(parametros.objetivo.otimo)) {
+            printf("Otimo desconhecido para %s em %d dimensoes\n", nomeObjetivo, parametros.dimensoes);
+            return 1;
+        } else {
+            parametros.parada.alvo = parametros.objetivo.otimo + TOLERANCIA_OTIMO;
+        }
+    }
+    config.parametros = parametros;
 
+    // o trabalhador expande o plano com a semente do coordenador
+    int canal = -1, idTrabalhador = 0;
+    if (trabalhador) {
+        canal = conectarAoCoordenador(&distribuida, &config.semente, &idTrabalhador);
+    }
 
-// Função principal
-int main() {
-    srand(time(NULL));
-    // numero de rodadas internas
-    
-    // INTERACOES numero de rodadas internas
-    int interacoes[] = {20, 50, 100};
-    // POPULACAO
-    int populacoes[] = {50, 100}; 
-    int numRodaddas = 10;
-
-    // run mode 
-    // 10 x 20 (Interações) com 50 particulas
-    // 200 linhas
-    // 10 x 50 (Interações) com 50 particulas
-    // 500 linhas
-    // 10 x 100 (Interações) com 50 particulas
-    // 1000 linhas
-    // total 1700 linhas
-
-    // 10 x 20 (Interações) com 100 particulas
-    // 200 linhas
-    // 10 x 50 (Interações) com 100 particulas
-    // 500 linhas
-    // 10 x 100 (Interações) com 100 particulas
-    // 1000 linhas
-    // total 1700 linhas
-    
-
-    inicializar(numRodaddas,interacoes,populacoes);
+    // sem arquivo, o plano é o da metodologia: {50, 100} partículas x {20, 50, 100} iterações, 10 réplicas
+    PlanoExperimento plano;
+    PlanoExpandido expandido;
+    planoPadrao(&plano, parametros.w, parametros.c1, parametros.c2, parametros.posMin, parametros.posMax, parametros.velMax);
+    if (caminhoPlano != NULL) {
+        carregarPlano(&plano, caminhoPlano);
+    }
+    // os k vizinhos sorteados de cada partícula são outras partículas do enxame: k < população em toda célula
+    for (int p = 0; parametros.topologia == TOPOLOGIA_ALEATORIA && p < plano.populacoes.quantidade; p++) {
+        if (parametros.vizinhosAleatorios >= (int)plano.populacoes.valores[p]) {
+            printf("A topologia aleatoria precisa de menos vizinhos (%d) que particulas (%d)\n",
+                   parametros.vizinhosAleatorios, (int)plano.populacoes.valores[p]);
+            liberarPlano(&plano);
+            return 1;
+        }
+    }
+    // a menor ilha recebe populacao / numIlhas partículas e precisa ter os migrantes que envia
+    for (int p = 0; parametros.ilhas.numIlhas > 1 && p < plano.populacoes.quantidade; p++) {
+        int populacao = (int)plano.populacoes.valores[p];
+        if (populacao / parametros.ilhas.numIlhas < parametros.ilhas.migrantes) {
+            printf("Com %d particulas em %d ilhas a menor ilha tem %d particulas, menos que os %d migrantes\n",
+                   populacao, parametros.ilhas.numIlhas, populacao / parametros.ilhas.numIlhas, parametros.ilhas.migrantes);
+            liberarPlano(&plano);
+            return 1;
+        }
+    }
+    expandirPlano(&plano, config.semente, &expandido);
+
+    if (coordenador || trabalhador) {
+        distribuirVarredura(&expandido, &config, &distribuida, canal, idTrabalhador);
+    } else {
+        inicializar(&expandido, &config);
+    }
+    liberarPlanoExpandido(&expandido);
+    liberarPlano(&plano);
     printf("Fim do Enxame de Particulas");
     return 0;
 }
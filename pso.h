@@ -4,53 +4,137 @@
 #include <time.h>
 #include <math.h>
 #include <float.h>
-#include "data/libs/fileSys.cpp"
+#include <string.h>
+#include "data/libs/fileSys.h"
+#include "libs/plataforma.h"
+#include "libs/agendador.h"
+#include "libs/motor.h"
+#include "libs/relatorio.h"
+#include "libs/plano.h"
+#include "libs/lote.h"
+#include "libs/assincrono.h"
+#include "libs/retomada.h"
+#include "libs/distribuido.h"
+#include "libs/ilhas.h"
+#include "libs/substituto.h"
+#include "libs/tempo.h"
 
 #define LOCALFILE "./resultados.csv"
+#define LOCALFILE_BINARIO "./resultados.bin"
+#define LOCALFILE_CONVERGENCIA "./convergencia.csv"
+#define LOCALFILE_RESUMO "./resumo.csv"
+#define LOCALFILE_INSTRUMENTACAO "./instrumentacao.json"
 
-// Estrutura para representar uma partícula
-typedef struct {
-   double *position;    // Posição da partícula (vetor bidimensional)
-   double *velocity;    // Velocidade da partícula
-   double *bestPosition; // Melhor posição individual
-   double fitness;       // Aptidão da partícula
-   double bestFitness;   // Melhor aptidão individual
-} Particle;
+// Maior número de enxames em um lote do motor em lote
+#define MAX_ENXAMES_POR_LOTE 256
 
+// Tolerância sobre o ótimo conhecido usada por --alvo otimo
+#define TOLERANCIA_OTIMO 1e-4
 
-// Estrutura para representar o enxame
+// Uma execução independente do PSO dentro da varredura
 typedef struct {
-   Particle *particles; // Array de partículas
-   double *globalBestPosition; // Melhor posição global
-   double globalBestFitness;   // Melhor aptidão global
-   int numParticles;           // Número de partículas
-   int dimensions;             // Dimensão do espaço (2D no caso)
-} Swarm;
-
-
-// Função objetivo (Eggholder function)
-double eggholder(double x, double y);
-
-
-// Inicialização do enxame
-void initializeSwarm(Swarm *swarm, int numParticles, int dimensions, double minPos, double maxPos, double maxVel);
-
-
-// Atualiza a aptidão de uma partícula
-double evaluateFitness(double *position);
+   int celula;                  // Célula do plano (parâmetros da execução)
+   int rodada;                  // Réplica dentro da célula (1..replicas*sementes)
+   unsigned long long semente;  // Semente do fluxo aleatório da execução
+   double resultado;            // Melhor aptidão encontrada
+   double *melhorPosicao;       // Melhor posição encontrada [dimensoes]
+   int iteracoesExecutadas;     // Iterações feitas até o critério de parada
+   long long avaliacoes;        // Avaliações da função objetivo
+   CriterioParada criterio;     // Critério que encerrou a execução
+   double tempo;                // Tempo de parede da execução em segundos
+   int concluida;               // 1 quando a execução terminou
+   int restaurada;              // 1 = resultado herdado do arquivo de retomada
+} Execucao;
+
+
+// Opções da varredura lidas da linha de comando
+typedef struct {
+   int numTrabalhadores;        // Threads do agendador
+   unsigned long long semente;  // Semente da varredura
+   TipoGerador tipoGerador;     // Algoritmo do gerador aleatório de cada execução
+   ParametrosPSO parametros;    // Parâmetros comuns a todas as execuções
+   const char *caminhoSaida;    // Arquivo de resultados
+   FormatoSaida formato;        // CSV ou binário colunar
+   int silencioso;              // 1 = não ecoa cada resultado no console
+   int incluirTempo;            // 0 = omite o tempo de cada execução
+   NivelTelemetria nivelTelemetria; // Curvas de convergência registradas
+   const char *caminhoTelemetria;   // Arquivo das curvas de convergência
+   const char *caminhoResumo;   // Média e desvio padrão por célula
+   int enxamesPorLote;          // > 1 = motor em lote com até esse número de enxames por lote
+   int threadsEnxame;           // Threads de cada execução no motor paralelo
+   int numAvaliadores;          // > 0 = motor assíncrono com esse número de avaliadores por trabalhador
+   TipoAvaliador tipoAvaliador; // Avaliadores em threads ou em processos filhos
+   int capacidadeFila;          // Pedidos na fila de cada avaliador (0 = 2 por avaliador)
+   double latencia;             // Latência simulada por avaliação em segundos
+   int instrumentar;            // 1 = mede o tempo de cada fase (exige PSO_INSTRUMENTACAO)
+   int contadoresHardware;      // 1 = lê também os contadores de hardware por execução
+   const char *caminhoInstrumentacao; // Resumo da instrumentação em JSON
+   const char *caminhoRetomada; // Arquivo de retomada (NULL = sem salvamento)
+   int retomar;                 // 1 = continua a varredura salva em caminhoRetomada
+   double intervaloRetomada;    // Segundos entre salvamentos de uma execução em andamento
+   int usarCache;               // 1 = aptidões memorizadas no cache do objetivo
+   double toleranciaCache;      // Lado da célula da chave quantizada (0 = chave exata)
+   double memoriaCache;         // MB do cache de cada trabalhador
+   int usarSubstituto;          // 1 = candidatos triados pelo modelo substituto
+   double margemSubstituto;     // Erros médios de folga antes de descartar um candidato
+   int pontosSubstituto;        // Pontos guardados pelo modelo
+   int vizinhosSubstituto;      // k da previsão
+} ConfiguracaoVarredura;
+
+
+// Estado compartilhado pelos trabalhadores da varredura
+typedef struct {
+   const ConfiguracaoVarredura *config;
+   PlanoExpandido *plano;       // Células e lista plana de execuções
+   Execucao *execucoes;         // Execuções na ordem em que serão gravadas
+   double *posicoes;            // Melhores posições de todas as execuções [total][dimensoes]
+   Swarm *enxames;              // Um enxame (arena) por trabalhador
+   Telemetria *telemetrias;     // Um anel de convergência por trabalhador (NULL = desligada)
+   Instrumentacao *instrumentacoes; // Tempo por fase de cada trabalhador (NULL = desligada)
+   GrupoTrabalho *grupos;       // Um grupo de threads por trabalhador no motor paralelo (NULL = desligado)
+   AvaliadorAssincrono *avaliadores; // Avaliadores de cada trabalhador no motor assíncrono (NULL = desligado)
+   Retomada retomada;           // Arquivo de retomada mapeado
+   SalvamentoTrabalhador *salvamentos; // Ponto de salvamento de cada trabalhador (NULL = sem retomada)
+   Topologia *vizinhancas;      // Tabela de vizinhos de cada trabalhador (NULL = topologia global)
+   ArquivoElite *elites;        // Arquivo de elite de cada trabalhador (NULL = sem reinícios)
+   ModeloIlhas *ilhas;          // Ilhas de cada trabalhador no modelo de ilhas (NULL = enxame único)
+   CacheAptidao *caches;        // Cache de aptidões de cada trabalhador (NULL = avaliação exata)
+   ModeloSubstituto *substitutos; // Modelo substituto de cada trabalhador (NULL = todo candidato avaliado)
+   LoteEnxames *lotes;          // Um lote (arena) por trabalhador no motor em lote (NULL = desligado)
+   int *inicioLotes;            // Primeira execução de cada lote [numLotes + 1]
+   ArquivoTelemetria arquivoTelemetria; // Saída das curvas de convergência
+   EscritorResultados escritor; // Saída dos resultados
+   pthread_mutex_t trava;       // Protege proxima e as marcas de conclusão
+   int primeira, fim;           // Trecho [primeira, fim) da lista em execução
+   int proxima;                 // Próxima execução a gravar
+   int total;                   // Número de execuções
+} Varredura;
+
+
+// Nó trabalhador da varredura distribuída: a varredura local que executa os lotes do coordenador,
+// com os arquivos de saída marcados com o número do trabalhador
+typedef struct {
+   PlanoExpandido *plano;
+   ConfiguracaoVarredura config;
+   Varredura varredura;
+   char caminhoSaida[512];
+   char caminhoTelemetria[512];
+   char caminhoInstrumentacao[512];
+} NoDistribuido;
 
 
-// Atualiza a velocidade de uma partícula
-void updateVelocity(Particle *particle, double *globalBestPosition, int dimensions, double w, double c1, double c2);
+// Nome desconhecido numa opção: mostra os válidos e retorna 1
+int valorInvalido(const char *opcao, const char *valor, const char *nomes);
 
 
-// Atualiza a posição de uma partícula
-void updatePosition(Particle *particle, double minPos, double maxPos, int dimensions);
+// Função objetivo (Eggholder function)
+double eggholder(double x, double y);
 
 
-// Atualiza as melhores posições e aptidões (individual e global)
-void updateBestPositions(Swarm *swarm);
+// Verifica a precisão dos kernels da Eggholder; retorna o número de falhas
+int verificarPrecisaoEggholder();
 
 
-// Executa o PSO
-double runPSO(Swarm *swarm, int iterations, double w, double c1, double c2, double minPos, double maxPos);
\ No newline at end of file
+// Confere que descartes do modelo substituto e acertos do cache não contam como avaliação; retorna o número de falhas
+long long execucaoDeVerificacao(const ParametrosPSO *parametros, ResultadoPSO *resultado);
+int verificarContagemAvaliacoes();
\ No newline at end of file